@@ -83,8 +83,8 @@ namespace ldmx {
             /** Flag indicating if biasing is enabled */
             static bool biasingEnabled_;
 
-            /** Event weight corrected to account for biased cross-section. */
-            static double eventWeight_;
+            /** Event weight corrected to account for biased cross-section, for the event of the current thread. */
+            static G4ThreadLocal double eventWeight_;
 
             /** Particle specifies to bias. */
             static std::string particleType_;
@@ -11,7 +11,7 @@ namespace ldmx {
 
     bool BiasingMessenger::biasingEnabled_{false}; 
 
-    double BiasingMessenger::eventWeight_{1}; 
+    G4ThreadLocal double BiasingMessenger::eventWeight_{1}; 
 
     std::string BiasingMessenger::particleType_{"gamma"};
 
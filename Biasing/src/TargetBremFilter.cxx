@@ -12,7 +12,7 @@ SIM_PLUGIN(ldmx, TargetBremFilter)
 
 namespace ldmx { 
 
-    std::vector<G4Track*> TargetBremFilter::bremGammaTracks_ = {};
+    G4ThreadLocal std::vector<G4Track*>* TargetBremFilter::bremGammaTracks_ = nullptr;
 
     TargetBremFilter::TargetBremFilter() {
         messenger_ = new TargetBremFilterMessenger(this);
@@ -95,7 +95,7 @@ namespace ldmx {
         if (step->GetPostStepPoint()->GetStepStatus() == fGeomBoundary) { 
            
             // Clear all of the gamma tracks remaining from the previous event.
-            TargetBremFilter::bremGammaTracks_.clear();
+            getBremGammaTracks().clear();
 
             /*std::cout << "[ TargetBremFilter ]: "
                         << "Particle " << particleName << "is leaving the "
@@ -143,7 +143,7 @@ namespace ldmx {
                         && secondary_track->GetKineticEnergy() > bremEnergyThreshold_) {
                     /*std::cout << "[ TargetBremFilter ]: " 
                                 << "Adding secondary to brem list." << std::endl;*/
-                    TargetBremFilter::bremGammaTracks_.push_back(secondary_track); 
+                    getBremGammaTracks().push_back(secondary_track); 
                     hasBremCandidate = true;
                 } 
             }
@@ -179,12 +179,18 @@ namespace ldmx {
     }
 
     void TargetBremFilter::endEvent(const G4Event*) {
-        bremGammaTracks_.clear();
+        getBremGammaTracks().clear();
     }
     
     void TargetBremFilter::removeBremFromList(G4Track* track) {   
-        bremGammaTracks_.erase(std::remove(bremGammaTracks_.begin(), 
-                    bremGammaTracks_.end(), track), bremGammaTracks_.end());
+        std::vector<G4Track*>& bremGammaTracks = getBremGammaTracks();
+        bremGammaTracks.erase(std::remove(bremGammaTracks.begin(), 
+                    bremGammaTracks.end(), track), bremGammaTracks.end());
+    }
+
+    std::vector<G4Track*>& TargetBremFilter::getBremGammaTracks() {
+        if (!bremGammaTracks_) bremGammaTracks_ = new std::vector<G4Track*>;
+        return *bremGammaTracks_;
     }
 }
 
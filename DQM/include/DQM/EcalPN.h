@@ -18,7 +18,6 @@ namespace ldmx {
 
     // Forward declarations within the ldmx workspace
     class Event;
-    class HistogramPool; 
     class Process;
     class SimParticle;
 
@@ -49,16 +48,79 @@ namespace ldmx {
             /** Method executed before processing of events begins. */
             void onProcessStart();
 
+            /** The histograms are kept by each copy of the processor. */
+            bool isCloneSafe() const { 
+                return true;
+            }
+
         private:
 
+            /** Histograms filled for the events passing a selection. */
+            struct SelectionHistograms { 
+                TH1* eventType{nullptr};
+                TH1* eventType500MeV{nullptr};
+                TH1* eventType2000MeV{nullptr};
+                TH1* eventTypeComp{nullptr};
+                TH1* eventTypeComp500MeV{nullptr};
+                TH1* eventTypeComp2000MeV{nullptr};
+                TH1* pnParticleMult{nullptr};
+                TH1* pnGammaEnergy{nullptr};
+                TH1* neutronEnergy{nullptr};
+                TH1* energyDiff{nullptr};
+                TH1* energyFrac{nullptr};
+            };
+
+            /** 
+             * Get the histograms of a selection from the pool. 
+             *
+             * @param histos The histograms of the selection.
+             * @param suffix The suffix of the histogram names for the selection.
+             */
+            void getSelectionHistograms(SelectionHistograms& histos, const std::string& suffix);
+
             /** Method used to classify events. */
             int classifyEvent(const SimParticle* particle, double threshold); 
 
             /** Method used to classify events in a compact manner. */
             int classifyCompactEvent(const SimParticle* particle, double threshold); 
 
-            /** Singleton used to access histograms. */
-            HistogramPool* histograms_{nullptr}; 
+            /** Histograms for all events and for each selection. */
+            SelectionHistograms all_; 
+            SelectionHistograms trackVeto_; 
+            SelectionHistograms bdt_; 
+            SelectionHistograms hcal_; 
+            SelectionHistograms trackBDT_; 
+            SelectionHistograms vetoes_; 
+
+            /** Histograms of the PN gamma vertex. */
+            TH1* pnGammaIntZ_{nullptr};
+            TH1* pnGammaVertexZ_{nullptr};
+
+            /** Histograms of the hardest PN daughters. */
+            TH1* hardestKE_{nullptr};
+            TH1* hardestTheta_{nullptr};
+            TH1* hKEhTheta_{nullptr};
+            TH1* hardestPKE_{nullptr};
+            TH1* hardestPTheta_{nullptr};
+            TH1* hardestNKE_{nullptr};
+            TH1* hardestNTheta_{nullptr};
+            TH1* hardestPiKE_{nullptr};
+            TH1* hardestPiTheta_{nullptr};
+
+            /** Histograms of the events with a single hard neutron, two neutrons or a kaon. */
+            TH1* nEventType_{nullptr};
+            TH1* nKESecondKE_{nullptr};
+            TH1* n2Energy_{nullptr};
+            TH1* energyFrac2n_{nullptr};
+            TH1* energyOther2n_{nullptr};
+            TH1* kpKESecondKE_{nullptr};
+            TH1* kpEnergy_{nullptr};
+            TH1* kpEnergyDiff_{nullptr};
+            TH1* kpEnergyFrac_{nullptr};
+            TH1* k0KESecondKE_{nullptr};
+            TH1* k0Energy_{nullptr};
+            TH1* k0EnergyDiff_{nullptr};
+            TH1* k0EnergyFrac_{nullptr};
 
             /** Name of ECal veto collection. */
             std::string ecalVetoCollectionName_{"EcalVeto"}; 
@@ -12,11 +12,13 @@
 //----------//
 #include "Framework/EventProcessor.h"
 
+// Forward declarations
+class TH1;
+
 namespace ldmx { 
 
     // Forward declarations within the ldmx workspace
     class Event;
-    class HistogramPool; 
     class Process;
 
     class HCalDQM : public Analyzer { 
@@ -46,10 +48,51 @@ namespace ldmx {
             /** Method executed before processing of events begins. */
             void onProcessStart();
 
+            /** The histograms are kept by each copy of the processor. */
+            bool isCloneSafe() const { 
+                return true;
+            }
+
         private:
 
-            /** Singleton used to access histograms. */
-            HistogramPool* histograms_{nullptr}; 
+            /** Histograms filled for the events passing a selection. */
+            struct SelectionHistograms { 
+                TH1* maxPE{nullptr};
+                TH1* totalPE{nullptr};
+                TH1* nHits{nullptr};
+                TH1* hitTimeMaxPE{nullptr};
+                TH1* minTimeHitAboveThresh{nullptr};
+                TH1* maxPETime{nullptr};
+                TH1* minTimeHitAboveThreshPE{nullptr};
+            };
+
+            /** 
+             * Get the 1D histograms of a selection from the pool. 
+             *
+             * @param histos The histograms of the selection.
+             * @param suffix The suffix of the histogram names for the selection.
+             */
+            void getSelectionHistograms(SelectionHistograms& histos, const std::string& suffix);
+
+            /** Histograms of the individual hits. */
+            TH1* pe_{nullptr};
+            TH1* hitTime_{nullptr};
+
+            /** Histogram of the veto decision. */
+            TH1* veto_{nullptr};
+
+            /** Histograms of the BDT discriminant. */
+            TH1* bdtNHits_{nullptr};
+            TH1* bdtMaxPE_{nullptr};
+            TH1* bdtMaxPEVetoes_{nullptr};
+
+            /** Histograms for all events and for each selection. */
+            SelectionHistograms all_; 
+            SelectionHistograms trackVeto_; 
+            SelectionHistograms bdt_; 
+            SelectionHistograms hcalVeto_; 
+            SelectionHistograms trackBDT_; 
+            SelectionHistograms vetoes_; 
 
             /** The maximum PE threshold used for the veto. */
             float maxPEThreshold_{5}; 
@@ -20,13 +20,13 @@
 // Forward declarations
 class SimParticle;
 class TClonesArray; 
+class TH1;
 
 namespace ldmx { 
 
     // Forward declarations within the ldmx workspace
     class Event;
     class FindableTrackResult;
-    class HistogramPool; 
     class Process;
     class SimParticle; 
 
@@ -58,11 +58,46 @@ namespace ldmx {
             /** Method executed before processing of events begins. */
             void onProcessStart();
 
+            /** The histograms are kept by each copy of the processor. */
+            bool isCloneSafe() const { 
+                return true;
+            }
 
         private: 
 
-            /** Singleton used to access histograms. */
-            HistogramPool* histograms_{nullptr}; 
+            /** Histograms of the recoil momentum for the events passing a selection. */
+            struct MomentumHistograms { 
+                TH1* p{nullptr};
+                TH1* pt{nullptr};
+                TH1* px{nullptr};
+                TH1* py{nullptr};
+                TH1* pz{nullptr};
+            };
+
+            /** 
+             * Get the recoil momentum histograms for a selection. 
+             *
+             * @param suffix The suffix of the histogram names for the selection.
+             */
+            MomentumHistograms getMomentumHistograms(const std::string& suffix);
+
+            /** Track multiplicity histograms. */
+            TH1* trackCount_{nullptr};
+            TH1* looseTrackCount_{nullptr};
+            TH1* axialTrackCount_{nullptr};
+
+            /** Recoil vertex histograms. */
+            TH1* recoilVx_{nullptr};
+            TH1* recoilVy_{nullptr};
+            TH1* recoilVz_{nullptr};
+
+            /** Recoil momentum histograms for all events and for each selection. */
+            MomentumHistograms all_; 
+            MomentumHistograms trackVeto_; 
+            MomentumHistograms bdt_; 
+            MomentumHistograms trackBDT_; 
+            MomentumHistograms hcal_; 
+            MomentumHistograms vetoes_; 
 
             /** Name of ECal veto collection. */
             std::string ecalVetoCollectionName_{"EcalVeto"}; 
@@ -22,7 +22,6 @@
 #include "Event/HcalVetoResult.h"
 #include "Event/SimParticle.h"
 #include "Event/TrackerVetoResult.h"
-#include "Framework/HistogramPool.h"
 #include "Tools/AnalysisUtils.h"
 
 namespace ldmx { 
@@ -33,10 +32,41 @@ namespace ldmx {
     EcalPN::~EcalPN() {}
 
     void EcalPN::onProcessStart() {
-      
 
-        // Get an instance of the histogram pool  
-        histograms_ = HistogramPool::getInstance();    
+        // Keep the histograms so they don't have to be looked up for each event
+        getSelectionHistograms(all_, ""); 
+        getSelectionHistograms(trackVeto_, "_track_veto"); 
+        getSelectionHistograms(bdt_, "_bdt"); 
+        getSelectionHistograms(hcal_, "_hcal"); 
+        getSelectionHistograms(trackBDT_, "_track_bdt"); 
+        getSelectionHistograms(vetoes_, "_vetoes"); 
+
+        pnGammaIntZ_ = histograms_.get("pn_gamma_int_z"); 
+        pnGammaVertexZ_ = histograms_.get("pn_gamma_vertex_z"); 
+
+        hardestKE_ = histograms_.get("hardest_ke"); 
+        hardestTheta_ = histograms_.get("hardest_theta"); 
+        hardestPKE_ = histograms_.get("hardest_p_ke"); 
+        hardestPTheta_ = histograms_.get("hardest_p_theta"); 
+        hardestNKE_ = histograms_.get("hardest_n_ke"); 
+        hardestNTheta_ = histograms_.get("hardest_n_theta"); 
+        hardestPiKE_ = histograms_.get("hardest_pi_ke"); 
+        hardestPiTheta_ = histograms_.get("hardest_pi_theta"); 
+
+        nEventType_ = histograms_.get("1n_event_type"); 
+        n2Energy_ = histograms_.get("2n_n2_energy"); 
+        energyFrac2n_ = histograms_.get("2n_energy_frac"); 
+        energyOther2n_ = histograms_.get("2n_energy_other"); 
+        kpEnergy_ = histograms_.get("1kp_energy"); 
+        kpEnergyDiff_ = histograms_.get("1kp_energy_diff"); 
+        kpEnergyFrac_ = histograms_.get("1kp_energy_frac"); 
+        k0Energy_ = histograms_.get("1k0_energy"); 
+        k0EnergyDiff_ = histograms_.get("1k0_energy_diff"); 
+        k0EnergyFrac_ = histograms_.get("1k0_energy_frac"); 
+
+        std::vector<const SelectionHistograms*> selections = { 
+            &all_, &trackVeto_, &bdt_, &hcal_, &trackBDT_, &vetoes_
+        };
 
         std::vector<std::string> labels = {"", 
             "Nothing hard", // 0  
@@ -63,28 +93,12 @@ namespace ldmx {
             ""
         };
 
-        std::vector<TH1*> hists = { 
-            histograms_->get("event_type"),
-            histograms_->get("event_type_track_veto"),
-            histograms_->get("event_type_bdt"),
-            histograms_->get("event_type_hcal"),
-            histograms_->get("event_type_track_bdt"),
-            histograms_->get("event_type_vetoes"),
-            histograms_->get("event_type_500mev"),
-            histograms_->get("event_type_500mev_track_veto"),
-            histograms_->get("event_type_500mev_bdt"),
-            histograms_->get("event_type_500mev_hcal"),
-            histograms_->get("event_type_500mev_track_bdt"),
-            histograms_->get("event_type_500mev_vetoes"),
-            histograms_->get("event_type_2000mev"),
-            histograms_->get("event_type_2000mev_track_veto"),
-            histograms_->get("event_type_2000mev_bdt"),
-            histograms_->get("event_type_2000mev_hcal"),
-            histograms_->get("event_type_2000mev_track_bdt"),
-            histograms_->get("event_type_2000mev_vetoes"),
-
-        };
-
+        std::vector<TH1*> hists;
+        for (const auto& selection : selections) { 
+            hists.push_back(selection->eventType); 
+            hists.push_back(selection->eventType500MeV); 
+            hists.push_back(selection->eventType2000MeV); 
+        }
 
         for (int ilabel{1}; ilabel < labels.size(); ++ilabel) { 
             for (auto& hist : hists) {
@@ -102,26 +116,12 @@ namespace ldmx {
             ""
         };
 
-        hists = {
-            histograms_->get("event_type_compact"),
-            histograms_->get("event_type_compact_track_veto"),
-            histograms_->get("event_type_compact_bdt"),
-            histograms_->get("event_type_compact_hcal"),
-            histograms_->get("event_type_compact_track_bdt"),
-            histograms_->get("event_type_compact_vetoes"),
-            histograms_->get("event_type_compact_500mev"),
-            histograms_->get("event_type_compact_500mev_track_veto"),
-            histograms_->get("event_type_compact_500mev_bdt"),
-            histograms_->get("event_type_compact_500mev_hcal"),
-            histograms_->get("event_type_compact_500mev_track_bdt"),
-            histograms_->get("event_type_compact_500mev_vetoes"),
-            histograms_->get("event_type_compact_2000mev"),
-            histograms_->get("event_type_compact_2000mev_track_veto"),
-            histograms_->get("event_type_compact_2000mev_bdt"),
-            histograms_->get("event_type_compact_2000mev_hcal"),
-            histograms_->get("event_type_compact_2000mev_track_bdt"),
-            histograms_->get("event_type_compact_2000mev_vetoes"),
-        };
+        hists.clear();
+        for (const auto& selection : selections) { 
+            hists.push_back(selection->eventTypeComp); 
+            hists.push_back(selection->eventTypeComp500MeV); 
+            hists.push_back(selection->eventTypeComp2000MeV); 
+        }
 
         for (int ilabel{1}; ilabel < labels.size(); ++ilabel) { 
             for (auto& hist : hists) {
@@ -132,27 +132,27 @@ namespace ldmx {
         // Move into the ECal PN directory
         getHistoDirectory();
 
-        histograms_->create<TH2F>("h_ke_h_theta", 
-                            "Kinetic Energy Hardest Photo-nuclear Particle (MeV)",
-                            400, 0, 4000, 
-                            "#theta of Hardest Photo-nuclear Particle (Degrees)",
-                            360, 0, 180);
-
-        histograms_->create<TH2F>("1n_ke:2nd_h_ke", 
-                            "Kinetic Energy of Leading Neutron (MeV)",
-                            400, 0, 4000, 
-                            "Kinetic Energy of 2nd Hardest Particle",
-                            400, 0, 4000);
-        histograms_->create<TH2F>("1kp_ke:2nd_h_ke", 
-                            "Kinetic Energy of Leading Charged Kaon (MeV)",
-                            400, 0, 4000, 
-                            "Kinetic Energy of 2nd Hardest Particle",
-                            400, 0, 4000);
-        histograms_->create<TH2F>("1k0_ke:2nd_h_ke", 
-                            "Kinetic Energy of Leading K0 (MeV)",
-                            400, 0, 4000, 
-                            "Kinetic Energy of 2nd Hardest Particle",
-                            400, 0, 4000);
+        hKEhTheta_ = histograms_.create<TH2F>("h_ke_h_theta", 
+                                              "Kinetic Energy Hardest Photo-nuclear Particle (MeV)",
+                                              400, 0, 4000,
+                                              "#theta of Hardest Photo-nuclear Particle (Degrees)",
+                                              360, 0, 180);
+
+        nKESecondKE_ = histograms_.create<TH2F>("1n_ke:2nd_h_ke", 
+                                                "Kinetic Energy of Leading Neutron (MeV)",
+                                                400, 0, 4000,
+                                                "Kinetic Energy of 2nd Hardest Particle",
+                                                400, 0, 4000);
+        kpKESecondKE_ = histograms_.create<TH2F>("1kp_ke:2nd_h_ke", 
+                                                 "Kinetic Energy of Leading Charged Kaon (MeV)",
+                                                 400, 0, 4000,
+                                                 "Kinetic Energy of 2nd Hardest Particle",
+                                                 400, 0, 4000);
+        k0KESecondKE_ = histograms_.create<TH2F>("1k0_ke:2nd_h_ke", 
+                                                 "Kinetic Energy of Leading K0 (MeV)",
+                                                 400, 0, 4000,
+                                                 "Kinetic Energy of 2nd Hardest Particle",
+                                                 400, 0, 4000);
 
         std::vector<std::string> n_labels = {"", "",
             "nn", // 1
@@ -162,9 +162,8 @@ namespace ldmx {
             ""
         };
 
-        TH1* hist = histograms_->get("1n_event_type"); 
         for (int ilabel{1}; ilabel < n_labels.size(); ++ilabel) { 
-            hist->GetXaxis()->SetBinLabel(ilabel, n_labels[ilabel-1].c_str());
+            nEventType_->GetXaxis()->SetBinLabel(ilabel, n_labels[ilabel-1].c_str());
         }
        
     }
@@ -190,10 +189,10 @@ namespace ldmx {
             return;
         }
 
-        histograms_->get("pn_particle_mult")->Fill(pnGamma->getDaughterCount());
-        histograms_->get("pn_gamma_energy")->Fill(pnGamma->getEnergy()); 
-        histograms_->get("pn_gamma_int_z")->Fill(pnGamma->getEndPoint()[2]); 
-        histograms_->get("pn_gamma_vertex_z")->Fill(pnGamma->getVertex()[2]);  
+        all_.pnParticleMult->Fill(pnGamma->getDaughterCount());
+        all_.pnGammaEnergy->Fill(pnGamma->getEnergy()); 
+        pnGammaIntZ_->Fill(pnGamma->getEndPoint()[2]); 
+        pnGammaVertexZ_->Fill(pnGamma->getVertex()[2]);  
 
         double lke{-1},   lt{-1}; 
         double lpke{-1},  lpt{-1};
@@ -238,15 +237,15 @@ namespace ldmx {
             pnDaughters.push_back(daughter); 
         }
 
-        histograms_->get("hardest_ke")->Fill(lke); 
-        histograms_->get("hardest_theta")->Fill(lt);
-        histograms_->get("h_ke_h_theta")->Fill(lke, lt); 
-        histograms_->get("hardest_p_ke")->Fill(lpke); 
-        histograms_->get("hardest_p_theta")->Fill(lpt); 
-        histograms_->get("hardest_n_ke")->Fill(lnke); 
-        histograms_->get("hardest_n_theta")->Fill(lnt); 
-        histograms_->get("hardest_pi_ke")->Fill(lpike); 
-        histograms_->get("hardest_pi_theta")->Fill(lpit); 
+        hardestKE_->Fill(lke); 
+        hardestTheta_->Fill(lt);
+        hKEhTheta_->Fill(lke, lt); 
+        hardestPKE_->Fill(lpke); 
+        hardestPTheta_->Fill(lpt); 
+        hardestNKE_->Fill(lnke); 
+        hardestNTheta_->Fill(lnt); 
+        hardestPiKE_->Fill(lpike); 
+        hardestPiTheta_->Fill(lpit); 
 
         // Classify the event
         int eventType = classifyEvent(pnGamma, 200); 
@@ -257,13 +256,13 @@ namespace ldmx {
         int eventTypeComp500MeV = classifyCompactEvent(pnGamma, 500);  
         int eventTypeComp2000MeV = classifyCompactEvent(pnGamma, 2000);  
 
-        histograms_->get("event_type")->Fill(eventType);
-        histograms_->get("event_type_500mev")->Fill(eventType500MeV);
-        histograms_->get("event_type_2000mev")->Fill(eventType2000MeV);
+        all_.eventType->Fill(eventType);
+        all_.eventType500MeV->Fill(eventType500MeV);
+        all_.eventType2000MeV->Fill(eventType2000MeV);
 
-        histograms_->get("event_type_compact")->Fill(eventTypeComp);
-        histograms_->get("event_type_compact_500mev")->Fill(eventTypeComp500MeV);
-        histograms_->get("event_type_compact_2000mev")->Fill(eventTypeComp2000MeV);
+        all_.eventTypeComp->Fill(eventTypeComp);
+        all_.eventTypeComp500MeV->Fill(eventTypeComp500MeV);
+        all_.eventTypeComp2000MeV->Fill(eventTypeComp2000MeV);
 
         double slke{-9999};
         double nEnergy{-9999}, energyDiff{-9999}, energyFrac{-9999}; 
@@ -283,26 +282,26 @@ namespace ldmx {
             energyFrac = nEnergy/pnGamma->getEnergy(); 
 
             if (eventType == 1) { 
-                histograms_->get("1n_ke:2nd_h_ke")->Fill(nEnergy, slke);
-                histograms_->get("1n_neutron_energy")->Fill(nEnergy);  
-                histograms_->get("1n_energy_diff")->Fill(energyDiff);
-                histograms_->get("1n_energy_frac")->Fill(energyFrac); 
+                nKESecondKE_->Fill(nEnergy, slke);
+                all_.neutronEnergy->Fill(nEnergy);  
+                all_.energyDiff->Fill(energyDiff);
+                all_.energyFrac->Fill(energyFrac); 
             } else if (eventType == 2) { 
-                histograms_->get("2n_n2_energy")->Fill(slke); 
+                n2Energy_->Fill(slke); 
                 auto energyFrac2n = (nEnergy + slke)/pnGamma->getEnergy();
-                histograms_->get("2n_energy_frac")->Fill(energyFrac2n);
-                histograms_->get("2n_energy_other")->Fill(pnGamma->getEnergy() - energyFrac2n); 
+                energyFrac2n_->Fill(energyFrac2n);
+                energyOther2n_->Fill(pnGamma->getEnergy() - energyFrac2n); 
                   
             } else if (eventType == 17) { 
-                histograms_->get("1kp_ke:2nd_h_ke")->Fill(nEnergy, slke);
-                histograms_->get("1kp_energy")->Fill(nEnergy);  
-                histograms_->get("1kp_energy_diff")->Fill(energyDiff);
-                histograms_->get("1kp_energy_frac")->Fill(energyFrac); 
+                kpKESecondKE_->Fill(nEnergy, slke);
+                kpEnergy_->Fill(nEnergy);  
+                kpEnergyDiff_->Fill(energyDiff);
+                kpEnergyFrac_->Fill(energyFrac); 
             } else if (eventType == 16 || eventType == 18) { 
-                histograms_->get("1k0_ke:2nd_h_ke")->Fill(nEnergy, slke);
-                histograms_->get("1k0_energy")->Fill(nEnergy);  
-                histograms_->get("1k0_energy_diff")->Fill(energyDiff);
-                histograms_->get("1k0_energy_frac")->Fill(energyFrac); 
+                k0KESecondKE_->Fill(nEnergy, slke);
+                k0Energy_->Fill(nEnergy);  
+                k0EnergyDiff_->Fill(energyDiff);
+                k0EnergyFrac_->Fill(energyFrac); 
             }
 
             int nPdgID = abs(pnDaughters[1]->getPdgID());
@@ -312,7 +311,7 @@ namespace ldmx {
             else if (nPdgID == 211) nEventType = 3;
             else if (nPdgID == 111) nEventType = 4; 
        
-            histograms_->get("1n_event_type")->Fill(nEventType); 
+            nEventType_->Fill(nEventType); 
 
         } 
 
@@ -329,17 +328,17 @@ namespace ldmx {
             
             // Fill the histograms if the event passes the ECal veto
             if (bdtProb >= .99) {
-                histograms_->get("event_type_bdt")->Fill(eventType);
-                histograms_->get("event_type_500mev_bdt")->Fill(eventType500MeV);
-                histograms_->get("event_type_2000mev_bdt")->Fill(eventType2000MeV); 
-                histograms_->get("event_type_compact_bdt")->Fill(eventTypeComp);
-                histograms_->get("event_type_compact_500mev_bdt")->Fill(eventTypeComp500MeV);
-                histograms_->get("event_type_compact_2000mev_bdt")->Fill(eventTypeComp2000MeV);
-                histograms_->get("pn_particle_mult_bdt")->Fill(pnGamma->getDaughterCount());
-                histograms_->get("pn_gamma_energy_bdt")->Fill(pnGamma->getEnergy());
-                histograms_->get("1n_neutron_energy_bdt")->Fill(nEnergy);  
-                histograms_->get("1n_energy_diff_bdt")->Fill(energyDiff);
-                histograms_->get("1n_energy_frac_bdt")->Fill(energyFrac); 
+                bdt_.eventType->Fill(eventType);
+                bdt_.eventType500MeV->Fill(eventType500MeV);
+                bdt_.eventType2000MeV->Fill(eventType2000MeV); 
+                bdt_.eventTypeComp->Fill(eventTypeComp);
+                bdt_.eventTypeComp500MeV->Fill(eventTypeComp500MeV);
+                bdt_.eventTypeComp2000MeV->Fill(eventTypeComp2000MeV);
+                bdt_.pnParticleMult->Fill(pnGamma->getDaughterCount());
+                bdt_.pnGammaEnergy->Fill(pnGamma->getEnergy());
+                bdt_.neutronEnergy->Fill(nEnergy);  
+                bdt_.energyDiff->Fill(energyDiff);
+                bdt_.energyFrac->Fill(energyFrac); 
                 passesBDT = true; 
             }
         }
@@ -357,17 +356,17 @@ namespace ldmx {
             //std::cout << "max PE: " << maxPEHit->getPE() << std::endl; 
     
             if (veto->passesVeto()) {
-                histograms_->get("event_type_hcal")->Fill(eventType);
-                histograms_->get("event_type_500mev_hcal")->Fill(eventType500MeV);
-                histograms_->get("event_type_2000mev_hcal")->Fill(eventType2000MeV);
-                histograms_->get("event_type_compact_hcal")->Fill(eventTypeComp);
-                histograms_->get("event_type_compact_500mev_hcal")->Fill(eventTypeComp500MeV);
-                histograms_->get("event_type_compact_2000mev_hcal")->Fill(eventTypeComp2000MeV);
-                histograms_->get("pn_particle_mult_hcal")->Fill(pnGamma->getDaughterCount());
-                histograms_->get("pn_gamma_energy_hcal")->Fill(pnGamma->getEnergy()); 
-                histograms_->get("1n_neutron_energy_hcal")->Fill(nEnergy);  
-                histograms_->get("1n_energy_diff_hcal")->Fill(energyDiff);
-                histograms_->get("1n_energy_frac_hcal")->Fill(energyFrac); 
+                hcal_.eventType->Fill(eventType);
+                hcal_.eventType500MeV->Fill(eventType500MeV);
+                hcal_.eventType2000MeV->Fill(eventType2000MeV);
+                hcal_.eventTypeComp->Fill(eventTypeComp);
+                hcal_.eventTypeComp500MeV->Fill(eventTypeComp500MeV);
+                hcal_.eventTypeComp2000MeV->Fill(eventTypeComp2000MeV);
+                hcal_.pnParticleMult->Fill(pnGamma->getDaughterCount());
+                hcal_.pnGammaEnergy->Fill(pnGamma->getEnergy()); 
+                hcal_.neutronEnergy->Fill(nEnergy);  
+                hcal_.energyDiff->Fill(energyDiff);
+                hcal_.energyFrac->Fill(energyFrac); 
                 passesHcalVeto = veto->passesVeto();  
             }
         }
@@ -385,47 +384,47 @@ namespace ldmx {
                 
                 passesTrackVeto = true; 
                 
-                histograms_->get("event_type_track_veto")->Fill(eventType);
-                histograms_->get("event_type_500mev_track_veto")->Fill(eventType500MeV);
-                histograms_->get("event_type_2000mev_track_veto")->Fill(eventType2000MeV); 
-                histograms_->get("event_type_compact_track_veto")->Fill(eventTypeComp);
-                histograms_->get("event_type_compact_500mev_track_veto")->Fill(eventTypeComp500MeV);
-                histograms_->get("event_type_compact_2000mev_track_veto")->Fill(eventTypeComp2000MeV);
-                histograms_->get("pn_particle_mult_track_veto")->Fill(pnGamma->getDaughterCount());    
-                histograms_->get("pn_gamma_energy_track_veto")->Fill(pnGamma->getEnergy());
-                histograms_->get("1n_neutron_energy_track_veto")->Fill(nEnergy);  
-                histograms_->get("1n_energy_diff_track_veto")->Fill(energyDiff);
-                histograms_->get("1n_energy_frac_track_veto")->Fill(energyFrac); 
+                trackVeto_.eventType->Fill(eventType);
+                trackVeto_.eventType500MeV->Fill(eventType500MeV);
+                trackVeto_.eventType2000MeV->Fill(eventType2000MeV); 
+                trackVeto_.eventTypeComp->Fill(eventTypeComp);
+                trackVeto_.eventTypeComp500MeV->Fill(eventTypeComp500MeV);
+                trackVeto_.eventTypeComp2000MeV->Fill(eventTypeComp2000MeV);
+                trackVeto_.pnParticleMult->Fill(pnGamma->getDaughterCount());    
+                trackVeto_.pnGammaEnergy->Fill(pnGamma->getEnergy());
+                trackVeto_.neutronEnergy->Fill(nEnergy);  
+                trackVeto_.energyDiff->Fill(energyDiff);
+                trackVeto_.energyFrac->Fill(energyFrac); 
 
             }
         }
         
         if (passesTrackVeto && passesBDT) { 
-            histograms_->get("event_type_track_bdt")->Fill(eventType);
-            histograms_->get("event_type_500mev_track_bdt")->Fill(eventType500MeV);
-            histograms_->get("event_type_2000mev_track_bdt")->Fill(eventType2000MeV); 
-            histograms_->get("event_type_compact_track_bdt")->Fill(eventTypeComp);
-            histograms_->get("event_type_compact_500mev_track_bdt")->Fill(eventTypeComp500MeV);
-            histograms_->get("event_type_compact_2000mev_track_bdt")->Fill(eventTypeComp2000MeV);
-            histograms_->get("pn_particle_mult_track_bdt")->Fill(pnGamma->getDaughterCount());
-            histograms_->get("pn_gamma_energy_track_bdt")->Fill(pnGamma->getEnergy());
-            histograms_->get("1n_neutron_energy_track_bdt")->Fill(nEnergy);  
-            histograms_->get("1n_energy_diff_track_bdt")->Fill(energyDiff);
-            histograms_->get("1n_energy_frac_track_bdt")->Fill(energyFrac); 
+            trackBDT_.eventType->Fill(eventType);
+            trackBDT_.eventType500MeV->Fill(eventType500MeV);
+            trackBDT_.eventType2000MeV->Fill(eventType2000MeV); 
+            trackBDT_.eventTypeComp->Fill(eventTypeComp);
+            trackBDT_.eventTypeComp500MeV->Fill(eventTypeComp500MeV);
+            trackBDT_.eventTypeComp2000MeV->Fill(eventTypeComp2000MeV);
+            trackBDT_.pnParticleMult->Fill(pnGamma->getDaughterCount());
+            trackBDT_.pnGammaEnergy->Fill(pnGamma->getEnergy());
+            trackBDT_.neutronEnergy->Fill(nEnergy);  
+            trackBDT_.energyDiff->Fill(energyDiff);
+            trackBDT_.energyFrac->Fill(energyFrac); 
         }
 
         if (passesTrackVeto && passesHcalVeto && passesBDT) { 
-            histograms_->get("event_type_vetoes")->Fill(eventType);
-            histograms_->get("event_type_500mev_vetoes")->Fill(eventType500MeV);
-            histograms_->get("event_type_2000mev_vetoes")->Fill(eventType2000MeV);
-            histograms_->get("event_type_compact_vetoes")->Fill(eventTypeComp);
-            histograms_->get("event_type_compact_500mev_vetoes")->Fill(eventTypeComp500MeV);
-            histograms_->get("event_type_compact_2000mev_vetoes")->Fill(eventTypeComp2000MeV);
-            histograms_->get("pn_particle_mult_vetoes")->Fill(pnGamma->getDaughterCount());
-            histograms_->get("pn_gamma_energy_vetoes")->Fill(pnGamma->getEnergy()); 
-            histograms_->get("1n_neutron_energy_vetoes")->Fill(nEnergy);  
-            histograms_->get("1n_energy_diff_vetoes")->Fill(energyDiff);
-            histograms_->get("1n_energy_frac_vetoes")->Fill(energyFrac); 
+            vetoes_.eventType->Fill(eventType);
+            vetoes_.eventType500MeV->Fill(eventType500MeV);
+            vetoes_.eventType2000MeV->Fill(eventType2000MeV);
+            vetoes_.eventTypeComp->Fill(eventTypeComp);
+            vetoes_.eventTypeComp500MeV->Fill(eventTypeComp500MeV);
+            vetoes_.eventTypeComp2000MeV->Fill(eventTypeComp2000MeV);
+            vetoes_.pnParticleMult->Fill(pnGamma->getDaughterCount());
+            vetoes_.pnGammaEnergy->Fill(pnGamma->getEnergy()); 
+            vetoes_.neutronEnergy->Fill(nEnergy);  
+            vetoes_.energyDiff->Fill(energyDiff);
+            vetoes_.energyFrac->Fill(energyFrac); 
                 
         
         }
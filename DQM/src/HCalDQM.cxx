@@ -26,7 +26,6 @@
 #include "Event/SimTrackerHit.h"
 #include "Event/EcalVetoResult.h"
 #include "Event/TrackerVetoResult.h"
-#include "Framework/HistogramPool.h"
 #include "Tools/AnalysisUtils.h"
 
 namespace ldmx { 
@@ -37,58 +36,74 @@ namespace ldmx {
     HCalDQM::~HCalDQM() {}
 
     void HCalDQM::onProcessStart() {
-       
-        // Get an instance of the histogram pool  
-        histograms_ = HistogramPool::getInstance();    
 
         // Move into the HCal directory
         getHistoDirectory();
 
-        histograms_->create<TH2F>("bdt_n_hits", "BDT discriminant", 200, 0, 1, 
-                                  "HCal hit multiplicity", 300, 0, 300);
-
-        histograms_->create<TH2F>("max_pe:time", 
-                                  "Max Photoelectrons in an HCal Module", 1500, 0, 1500, 
-                                  "HCal max PE hit time (ns)", 1500, 0, 1500);
-        histograms_->create<TH2F>("max_pe:time_track_veto", 
-                                  "Max Photoelectrons in an HCal Module", 1500, 0, 1500, 
-                                  "HCal max PE hit time (ns)", 1500, 0, 1500);
-        histograms_->create<TH2F>("max_pe:time_bdt", 
-                                  "Max Photoelectrons in an HCal Module", 1500, 0, 1500, 
-                                  "HCal max PE hit time (ns)", 1500, 0, 1500);
-        histograms_->create<TH2F>("max_pe:time_hcal_veto", 
-                                  "Max Photoelectrons in an HCal Module", 1500, 0, 1500, 
-                                  "HCal max PE hit time (ns)", 1500, 0, 1500);
-        histograms_->create<TH2F>("max_pe:time_track_bdt", 
-                                  "Max Photoelectrons in an HCal Module", 1500, 0, 1500, 
-                                  "HCal max PE hit time (ns)", 1500, 0, 1500);
-        histograms_->create<TH2F>("max_pe:time_vetoes", 
-                                  "Max Photoelectrons in an HCal Module", 1500, 0, 1500, 
-                                  "HCal max PE hit time (ns)", 1500, 0, 1500);
-
-        histograms_->create<TH2F>("min_time_hit_above_thresh:pe", 
-                                  "Photoelectrons in an HCal Module", 1500, 0, 1500, 
-                                  "Earliest time of HCal hit above threshold (ns)", 1600, -100, 1500);
-        histograms_->create<TH2F>("min_time_hit_above_thresh:pe_track_veto", 
-                                  "Photoelectrons in an HCal Module", 1500, 0, 1500, 
-                                  "Earliest time of HCal hit above threshold (ns)", 1600, -100, 1500);
-        histograms_->create<TH2F>("min_time_hit_above_thresh:pe_bdt", 
-                                  "Photoelectrons in an HCal Module", 1500, 0, 1500, 
-                                  "Earliest time of HCal hit above threshold (ns)", 1600, -100, 1500);
-        histograms_->create<TH2F>("min_time_hit_above_thresh:pe_track_bdt", 
-                                  "Photoelectrons in an HCal Module", 1500, 0, 1500, 
-                                  "Earliest time of HCal hit above threshold (ns)", 1600, -100, 1500);
-        histograms_->create<TH2F>("min_time_hit_above_thresh:pe_vetoes", 
-                                  "Photoelectrons in an HCal Module", 1500, 0, 1500, 
-                                  "Earliest time of HCal hit above threshold (ns)", 1600, -100, 1500);
+        bdtNHits_ = histograms_.create<TH2F>("bdt_n_hits", "BDT discriminant", 200, 0, 1, 
+                                             "HCal hit multiplicity", 300, 0, 300);
+
+        all_.maxPETime = histograms_.create<TH2F>("max_pe:time", 
+                                                  "Max Photoelectrons in an HCal Module", 1500, 0, 1500, 
+                                                  "HCal max PE hit time (ns)", 1500, 0, 1500);
+        trackVeto_.maxPETime = histograms_.create<TH2F>("max_pe:time_track_veto", 
+                                                        "Max Photoelectrons in an HCal Module", 1500, 0, 1500, 
+                                                        "HCal max PE hit time (ns)", 1500, 0, 1500);
+        bdt_.maxPETime = histograms_.create<TH2F>("max_pe:time_bdt", 
+                                                  "Max Photoelectrons in an HCal Module", 1500, 0, 1500, 
+                                                  "HCal max PE hit time (ns)", 1500, 0, 1500);
+        hcalVeto_.maxPETime = histograms_.create<TH2F>("max_pe:time_hcal_veto", 
+                                                       "Max Photoelectrons in an HCal Module", 1500, 0, 1500, 
+                                                       "HCal max PE hit time (ns)", 1500, 0, 1500);
+        trackBDT_.maxPETime = histograms_.create<TH2F>("max_pe:time_track_bdt", 
+                                                       "Max Photoelectrons in an HCal Module", 1500, 0, 1500, 
+                                                       "HCal max PE hit time (ns)", 1500, 0, 1500);
+        vetoes_.maxPETime = histograms_.create<TH2F>("max_pe:time_vetoes", 
+                                                     "Max Photoelectrons in an HCal Module", 1500, 0, 1500, 
+                                                     "HCal max PE hit time (ns)", 1500, 0, 1500);
+
+        all_.minTimeHitAboveThreshPE = histograms_.create<TH2F>("min_time_hit_above_thresh:pe", 
+                                                                "Photoelectrons in an HCal Module", 1500, 0, 1500, 
+                                                                "Earliest time of HCal hit above threshold (ns)", 1600, -100, 1500);
+        trackVeto_.minTimeHitAboveThreshPE = histograms_.create<TH2F>("min_time_hit_above_thresh:pe_track_veto", 
+                                                                      "Photoelectrons in an HCal Module", 1500, 0, 1500, 
+                                                                      "Earliest time of HCal hit above threshold (ns)", 1600, -100, 1500);
+        bdt_.minTimeHitAboveThreshPE = histograms_.create<TH2F>("min_time_hit_above_thresh:pe_bdt", 
+                                                                "Photoelectrons in an HCal Module", 1500, 0, 1500, 
+                                                                "Earliest time of HCal hit above threshold (ns)", 1600, -100, 1500);
+        trackBDT_.minTimeHitAboveThreshPE = histograms_.create<TH2F>("min_time_hit_above_thresh:pe_track_bdt", 
+                                                                     "Photoelectrons in an HCal Module", 1500, 0, 1500, 
+                                                                     "Earliest time of HCal hit above threshold (ns)", 1600, -100, 1500);
+        vetoes_.minTimeHitAboveThreshPE = histograms_.create<TH2F>("min_time_hit_above_thresh:pe_vetoes", 
+                                                                   "Photoelectrons in an HCal Module", 1500, 0, 1500, 
+                                                                   "Earliest time of HCal hit above threshold (ns)", 1600, -100, 1500);
          
-        histograms_->create<TH2F>("bdt_max_pe", 
-                            "Max PE", 500, 0, 500, 
-                            "BDT Prob", 200, 0.9, 1.0);
-        histograms_->create<TH2F>("bdt_max_pe_vetoes", 
-                            "Max PE", 500, 0, 500, 
-                            "BDT Prob", 200, 0.9, 1.0);
-    
+        bdtMaxPE_ = histograms_.create<TH2F>("bdt_max_pe", 
+                                             "Max PE", 500, 0, 500, 
+                                             "BDT Prob", 200, 0.9, 1.0);
+        bdtMaxPEVetoes_ = histograms_.create<TH2F>("bdt_max_pe_vetoes", 
+                                                   "Max PE", 500, 0, 500, 
+                                                   "BDT Prob", 200, 0.9, 1.0);
+
+        // Keep the histograms so they don't have to be looked up for each event
+        pe_ = histograms_.get("pe"); 
+        hitTime_ = histograms_.get("hit_time"); 
+        veto_ = histograms_.get("veto"); 
+
+        getSelectionHistograms(all_, ""); 
+        getSelectionHistograms(trackVeto_, "_track_veto"); 
+        getSelectionHistograms(bdt_, "_bdt"); 
+        getSelectionHistograms(hcalVeto_, "_hcal_veto"); 
+        getSelectionHistograms(trackBDT_, "_track_bdt"); 
+        getSelectionHistograms(vetoes_, "_vetoes"); 
+    }
+
+    void HCalDQM::getSelectionHistograms(SelectionHistograms& histos, const std::string& suffix) {
+        histos.maxPE = histograms_.get("max_pe" + suffix); 
+        histos.totalPE = histograms_.get("total_pe" + suffix); 
+        histos.nHits = histograms_.get("n_hits" + suffix); 
+        histos.hitTimeMaxPE = histograms_.get("hit_time_max_pe" + suffix); 
+        histos.minTimeHitAboveThresh = histograms_.get("min_time_hit_above_thresh" + suffix); 
     }
 
     void HCalDQM::configure(const ParameterSet& ps) {
@@ -106,7 +121,7 @@ namespace ldmx {
      
         // Get the total hit count
         int hitCount = hcalHits->GetEntriesFast();  
-        histograms_->get("n_hits")->Fill(hitCount); 
+        all_.nHits->Fill(hitCount); 
 
         // Vector containing all HCal hits.  This will be used for sorting.
         std::vector<HcalHit*> hits; 
@@ -115,8 +130,8 @@ namespace ldmx {
         // Loop through all HCal hits in the event
         for (size_t ihit{0}; ihit < hitCount; ++ihit) {
             HcalHit* hit = static_cast<HcalHit*>(hcalHits->At(ihit)); 
-            histograms_->get("pe")->Fill(hit->getPE());
-            histograms_->get("hit_time")->Fill(hit->getTime());
+            pe_->Fill(hit->getPE());
+            hitTime_->Fill(hit->getTime());
            
             totalPE += hit->getPE();
 
@@ -124,7 +139,7 @@ namespace ldmx {
             if (hit->getTime() != -999) hits.push_back(hit);  
         }
         
-        histograms_->get("total_pe")->Fill(totalPE); 
+        all_.totalPE->Fill(totalPE); 
 
         // Sort the array by hit time
         std::sort (hits.begin(), hits.end(), [ ](const auto& lhs, const auto& rhs) 
@@ -141,8 +156,8 @@ namespace ldmx {
             break;
         } 
 
-        histograms_->get("min_time_hit_above_thresh")->Fill(minTime); 
-        histograms_->get("min_time_hit_above_thresh:pe")->Fill(minTimePE, minTime);  
+        all_.minTimeHitAboveThresh->Fill(minTime); 
+        all_.minTimeHitAboveThreshPE->Fill(minTimePE, minTime);  
 
         float maxPE{-1};
         float maxPETime{-1};
@@ -160,17 +175,17 @@ namespace ldmx {
             maxPE = maxPEHit->getPE();
             maxPETime = maxPEHit->getTime();
             
-            histograms_->get("max_pe")->Fill(maxPE);
-            histograms_->get("hit_time_max_pe")->Fill(maxPETime); 
-            histograms_->get("max_pe:time")->Fill(maxPE, maxPETime);
-            histograms_->get("veto")->Fill(veto->passesVeto());   
+            all_.maxPE->Fill(maxPE);
+            all_.hitTimeMaxPE->Fill(maxPETime); 
+            all_.maxPETime->Fill(maxPE, maxPETime);
+            veto_->Fill(veto->passesVeto());   
 
             if (veto->passesVeto()) {
-                histograms_->get("max_pe_hcal_veto")->Fill(maxPE);
-                histograms_->get("hit_time_max_pe_hcal_veto")->Fill(maxPETime); 
-                histograms_->get("max_pe:time_hcal_veto")->Fill(maxPE, maxPETime);
-                histograms_->get("total_pe_hcal_veto")->Fill(totalPE); 
-                histograms_->get("n_hits_hcal_veto")->Fill(hitCount); 
+                hcalVeto_.maxPE->Fill(maxPE);
+                hcalVeto_.hitTimeMaxPE->Fill(maxPETime); 
+                hcalVeto_.maxPETime->Fill(maxPE, maxPETime);
+                hcalVeto_.totalPE->Fill(totalPE); 
+                hcalVeto_.nHits->Fill(hitCount); 
                 passesHcalVeto = veto->passesVeto();  
             }
         }
@@ -185,17 +200,17 @@ namespace ldmx {
        
             // Get the BDT probability  
             bdtProb = veto->getDisc();
-            histograms_->get("bdt_n_hits")->Fill(bdtProb, hitCount); 
+            bdtNHits_->Fill(bdtProb, hitCount); 
             
             // Fill the histograms if the event passes the ECal veto
             if (bdtProb >= .99) {
-                histograms_->get("max_pe_bdt")->Fill(maxPE);
-                histograms_->get("total_pe_bdt")->Fill(totalPE); 
-                histograms_->get("n_hits_bdt")->Fill(hitCount);
-                histograms_->get("hit_time_max_pe_bdt")->Fill(maxPETime);  
-                histograms_->get("min_time_hit_above_thresh_bdt")->Fill(minTime); 
-                histograms_->get("max_pe:time_bdt")->Fill(maxPE, maxPETime);  
-                histograms_->get("min_time_hit_above_thresh:pe_bdt")->Fill(minTimePE, minTime); 
+                bdt_.maxPE->Fill(maxPE);
+                bdt_.totalPE->Fill(totalPE); 
+                bdt_.nHits->Fill(hitCount);
+                bdt_.hitTimeMaxPE->Fill(maxPETime);  
+                bdt_.minTimeHitAboveThresh->Fill(minTime); 
+                bdt_.maxPETime->Fill(maxPE, maxPETime);  
+                bdt_.minTimeHitAboveThreshPE->Fill(minTimePE, minTime); 
                 passesBDT = true;  
             }
         }
@@ -213,37 +228,37 @@ namespace ldmx {
                 
                 passesTrackVeto = true; 
 
-                histograms_->get("max_pe_track_veto")->Fill(maxPE);
-                histograms_->get("total_pe_track_veto")->Fill(totalPE); 
-                histograms_->get("n_hits_track_veto")->Fill(hitCount);
-                histograms_->get("hit_time_max_pe_track_veto")->Fill(maxPETime);  
-                histograms_->get("min_time_hit_above_thresh_track_veto")->Fill(minTime); 
-                histograms_->get("max_pe:time_track_veto")->Fill(maxPE, maxPETime);  
-                histograms_->get("min_time_hit_above_thresh:pe_track_veto")->Fill(minTimePE, minTime);  
-                histograms_->get("bdt_max_pe")->Fill(maxPE, bdtProb);
+                trackVeto_.maxPE->Fill(maxPE);
+                trackVeto_.totalPE->Fill(totalPE); 
+                trackVeto_.nHits->Fill(hitCount);
+                trackVeto_.hitTimeMaxPE->Fill(maxPETime);  
+                trackVeto_.minTimeHitAboveThresh->Fill(minTime); 
+                trackVeto_.maxPETime->Fill(maxPE, maxPETime);  
+                trackVeto_.minTimeHitAboveThreshPE->Fill(minTimePE, minTime);  
+                bdtMaxPE_->Fill(maxPE, bdtProb);
             }
         }
 
 
         if (passesTrackVeto && passesBDT) { 
-            histograms_->get("max_pe_track_bdt")->Fill(maxPE);
-            histograms_->get("total_pe_track_bdt")->Fill(totalPE); 
-            histograms_->get("n_hits_track_bdt")->Fill(hitCount);
-            histograms_->get("hit_time_max_pe_track_bdt")->Fill(maxPETime);  
-            histograms_->get("max_pe:time_track_bdt")->Fill(maxPE, maxPETime);  
-            histograms_->get("min_time_hit_above_thresh_track_bdt")->Fill(minTime); 
-            histograms_->get("min_time_hit_above_thresh:pe_track_bdt")->Fill(minTimePE, minTime);  
+            trackBDT_.maxPE->Fill(maxPE);
+            trackBDT_.totalPE->Fill(totalPE); 
+            trackBDT_.nHits->Fill(hitCount);
+            trackBDT_.hitTimeMaxPE->Fill(maxPETime);  
+            trackBDT_.maxPETime->Fill(maxPE, maxPETime);  
+            trackBDT_.minTimeHitAboveThresh->Fill(minTime); 
+            trackBDT_.minTimeHitAboveThreshPE->Fill(minTimePE, minTime);  
         }
 
         if (passesTrackVeto && passesHcalVeto && passesBDT) {
         
-            histograms_->get("max_pe_vetoes")->Fill(maxPE);
-            histograms_->get("total_pe_vetoes")->Fill(totalPE); 
-            histograms_->get("n_hits_vetoes")->Fill(hitCount);
-            histograms_->get("hit_time_max_pe_vetoes")->Fill(maxPETime);  
-            histograms_->get("max_pe:time_vetoes")->Fill(maxPE, maxPETime);  
-            histograms_->get("min_time_hit_above_thresh_vetoes")->Fill(minTime); 
-            histograms_->get("bdt_max_pe_vetoes")->Fill(maxPE, bdtProb); 
+            vetoes_.maxPE->Fill(maxPE);
+            vetoes_.totalPE->Fill(totalPE); 
+            vetoes_.nHits->Fill(hitCount);
+            vetoes_.hitTimeMaxPE->Fill(maxPETime);  
+            vetoes_.maxPETime->Fill(maxPE, maxPETime);  
+            vetoes_.minTimeHitAboveThresh->Fill(minTime); 
+            bdtMaxPEVetoes_->Fill(maxPE, bdtProb); 
         } 
     }
 
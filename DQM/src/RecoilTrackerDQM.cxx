@@ -27,7 +27,6 @@
 #include "Event/SimParticle.h"
 #include "Event/SimTrackerHit.h"
 #include "Event/TrackerVetoResult.h"
-#include "Framework/HistogramPool.h"
 #include "Tools/AnalysisUtils.h"
 
 namespace ldmx { 
@@ -38,13 +37,35 @@ namespace ldmx {
     RecoilTrackerDQM::~RecoilTrackerDQM() {}
 
     void RecoilTrackerDQM::onProcessStart() {
-        
-        // Get an instance of the histogram pool  
-        histograms_ = HistogramPool::getInstance();    
 
         // Open the file and move into the histogram directory
         getHistoDirectory();
 
+        // Keep the histograms so they don't have to be looked up for each event
+        trackCount_ = histograms_.get("track_count"); 
+        looseTrackCount_ = histograms_.get("loose_track_count"); 
+        axialTrackCount_ = histograms_.get("axial_track_count"); 
+
+        recoilVx_ = histograms_.get("recoil_vx"); 
+        recoilVy_ = histograms_.get("recoil_vy"); 
+        recoilVz_ = histograms_.get("recoil_vz"); 
+
+        all_ = getMomentumHistograms(""); 
+        trackVeto_ = getMomentumHistograms("_track_veto"); 
+        bdt_ = getMomentumHistograms("_bdt"); 
+        trackBDT_ = getMomentumHistograms("_track_bdt"); 
+        hcal_ = getMomentumHistograms("_hcal"); 
+        vetoes_ = getMomentumHistograms("_vetoes"); 
+    }
+
+    RecoilTrackerDQM::MomentumHistograms RecoilTrackerDQM::getMomentumHistograms(const std::string& suffix) {
+        MomentumHistograms histos; 
+        histos.p = histograms_.get("tp" + suffix); 
+        histos.pt = histograms_.get("tpt" + suffix); 
+        histos.px = histograms_.get("tpx" + suffix); 
+        histos.py = histograms_.get("tpy" + suffix); 
+        histos.pz = histograms_.get("tpz" + suffix); 
+        return histos; 
     }
 
     void RecoilTrackerDQM::configure(const ParameterSet& ps) {
@@ -63,9 +84,9 @@ namespace ldmx {
 
         TrackMaps map = Analysis::getFindableTrackMaps(tracks);
       
-        histograms_->get("track_count")->Fill(map.findable.size());  
-        histograms_->get("loose_track_count")->Fill(map.loose.size());  
-        histograms_->get("axial_track_count")->Fill(map.axial.size());  
+        trackCount_->Fill(map.findable.size());  
+        looseTrackCount_->Fill(map.loose.size());  
+        axialTrackCount_->Fill(map.axial.size());  
 
         // Get the collection of simulated particles from the event
         const TClonesArray* particles = event.getCollection("SimParticles");
@@ -80,9 +101,9 @@ namespace ldmx {
 
         // Fill the recoil vertex position histograms
         std::vector<double> recoilVertex = recoil->getVertex();
-        histograms_->get("recoil_vx")->Fill(recoilVertex[0]);  
-        histograms_->get("recoil_vy")->Fill(recoilVertex[1]);  
-        histograms_->get("recoil_vz")->Fill(recoilVertex[2]);  
+        recoilVx_->Fill(recoilVertex[0]);  
+        recoilVy_->Fill(recoilVertex[1]);  
+        recoilVz_->Fill(recoilVertex[2]);  
 
         double p{-1}, pt{-1}, px{-9999}, py{-9999}, pz{-9999}; 
         SimTrackerHit* spHit{nullptr}; 
@@ -112,11 +133,11 @@ namespace ldmx {
             }
         } 
             
-        histograms_->get("tp")->Fill(p);
-        histograms_->get("tpt")->Fill(pt); 
-        histograms_->get("tpx")->Fill(px); 
-        histograms_->get("tpy")->Fill(py); 
-        histograms_->get("tpz")->Fill(pz); 
+        all_.p->Fill(p);
+        all_.pt->Fill(pt); 
+        all_.px->Fill(px); 
+        all_.py->Fill(py); 
+        all_.pz->Fill(pz); 
   
         bool passesTrackVeto{false}; 
         // Check if the TrackerVeto result exists
@@ -134,11 +155,11 @@ namespace ldmx {
 
 
         if (passesTrackVeto) { 
-            histograms_->get("tp_track_veto")->Fill(p);
-            histograms_->get("tpt_track_veto")->Fill(pt); 
-            histograms_->get("tpx_track_veto")->Fill(px); 
-            histograms_->get("tpy_track_veto")->Fill(py); 
-            histograms_->get("tpz_track_veto")->Fill(pz); 
+            trackVeto_.p->Fill(p);
+            trackVeto_.pt->Fill(pt); 
+            trackVeto_.px->Fill(px); 
+            trackVeto_.py->Fill(py); 
+            trackVeto_.pz->Fill(pz); 
         }
 
         // Get the collection of ECal veto results if it exist
@@ -155,21 +176,21 @@ namespace ldmx {
             // Fill the histograms if the event passes the ECal veto
             if (bdtProb >= .99) {
         
-                histograms_->get("tp_bdt")->Fill(p);
-                histograms_->get("tpt_bdt")->Fill(pt); 
-                histograms_->get("tpx_bdt")->Fill(px); 
-                histograms_->get("tpy_bdt")->Fill(py); 
-                histograms_->get("tpz_bdt")->Fill(pz); 
+                bdt_.p->Fill(p);
+                bdt_.pt->Fill(pt); 
+                bdt_.px->Fill(px); 
+                bdt_.py->Fill(py); 
+                bdt_.pz->Fill(pz); 
                 passesBDT = true; 
             }
         }
 
         if (passesTrackVeto && passesBDT) { 
-            histograms_->get("tp_track_bdt")->Fill(p);
-            histograms_->get("tpt_track_bdt")->Fill(pt); 
-            histograms_->get("tpx_track_bdt")->Fill(px); 
-            histograms_->get("tpy_track_bdt")->Fill(py); 
-            histograms_->get("tpz_track_bdt")->Fill(pz); 
+            trackBDT_.p->Fill(p);
+            trackBDT_.pt->Fill(pt); 
+            trackBDT_.px->Fill(px); 
+            trackBDT_.py->Fill(py); 
+            trackBDT_.pz->Fill(pz); 
         }
 
         bool passesHcalVeto{false}; 
@@ -183,11 +204,11 @@ namespace ldmx {
 
             if (veto->passesVeto()) {
                 
-                histograms_->get("tp_hcal")->Fill(p);
-                histograms_->get("tpt_hcal")->Fill(pt); 
-                histograms_->get("tpx_hcal")->Fill(px); 
-                histograms_->get("tpy_hcal")->Fill(py); 
-                histograms_->get("tpz_hcal")->Fill(pz); 
+                hcal_.p->Fill(p);
+                hcal_.pt->Fill(pt); 
+                hcal_.px->Fill(px); 
+                hcal_.py->Fill(py); 
+                hcal_.pz->Fill(pz); 
                 passesHcalVeto = veto->passesVeto();  
             }
         }
@@ -195,11 +216,11 @@ namespace ldmx {
 
 
         if (passesTrackVeto && passesBDT && passesHcalVeto) { 
-            histograms_->get("tp_vetoes")->Fill(p);
-            histograms_->get("tpt_vetoes")->Fill(pt); 
-            histograms_->get("tpx_vetoes")->Fill(px); 
-            histograms_->get("tpy_vetoes")->Fill(py); 
-            histograms_->get("tpz_vetoes")->Fill(pz); 
+            vetoes_.p->Fill(p);
+            vetoes_.pt->Fill(pt); 
+            vetoes_.px->Fill(px); 
+            vetoes_.py->Fill(py); 
+            vetoes_.pz->Fill(pz); 
         }
     }
 
@@ -15,6 +15,10 @@ namespace ldmx {
     /**
      * @class DetectorIDStore
      * @brief A global store for accessing DetectorID objects
+     *
+     * @note The stored IDs are filled once while the geometry is read.  A
+     * DetectorID keeps the field values it is packing, so the sensitive
+     * detectors of each thread get their own IDs from createID().
      */
     class DetectorIDStore {
 
@@ -38,8 +42,24 @@ namespace ldmx {
              * Get a detector ID by name.
              * @return The detector ID with the name or <i>nullptr</i> if does not exist.
              */
-            DetectorID* getID(const std::string& name) {
-                return ids[name];
+            DetectorID* getID(const std::string& name) const {
+                auto it = ids.find(name);
+                return it != ids.end() ? it->second : nullptr;
+            }
+
+            /**
+             * Create a new detector ID with the fields of a stored one.
+             * @param name The name of the stored detector ID.
+             * @return The new detector ID, which is owned by the caller, or <i>nullptr</i> if none has the name.
+             */
+            DetectorID* createID(const std::string& name) const {
+                DetectorID* id = getID(name);
+                if (!id) return nullptr;
+                IDField::IDFieldList* fieldList = new IDField::IDFieldList();
+                for (IDField* field : *id->getFieldList()) {
+                    fieldList->push_back(new IDField(field->getFieldName(), field->getIndex(), field->getStartBit(), field->getEndBit()));
+                }
+                return new DetectorID(fieldList);
             }
 
             /**
@@ -12,15 +12,45 @@
 #define DETDESCR_ECALHEXREADOUT_H_
 
 // STL
+#include <cmath>
 #include <map>
+#include <stdexcept>
+#include <string>
+#include <vector>
 
 // ROOT
-#include "TH2Poly.h"
+#include "TString.h"
 
 namespace ldmx {
 
     typedef std::pair<double,double> XYCoords;
 
+    /**
+     * @class CellIDSpan
+     * @brief Read-only view of a contiguous list of cell IDs owned by an EcalHexReadout
+     */
+    class CellIDSpan {
+
+        public:
+
+            CellIDSpan(const int* first, const int* last) : first_(first), last_(last) { }
+
+            const int* begin() const { return first_; }
+
+            const int* end() const { return last_; }
+
+            std::size_t size() const { return last_ - first_; }
+
+            bool empty() const { return first_ == last_; }
+
+            int operator[](std::size_t i) const { return first_[i]; }
+
+        private:
+
+            const int* first_;
+            const int* last_;
+    };
+
     /**
      * @class EcalHexReadout
      * @brief Implementation of ECal hexagonal cell readout
@@ -45,6 +75,13 @@ namespace ldmx {
              */
             virtual ~EcalHexReadout() { }
 
+            /**
+             * Get the readout with the default geometry, shared by the whole process.
+             * It is built on first use and never modified afterwards, so it can be
+             * used from any thread.
+             */
+            static const EcalHexReadout& getInstance();
+
             /**
              * Combine cell and module IDs into a per-layer ID
              */
@@ -62,22 +99,24 @@ namespace ldmx {
             /**
              * Get a module center position relative to the ecal center [mm]
              */
-            XYCoords getModuleCenter(int moduleID) const {
-                return modulePositionMap_.at(moduleID);
+            const XYCoords& getModuleCenter(int moduleID) const {
+                return modulePositions_.at(moduleID);
             }
 
             /**
              * Get a module ID from an XY position relative to the ecal center [mm]
+             * The modules sit on a hexagonal lattice, so this is a constant time lookup
+             * for any point within the modules. Points outside of them get the closest module.
              */
             int getModuleID(double x, double y) const {
+                int moduleID = moduleLattice_.find(x,y);
+                if(moduleID >= 0) return moduleID;
                 int bestID = -1;
                 double bestDist = 1E6;
-                for(auto const& module : modulePositionMap_) {  
-                    int mID   = module.first;
-                    double mX = module.second.first;
-                    double mY = module.second.second;
+                for(int mID = 0; mID < int(modulePositions_.size()); mID++) {
+                    double mX = modulePositions_[mID].first;
+                    double mY = modulePositions_[mID].second;
                     double dist = sqrt( (x-mX)*(x-mX) + (y-mY)*(y-mY) );
-                    if(dist < moduler_) return mID;
                     if(dist < bestDist) { bestID = mID; bestDist = dist; }
                 }
                 return bestID;
@@ -85,24 +124,26 @@ namespace ldmx {
 
             /**
              * Get a cell ID from an XY position relative to module center. 
+             * The point is transformed into the coordinates of the hexagonal cell grid
+             * and the cell is looked up in a table, so this takes constant time.
              * This is where invalid (x,y) from external calls will end up failing and need error handling.
              * @param x Any X position [mm]
              * @param y Any Y position [mm]
              */
             int getCellIDRelative(double x, double y) const {
-                int bin = ecalMap_->FindBin(x,y)-1; // NB FindBin indices starts from 1, our maps start from 0
-                if(bin < 0) {
+                int cellID = cellLattice_.find(x,y);
+                if(cellID < 0) {
                     TString error_msg = TString("[EcalHexReadout::getCellIDRelative] Relative coordinates are outside module hexagon!") + 
                                         TString::Format(" Is the gap used by EcalHexReadout (%.2f mm) and the minimum module radius (%.2f mm)",gap_,moduler_) +
                                         TString::Format(" the same as hexagon_gap and Hex_radius in ecal.gdml? Received (x,y) = (%.2f,%.2f).",x,y);
                     throw std::invalid_argument(error_msg.Data());
                 }
-                return bin;
+                return cellID;
             }
 
             /**
              * Get a combined cellModule ID from an XY position relative to ecal center.
-             * Error is ID < 0 (see TH2Poly for meanings).
+             * Error is exception (see getCellIDRelative).
              * @param x Any X position [mm]
              * @param y Any Y position [mm]
              * @param moduleID The module copy number (0 through 6)
@@ -121,14 +162,11 @@ namespace ldmx {
              * @param cellID The cell ID.
              * @return The XY position of the center of the cell. Error is exception.
              */
-            XYCoords getCellCenterRelative(int cellID) const {
-                // this map search is probably just as fine as the TList search for the cell in ecalMap.
-                //   wonder why TH2Poly->GetBin(ID) doesn't exist. plus the map is useful by itself.
-                auto search = cellPositionMap_.find(cellID);
-                if(search == cellPositionMap_.end()) {
+            const XYCoords& getCellCenterRelative(int cellID) const {
+                if(cellID < 0 || cellID >= int(cellPositions_.size())) {
                     throw std::runtime_error("Error: cell " + std::to_string(cellID) + " is not valid");
                 }
-                return search->second;
+                return cellPositions_[cellID];
             }
 
             /**
@@ -136,24 +174,28 @@ namespace ldmx {
              * @param cellModuleID The combined cellModuleID.
              * @return The XY position of the center of the cell. Error is exception.
              */
-            XYCoords getCellCenterAbsolute(int cellModuleID) const {
-                return cellModulePositionMap_.at(cellModuleID);
+            const XYCoords& getCellCenterAbsolute(int cellModuleID) const {
+                return cellModulePositions_[denseID(cellModuleID)];
             }
 
             /**
-             * @param Return NN IDs, which are combined cellModuleIDs. Normally six. Return by copy.
+             * @param Return NN IDs, which are combined cellModuleIDs. Normally six.
+             *   The returned span points into the neighbor table of this readout.
              *   NB cellModuleIDs are: 10*cellID+moduleID
              */
-            std::vector<int> getNN(int cellModuleID) const {
-              return NNMap_.at(cellModuleID);
+            CellIDSpan getNN(int cellModuleID) const {
+                int id = denseID(cellModuleID);
+                return CellIDSpan(NN_.data()+NNOffsets_[id], NN_.data()+NNOffsets_[id+1]);
             }
 
             /**
-             * @param Return NNN IDs, which are cellModuleIDs. Normally twelve. Return by copy.
+             * @param Return NNN IDs, which are cellModuleIDs. Normally twelve.
+             *   The returned span points into the neighbor table of this readout.
              *   NB cellModuleIDs are: 10*cellID+moduleID
              */
-            std::vector<int> getNNN(int cellModuleID) const {
-              return NNNMap_.at(cellModuleID);
+            CellIDSpan getNNN(int cellModuleID) const {
+                int id = denseID(cellModuleID);
+                return CellIDSpan(NNN_.data()+NNNOffsets_[id], NNN_.data()+NNNOffsets_[id+1]);
             }
 
             /**
@@ -182,11 +224,23 @@ namespace ldmx {
              * Distance to module edge, and whether cell is on edge of module.
              * Use getNN()/getNNN() + isEdgeCell() to expand functionality.
              */
-            double distanceToEdge(int cellModuleID) const;
+            double distanceToEdge(int cellModuleID) const {
+                return cellEdgeDistances_[denseID(cellModuleID)/modulePositions_.size()];
+            }
             bool isEdgeCell(int cellModuleID) const {
                 return (distanceToEdge(cellModuleID) < cellR_);
             }
 
+            /**
+             * Number of cells in each module.
+             */
+            int getNCellsPerModule() const { return cellPositions_.size(); }
+
+            /**
+             * Number of modules in each layer.
+             */
+            int getNModules() const { return modulePositions_.size(); }
+
             /**
              * Return entire cellID - cell center position map with read access
              */
@@ -221,6 +275,44 @@ namespace ldmx {
 
         private:
 
+            /**
+             * @struct HexLattice
+             * @brief Table of the IDs of hexagons lying on a regular hexagonal lattice
+             *
+             * Points are converted to axial lattice coordinates and rounded to the
+             * closest lattice site, i.e. to the hexagon containing them.
+             */
+            struct HexLattice {
+
+                /**
+                 * Fill the table from the hexagon centers. The ID of each hexagon is
+                 * its index in the list.
+                 * @param centers Centers of the hexagons [mm], one of which is at (0,0).
+                 * @param size Center-to-corner radius of the hexagons [mm].
+                 * @param flatTop True for flat-side-down hexagons, false for corner-side-down.
+                 * @throw std::logic_error if the centers don't lie on the lattice.
+                 */
+                void fill(const std::vector<XYCoords>& centers, double size, bool flatTop);
+
+                /**
+                 * Get the ID of the hexagon containing a point, -1 if there is none.
+                 */
+                int find(double x, double y) const;
+
+                /**
+                 * Round a point to the axial coordinates (q,r) of the closest lattice site.
+                 */
+                void round(double x, double y, int& q, int& r) const;
+
+                double size_{1};
+                bool flatTop_{false};
+                int qMin_{0};
+                int rMin_{0};
+                int nQ_{0};
+                int nR_{0};
+                std::vector<int> ids_;
+            };
+
             /**
              * Constructs the positions of the seven modules (moduleID) relative to the ecal center
              */
@@ -241,10 +333,30 @@ namespace ldmx {
             void buildCellModuleMap();
 
             /**
-             * Construts NNMap and NNNMap
+             * Construts NN and NNN tables
              */
             void buildNeighborMaps();
 
+            /**
+             * Calculate the distance of a cell center to the edge of its module.
+             * @param cellID The cell ID.
+             */
+            double calculateDistanceToEdge(int cellID) const;
+
+            /**
+             * Convert a combined cellModuleID into the dense index used by the flat tables,
+             * cellID*nModules+moduleID. Dense indices are ordered like the cellModuleIDs.
+             * @throw std::out_of_range if the ID doesn't correspond to a cell.
+             */
+            int denseID(int cellModuleID) const {
+                int cellID = cellModuleID/10;
+                int moduleID = cellModuleID % 10;
+                if(cellModuleID < 0 || moduleID >= int(modulePositions_.size()) || cellID >= int(cellPositions_.size())) {
+                    throw std::out_of_range("[EcalHexReadout] Invalid cellModuleID " + std::to_string(cellModuleID));
+                }
+                return cellID*modulePositions_.size()+moduleID;
+            }
+
             int verbose_{0}; // 0 to 3
 
             unsigned nCellsWide_{0};
@@ -257,11 +369,26 @@ namespace ldmx {
             double columnDistance_{0};
             double rowDistance_{0};
 
+            // lookup tables, indexed by moduleID, cellID and dense cellModule index respectively
+            std::vector<XYCoords> modulePositions_;
+            std::vector<XYCoords> cellPositions_;
+            std::vector<XYCoords> cellModulePositions_;
+            std::vector<double> cellEdgeDistances_;
+
+            // lookups of cellID and moduleID from a position
+            HexLattice cellLattice_;
+            HexLattice moduleLattice_;
+
+            // neighbor cellModuleIDs of each dense cellModule index i are NN_[NNOffsets_[i]] to NN_[NNOffsets_[i+1]-1]
+            std::vector<int> NN_;
+            std::vector<int> NNOffsets_;
+            std::vector<int> NNN_;
+            std::vector<int> NNNOffsets_;
+
+            // the same positions keyed by ID, kept for the map accessors
             std::map<int, XYCoords> modulePositionMap_;
             std::map<int, XYCoords> cellPositionMap_;
             std::map<int, XYCoords> cellModulePositionMap_;
-            std::map<int, std::vector<int> > NNMap_;
-            std::map<int, std::vector<int> > NNNMap_;
 
             /** 
              * MUST SYNC MINR AND GAP WITH ECAL.GDML. May change cell count here for eg granularity studies.
@@ -277,9 +404,6 @@ namespace ldmx {
             static constexpr double defaultMinR{85.};
             static constexpr double defaultGap_{0.};
             static constexpr unsigned defaultNCellsWide{23};
-
-            std::unique_ptr<TH2Poly> ecalMap_;
-            std::unique_ptr<TH2Poly> gridMap_;
     };
 
 }
@@ -1,15 +1,24 @@
 #include "DetDescr/EcalHexReadout.h"
 
+#include "TH2Poly.h"
 #include "TList.h"
 #include "TGeoPolygon.h"
 #include "TGraph.h"
 #include "TMultiGraph.h"
 
+#include <algorithm>
 #include <assert.h>
+#include <cmath>
 #include <iostream>
 
 namespace ldmx {
 
+    const EcalHexReadout& EcalHexReadout::getInstance() {
+        // initialization of a function-local static is thread safe
+        static const EcalHexReadout instance;
+        return instance;
+    }
+
     EcalHexReadout::EcalHexReadout(double moduleMinR, double gap, unsigned nCellsWide){
 
         // ORIENTATION ASSUMPTIONS:
@@ -64,8 +73,6 @@ namespace ldmx {
             std::cout << TString::Format("  min/max radii of cell %.2f %.2f and module %.2f %.2f",cellr_,cellR_,moduler_,moduleR_) << std::endl;
         }
 
-        ecalMap_ = std::make_unique<TH2Poly>();
-        gridMap_ = std::make_unique<TH2Poly>();
         buildModuleMap();
         buildCellMap();
         buildCellModuleMap();
@@ -77,30 +84,36 @@ namespace ldmx {
         if(verbose_>0) std::cout << std::endl << "[buildModuleMap] Building module position map for module min r of " << moduler_ << std::endl;
         // module IDs are 0 for ecal center, 1 at 12 o'clock, and clockwise till 6 at 11 o'clock.
         double C_PI = 3.14159265358979323846; // or TMath::Pi(), #define, atan(), ...
-        modulePositionMap_[0] = std::pair<double,double>(0.,0.);
+        modulePositions_.clear();
+        modulePositions_.push_back(std::pair<double,double>(0.,0.));
+        modulePositionMap_[0] = modulePositions_.back();
         for(unsigned id = 1 ; id < 7 ; id++){
             double x = (2.*moduler_+gap_)*sin( (id-1)*(C_PI/3.) );
             double y = (2.*moduler_+gap_)*cos( (id-1)*(C_PI/3.) );
-            modulePositionMap_[id] = std::pair<double,double>(x,y);
+            modulePositions_.push_back(std::pair<double,double>(x,y));
+            modulePositionMap_[id] = modulePositions_.back();
             if(verbose_>2) std::cout << TString::Format("   id %d is at (%.2f, %.2f)",id,x,y) << std::endl;
         }
+        // modules are flat side down and the center-to-center distance is 2*moduler_+gap_
+        moduleLattice_.fill(modulePositions_, (2.*moduler_+gap_)/sqrt(3.), true);
         if(verbose_>0) std::cout << std::endl;
     }
 
     void EcalHexReadout::buildCellModuleMap(){
         if(verbose_>0) std::cout << std::endl << "[buildCellModuleMap] Building cellModule position map" << std::endl;
-        for(auto const& module : modulePositionMap_) {
-            int moduleID = module.first;
-            double moduleX = module.second.first;
-            double moduleY = module.second.second;
-            for(auto const& cell : cellPositionMap_) {
-                int cellID = cell.first;
-                double cellX = cell.second.first;
-                double cellY = cell.second.second;
-                double x = cellX+moduleX;
-                double y = cellY+moduleY;
-                int cellModuleID = combineID(cellID,moduleID);
-                cellModulePositionMap_[cellModuleID] = std::pair<double,double>(x,y);
+        // dense index runs over modules fastest, see denseID()
+        cellModulePositions_.clear();
+        cellModulePositions_.reserve(cellPositions_.size()*modulePositions_.size());
+        cellEdgeDistances_.clear();
+        for(int cellID = 0; cellID < int(cellPositions_.size()); cellID++) {
+            double cellX = cellPositions_[cellID].first;
+            double cellY = cellPositions_[cellID].second;
+            cellEdgeDistances_.push_back(calculateDistanceToEdge(cellID));
+            for(int moduleID = 0; moduleID < int(modulePositions_.size()); moduleID++) {
+                double x = cellX+modulePositions_[moduleID].first;
+                double y = cellY+modulePositions_[moduleID].second;
+                cellModulePositions_.push_back(std::pair<double,double>(x,y));
+                cellModulePositionMap_[combineID(cellID,moduleID)] = cellModulePositions_.back();
             }
         }
         if(verbose_>0) std::cout << "  contained " << cellModulePositionMap_.size() << " entries. " << std::endl;
@@ -109,12 +122,11 @@ namespace ldmx {
     void EcalHexReadout::buildCellMap(){
         /** STRATEGY
          * use native ROOT HoneyComb method to build large hexagonal grid.
-         * then copy from it the polygons which cover a module.
+         * then keep from it the cells which cover a module, in the grid's bin order.
          * the latter is simple (see isInside()) and is all that needs to
          * be changed for future module layouts.
          */
-        if(ecalMap_) ecalMap_->Clear();
-        if(gridMap_) gridMap_->Clear();
+        TH2Poly gridMap;
 
         // make hexagonal grid [boundary is rectangle] larger than the module
         unsigned gridCellsWide = nCellsWide_+2;
@@ -123,7 +135,7 @@ namespace ldmx {
         rowDistance_ = 1.5*cellR_;
         double gridWidth = (gridCellsWide)*columnDistance_;
         double gridHeight = (gridCellsWide-1)*rowDistance_ + 2*cellR_;
-        gridMap_->Honeycomb( -gridWidth/2, -gridHeight/2, cellR_, gridCellsWide, gridCellsWide);
+        gridMap.Honeycomb( -gridWidth/2, -gridHeight/2, cellR_, gridCellsWide, gridCellsWide);
 
         if(verbose_>0){
             std::cout << std::endl;
@@ -134,8 +146,8 @@ namespace ldmx {
         }
 
         // copy cells lying within module boundaries to a module grid
-        std::vector<int> cellIdCopied(gridMap_->GetNumberOfBins());
-        TListIter next(gridMap_->GetBins()); // a TH2Poly is a TList of TH2PolyBin
+        std::vector<int> cellIdCopied(gridMap.GetNumberOfBins());
+        TListIter next(gridMap.GetBins()); // a TH2Poly is a TList of TH2PolyBin
         TH2PolyBin *polyBin = 0;
         TGraph * poly = 0; // a polygon returned by TH2Poly is a TGraph
         int ecalMapID = 0; // ecalMap cell IDs go from 0 to N-1, not equal to original grid cell ID.
@@ -164,14 +176,17 @@ namespace ldmx {
                 bool isCopied = (std::find(std::begin(cellIdCopied), std::end(cellIdCopied), id) != cellIdCopied.end());
                 if(verbose_>1 && isCopied) std::cout << "    cell was used already! not copying." << std::endl;
                 if(!isCopied){
-                    ecalMap_->AddBin(poly);
-                    cellPositionMap_[ecalMapID] = std::pair<double,double>(x,y);
+                    cellPositions_.push_back(std::pair<double,double>(x,y));
+                    cellPositionMap_[ecalMapID] = cellPositions_.back();
                     ecalMapID++;
                     cellIdCopied.push_back(id);
                 }
             }
         }
 
+        // the honeycomb has a cell centered at (0,0), see above
+        cellLattice_.fill(cellPositions_, cellR_, false);
+
         if(verbose_>0) std::cout << std::endl;
         return;
     }
@@ -190,22 +205,27 @@ namespace ldmx {
          */
         if(verbose_>0) std::cout << std::endl << TString::Format("[buildNeighborMap] Building with %d cells wide", nCellsWide_) << std::endl;
 
-        NNMap_.clear();
-        NNNMap_.clear();
-        for(auto const& centerChannel : cellModulePositionMap_) {
-            int centerID = centerChannel.first;
-            double centerX = centerChannel.second.first;
-            double centerY = centerChannel.second.second;
-            for(auto const& probeChannel : cellModulePositionMap_) {
-                int probeID = probeChannel.first;
-                double probeX = probeChannel.second.first;
-                double probeY = probeChannel.second.second;
+        NN_.clear();
+        NNN_.clear();
+        NNOffsets_.assign(1,0);
+        NNNOffsets_.assign(1,0);
+        int nCellModules = cellModulePositions_.size();
+        for(int center = 0; center < nCellModules; center++) {
+            double centerX = cellModulePositions_[center].first;
+            double centerY = cellModulePositions_[center].second;
+            for(int probe = 0; probe < nCellModules; probe++) {
+                double probeX = cellModulePositions_[probe].first;
+                double probeY = cellModulePositions_[probe].second;
                 double dist = sqrt( (probeX-centerX)*(probeX-centerX) + (probeY-centerY)*(probeY-centerY) );
-                if(      dist > 1*cellr_  && dist <= 3.*cellr_)  { NNMap_[centerID].push_back(probeID); }
-                else if( dist > 3.*cellr_ && dist <= 4.5*cellr_) {NNNMap_[centerID].push_back(probeID); }
+                int probeID = combineID(probe/modulePositions_.size(), probe % modulePositions_.size());
+                if(      dist > 1*cellr_  && dist <= 3.*cellr_)  { NN_.push_back(probeID); }
+                else if( dist > 3.*cellr_ && dist <= 4.5*cellr_) { NNN_.push_back(probeID); }
             }
-            if(verbose_>1) std::cout << TString::Format("Found %d NN and %d NNN for cellModuleID %d with x,y (%.2f,%.2f)",
-                                                        NNMap_[centerID].size(), NNNMap_[centerID].size(), centerID, centerX, centerY) << std::endl;
+            NNOffsets_.push_back(NN_.size());
+            NNNOffsets_.push_back(NNN_.size());
+            if(verbose_>1) std::cout << TString::Format("Found %d NN and %d NNN for dense cellModule index %d with x,y (%.2f,%.2f)",
+                                                        NNOffsets_[center+1]-NNOffsets_[center], NNNOffsets_[center+1]-NNNOffsets_[center],
+                                                        center, centerX, centerY) << std::endl;
         }
         if(verbose_>2){
             double specialX = 0.5*moduleR_ - 0.5*cellr_; // center of cell which is upper-right corner of center module
@@ -213,11 +233,11 @@ namespace ldmx {
             int specialCellModuleID = getCellModuleID(specialX,specialY);
             std::cout << "The neighbors of the bin in the upper-right corner of the center module, with cellModuleID " 
                       << specialCellModuleID << " include " << std::endl;
-            for(auto centerNN : NNMap_.at(specialCellModuleID)){
+            for(auto centerNN : getNN(specialCellModuleID)){
                 std::cout << TString::Format(" NN ID %d (x,y) (%.2f, %.2f)",
                              centerNN,getCellCenterAbsolute(centerNN).first,getCellCenterAbsolute(centerNN).second) << std::endl;
             }
-            for(auto centerNNN : NNNMap_.at(specialCellModuleID)){
+            for(auto centerNNN : getNNN(specialCellModuleID)){
                 std::cout << TString::Format(" NNN ID %d (x,y) (%.2f, %.2f)",
                              centerNNN,getCellCenterAbsolute(centerNNN).first,getCellCenterAbsolute(centerNNN).second) << std::endl;
             }
@@ -228,9 +248,8 @@ namespace ldmx {
         return;
     }
 
-    double EcalHexReadout::distanceToEdge(int cellModuleID) const {
+    double EcalHexReadout::calculateDistanceToEdge(int cellID) const {
         // https://math.stackexchange.com/questions/1210572/find-the-distance-to-the-edge-of-a-hexagon
-        int cellID = separateID(cellModuleID).first;
         XYCoords cellLocation = getCellCenterRelative(cellID);
         double x = fabs(cellLocation.first); // bring to first quadrant
         double y = fabs(cellLocation.second);
@@ -255,4 +274,64 @@ namespace ldmx {
         return (dotProd > 0.);
     }
 
+    void EcalHexReadout::HexLattice::fill(const std::vector<XYCoords>& centers, double size, bool flatTop) {
+        size_ = size;
+        flatTop_ = flatTop;
+
+        std::vector<std::pair<int,int> > sites;
+        int qMax = 0, rMax = 0;
+        qMin_ = 0;
+        rMin_ = 0;
+        for(auto const& center : centers) {
+            int q, r;
+            round(center.first, center.second, q, r);
+            // position of the lattice site, to check that the center is really on it
+            double x = flatTop_ ? size_*1.5*q : size_*sqrt(3.)*(q + r/2.);
+            double y = flatTop_ ? size_*sqrt(3.)*(r + q/2.) : size_*1.5*r;
+            if(fabs(x-center.first) > 1E-6*size_ || fabs(y-center.second) > 1E-6*size_) {
+                throw std::logic_error(TString::Format("[EcalHexReadout] Hexagon at (%.4f,%.4f) is not on the lattice.",
+                                                       center.first, center.second).Data());
+            }
+            qMin_ = std::min(qMin_,q); qMax = std::max(qMax,q);
+            rMin_ = std::min(rMin_,r); rMax = std::max(rMax,r);
+            sites.push_back(std::make_pair(q,r));
+        }
+
+        nQ_ = qMax-qMin_+1;
+        nR_ = rMax-rMin_+1;
+        ids_.assign(nQ_*nR_,-1);
+        for(unsigned id = 0; id < sites.size(); id++) {
+            ids_[(sites[id].second-rMin_)*nQ_ + (sites[id].first-qMin_)] = id;
+        }
+    }
+
+    int EcalHexReadout::HexLattice::find(double x, double y) const {
+        int q, r;
+        round(x, y, q, r);
+        q -= qMin_;
+        r -= rMin_;
+        if(q < 0 || q >= nQ_ || r < 0 || r >= nR_) return -1;
+        return ids_[r*nQ_ + q];
+    }
+
+    void EcalHexReadout::HexLattice::round(double x, double y, int& q, int& r) const {
+        // fractional axial coordinates, with the third cube coordinate s = -q-r
+        double fq, fr;
+        if(flatTop_) {
+            fq = (2./3.)*x/size_;
+            fr = (-x/3. + y/sqrt(3.))/size_;
+        } else {
+            fq = (x/sqrt(3.) - y/3.)/size_;
+            fr = (2./3.)*y/size_;
+        }
+        double fs = -fq-fr;
+        double rq = std::round(fq), rr = std::round(fr), rs = std::round(fs);
+        // the coordinate furthest from its rounded value is fixed by q+r+s = 0
+        double dq = fabs(rq-fq), dr = fabs(rr-fr), ds = fabs(rs-fs);
+        if(dq > dr && dq > ds) rq = -rr-rs;
+        else if(dr > ds) rr = -rq-rs;
+        q = int(rq);
+        r = int(rr);
+    }
+
 }
@@ -0,0 +1,144 @@
+// LDMX
+#include "DetDescr/EcalHexReadout.h"
+
+// ROOT
+#include "TH2Poly.h"
+
+// STL
+#include <algorithm>
+#include <cmath>
+#include <iostream>
+#include <stdexcept>
+#include <vector>
+
+using ldmx::EcalHexReadout;
+using ldmx::XYCoords;
+
+/*
+ * Hexagonal distance of a point from a corner-side-down cell center,
+ * in units of the cell's center-to-flat radius. The cell edge is at 1.
+ */
+double hexNorm(double dx, double dy, double cellr) {
+    double a = fabs(dx);
+    double b = fabs(0.5*dx + 0.5*sqrt(3.)*dy);
+    double c = fabs(0.5*dx - 0.5*sqrt(3.)*dy);
+    return std::max(a, std::max(b, c))/cellr;
+}
+
+int main(int, const char* argv[])  {
+
+    std::cout << "Hello EcalHexReadout test!" << std::endl;
+
+    const EcalHexReadout& hex = EcalHexReadout::getInstance();
+
+    double cellr = hex.getCellMinMaxRadii()[0];
+    double cellR = hex.getCellMinMaxRadii()[1];
+    double moduleR = hex.getModuleMinMaxRadii()[1];
+    double tolerance = 1E-6*cellR;
+
+    /*
+     * Build the reference TH2Poly the way the readout used to, one corner-side-down
+     * hexagon per cell added in cellID order, so that bin-1 is the cellID.
+     */
+    TH2Poly reference;
+    std::vector<XYCoords> centers;
+    for (auto const& cell : hex.getCellPositionMap()) {
+        double x[6], y[6];
+        for (int i = 0; i < 6; i++) {
+            double phi = (30. + 60.*i)*M_PI/180.;
+            x[i] = cell.second.first + cellR*cos(phi);
+            y[i] = cell.second.second + cellR*sin(phi);
+        }
+        reference.AddBin(6, x, y);
+        centers.push_back(cell.second);
+    }
+    std::cout << "Built reference with " << centers.size() << " cells" << std::endl;
+
+    /*
+     * Dense grid over the module plus points along every cell edge.
+     */
+    std::vector<XYCoords> points;
+    int nSteps = 500;
+    for (int ix = 0; ix <= nSteps; ix++) {
+        for (int iy = 0; iy <= nSteps; iy++) {
+            points.push_back(XYCoords(-1.05*moduleR + 2.1*moduleR*ix/nSteps, -1.05*moduleR + 2.1*moduleR*iy/nSteps));
+        }
+    }
+    for (auto const& center : centers) {
+        for (int i = 0; i < 6; i++) {
+            double phi0 = (30. + 60.*i)*M_PI/180., phi1 = (90. + 60.*i)*M_PI/180.;
+            for (double f : {0., 0.25, 0.5, 0.75}) {
+                points.push_back(XYCoords(center.first + cellR*((1-f)*cos(phi0) + f*cos(phi1)),
+                                          center.second + cellR*((1-f)*sin(phi0) + f*sin(phi1))));
+            }
+        }
+    }
+
+    int nFailed = 0;
+    for (auto const& point : points) {
+        double x = point.first, y = point.second;
+
+        int expected = reference.FindBin(x, y) - 1;
+        if (expected < 0) expected = -1;
+
+        int found = -1;
+        try {
+            found = hex.getCellIDRelative(x, y);
+        } catch (const std::invalid_argument&) {
+        }
+
+        if (found == expected) continue;
+
+        // points on an edge may go to either side of it
+        bool onEdge = false;
+        if (found >= 0 && expected >= 0) {
+            double dFound = hypot(x - centers[found].first, y - centers[found].second);
+            double dExpected = hypot(x - centers[expected].first, y - centers[expected].second);
+            onEdge = fabs(dFound - dExpected) < tolerance;
+        } else {
+            int cell = std::max(found, expected);
+            onEdge = fabs(hexNorm(x - centers[cell].first, y - centers[cell].second, cellr) - 1.) < 1E-6;
+        }
+
+        if (!onEdge) {
+            std::cout << "Mismatch at (" << x << ", " << y << "): TH2Poly gives " << expected
+                      << ", getCellIDRelative gives " << found << std::endl;
+            nFailed++;
+        }
+    }
+    std::cout << "Checked " << points.size() << " points against TH2Poly" << std::endl;
+
+    /*
+     * Module lookup against the closest module center, and the round trip through cell centers.
+     */
+    for (int ix = 0; ix <= nSteps; ix++) {
+        for (int iy = 0; iy <= nSteps; iy++) {
+            double x = -3.5*moduleR + 7.*moduleR*ix/nSteps, y = -3.5*moduleR + 7.*moduleR*iy/nSteps;
+            int found = hex.getModuleID(x, y);
+            double dFound = hypot(x - hex.getModuleCenter(found).first, y - hex.getModuleCenter(found).second);
+            for (auto const& module : hex.getModulePositionMap()) {
+                if (hypot(x - module.second.first, y - module.second.second) < dFound - tolerance) {
+                    std::cout << "Module mismatch at (" << x << ", " << y << "): closest is " << module.first
+                              << ", getModuleID gives " << found << std::endl;
+                    nFailed++;
+                    break;
+                }
+            }
+        }
+    }
+
+    for (auto const& cellModule : hex.getCellModulePositionMap()) {
+        int found = hex.getCellModuleID(cellModule.second.first, cellModule.second.second);
+        if (found != cellModule.first) {
+            std::cout << "Cell center of " << cellModule.first << " gives cellModuleID " << found << std::endl;
+            nFailed++;
+        }
+    }
+
+    if (nFailed > 0) {
+        throw std::runtime_error("EcalHexReadout cell finder disagrees with TH2Poly for " + std::to_string(nFailed) + " points");
+    }
+    std::cout << "EcalHexReadout cell finder okay" << std::endl;
+
+    return 0;
+}
@@ -0,0 +1,89 @@
+// LDMX
+#include "DetDescr/EcalDetectorID.h"
+#include "DetDescr/EcalHexReadout.h"
+#include "Ecal/IndexedClusterFinder.h"
+#include "Ecal/MyClusterWeight.h"
+#include "Ecal/TemplatedClusterFinder.h"
+#include "Event/EcalHit.h"
+#include "Framework/Benchmark.h"
+
+// STL
+#include <random>
+#include <stdexcept>
+#include <string>
+#include <vector>
+
+using namespace ldmx;
+
+/*
+ * Benchmark of the ECal cluster finders on synthetic showers of N hits,
+ * spread around a few seeds like the digis seen by EcalClusterProducer.
+ */
+
+/** Make the hits of a synthetic event with a number of showers. */
+static std::vector<EcalHit> makeHits(const EcalHexReadout& hex, int nHits, int nShowers, std::mt19937& generator) {
+    std::uniform_real_distribution<double> uniform(-1., 1.);
+    std::normal_distribution<double> spread(0., 15.);
+    std::exponential_distribution<double> energy(1.);
+    std::uniform_int_distribution<int> layer(0, 33);
+
+    std::vector<std::pair<double, double>> showers;
+    for (int i = 0; i < nShowers; i++) showers.emplace_back(100.*uniform(generator), 100.*uniform(generator));
+
+    EcalDetectorID detID;
+    std::vector<EcalHit> hits(nHits);
+    for (int i = 0; i < nHits; i++) {
+        const auto& shower = showers[i % nShowers];
+        int cellModuleID = -1;
+        while (cellModuleID < 0) {
+            try {
+                cellModuleID = hex.getCellModuleID(shower.first + spread(generator), shower.second + spread(generator));
+            } catch (const std::exception&) {
+                // outside of the modules, draw again
+            }
+        }
+        std::pair<int, int> ids = hex.separateID(cellModuleID);
+        detID.setFieldValue(1, layer(generator));
+        detID.setFieldValue(2, ids.second);
+        detID.setFieldValue(3, ids.first);
+        hits[i].setID(detID.pack());
+        hits[i].setEnergy(energy(generator));
+    }
+    return hits;
+}
+
+/** Time the clustering of the hits with one of the cluster finders. */
+template <class Finder>
+static void run(const std::string& name, const EcalHexReadout& hex, const std::vector<EcalHit>& hits) {
+    EcalDetectorID detID;
+    std::vector<double> zPos;
+    for (const EcalHit& hit : hits) {
+        detID.setRawValue(hit.getID());
+        detID.unpack();
+        // roughly the layer positions used by EcalClusterProducer
+        zPos.push_back(-137.2 + 8.5*detID.getFieldValue(1));
+    }
+
+    double seconds = benchmark::measure([&]() {
+        Finder cf;
+        for (size_t i = 0; i < hits.size(); i++) cf.add(&hits[i], hex, zPos[i]);
+        cf.cluster(1.5, 10.);
+        benchmark::keep(cf.getNSeeds());
+    });
+    benchmark::report(name + ".hits" + std::to_string(hits.size()), 1e6*seconds, "us/event");
+}
+
+int main(int, const char* argv[])  {
+
+    const EcalHexReadout& hex = EcalHexReadout::getInstance();
+    std::mt19937 generator(1);
+
+    for (int nHits : {50, 200, 800}) {
+        std::vector<EcalHit> hits = makeHits(hex, nHits, 3, generator);
+        // the exhaustive search grows with the third power of the hits
+        if (nHits <= 200) run<TemplatedClusterFinder<MyClusterWeight>>("TemplatedClusterFinder.cluster", hex, hits);
+        run<IndexedClusterFinder<MyClusterWeight>>("IndexedClusterFinder.cluster", hex, hits);
+    }
+
+    return 0;
+}
@@ -0,0 +1,66 @@
+// LDMX
+#include "DetDescr/EcalHexReadout.h"
+#include "Framework/Benchmark.h"
+
+// STL
+#include <random>
+#include <vector>
+
+using ldmx::EcalHexReadout;
+
+/*
+ * Microbenchmark of the cell lookups of EcalHexReadout for random points
+ * inside the cells of all modules.
+ */
+int main(int, const char* argv[])  {
+
+    const EcalHexReadout& hex = EcalHexReadout::getInstance();
+    const int nModules = hex.getNModules();
+    const int nCells = hex.getNCellsPerModule();
+
+    std::mt19937 generator(1);
+    std::uniform_int_distribution<int> module(0, nModules - 1), cell(0, nCells - 1);
+    std::uniform_real_distribution<double> jitter(-1., 1.);
+
+    // points within 1 mm of the cell centers, so that all lookups succeed
+    const int nPoints = 100000;
+    std::vector<int> ids;
+    std::vector<double> points;
+    ids.reserve(nPoints);
+    points.reserve(2*nPoints);
+    for (int i = 0; i < nPoints; i++) {
+        int id = hex.combineID(cell(generator), module(generator));
+        const auto& center = hex.getCellCenterAbsolute(id);
+        ids.push_back(id);
+        points.push_back(center.first + jitter(generator));
+        points.push_back(center.second + jitter(generator));
+    }
+
+    double seconds = ldmx::benchmark::measure([&]() {
+        for (int i = 0; i < nPoints; i++) {
+            ldmx::benchmark::keep(hex.getCellModuleID(points[2*i], points[2*i + 1]));
+        }
+    });
+    ldmx::benchmark::report("EcalHexReadout.getCellModuleID", nPoints/seconds, "lookups/s");
+
+    seconds = ldmx::benchmark::measure([&]() {
+        for (int id : ids) ldmx::benchmark::keep(hex.getCellCenterAbsolute(id));
+    });
+    ldmx::benchmark::report("EcalHexReadout.getCellCenterAbsolute", nPoints/seconds, "lookups/s");
+
+    seconds = ldmx::benchmark::measure([&]() {
+        for (int id : ids) {
+            for (int neighbor : hex.getNN(id)) ldmx::benchmark::keep(neighbor);
+        }
+    });
+    ldmx::benchmark::report("EcalHexReadout.getNN", nPoints/seconds, "lookups/s");
+
+    seconds = ldmx::benchmark::measure([&]() {
+        for (int id : ids) {
+            for (int neighbor : hex.getNNN(id)) ldmx::benchmark::keep(neighbor);
+        }
+    });
+    ldmx::benchmark::report("EcalHexReadout.getNNN", nPoints/seconds, "lookups/s");
+
+    return 0;
+}
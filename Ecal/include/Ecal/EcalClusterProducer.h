@@ -30,6 +30,7 @@
 #include "Ecal/WorkingCluster.h"
 #include "Ecal/MyClusterWeight.h"
 #include "Ecal/TemplatedClusterFinder.h"
+#include "Ecal/IndexedClusterFinder.h"
 
 //----------//
 //    STL   //
@@ -55,10 +56,14 @@ namespace ldmx {
 
             virtual void produce(Event& event);
 
+            virtual bool isCloneSafe() const {
+                return true;
+            }
+
         private:
 
             TClonesArray* ecalClusters_{nullptr};
-            std::shared_ptr<EcalHexReadout> hexReadout_;
+            const EcalHexReadout* hexReadout_{nullptr};
             double seedThreshold_{0};
             double cutoff_{0};
             std::string digisPassName_;
@@ -0,0 +1,238 @@
+/*
+   IndexedClusterFinder -- TemplatedClusterFinder with a spatial index and a queue of merge candidates
+   */
+
+#ifndef ECAL_INDEXEDCLUSTERFINDER_H_
+#define ECAL_INDEXEDCLUSTERFINDER_H_
+
+#include "Ecal/WorkingCluster.h"
+
+#include <algorithm>
+#include <cmath>
+#include <limits>
+#include <map>
+#include <queue>
+#include <unordered_map>
+#include <vector>
+
+namespace ldmx {
+
+    namespace clustering {
+
+        /**
+         * Largest transverse centroid distance at which the weight can still be
+         * below the cutoff, if the weight class provides maxDistance(cutoff).
+         */
+        template <class WeightClass>
+        auto maxDistance(const WeightClass& wgt, double cutoff, int) -> decltype(wgt.maxDistance(cutoff)) {
+            return wgt.maxDistance(cutoff);
+        }
+
+        /** Without maxDistance every pair of clusters is a merge candidate. */
+        template <class WeightClass>
+        double maxDistance(const WeightClass&, double, long) {
+            return std::numeric_limits<double>::infinity();
+        }
+    }
+
+    /**
+     * @class IndexedClusterFinder
+     * @brief Drop-in replacement for TemplatedClusterFinder which avoids rescanning all pairs after each merge
+     *
+     * @note
+     * Pairs of clusters whose weight is below the cutoff are kept in a priority
+     * queue ordered like the scan of TemplatedClusterFinder, so the same pair is
+     * merged at each step and the clusters, weights and seed count are identical.
+     * After a merge only the pairs of the merged cluster are recomputed; the
+     * pairs of the absorbed one are dropped lazily when they reach the top.
+     *
+     * If the weight class provides <tt>double maxDistance(double cutoff) const</tt>,
+     * the candidate pairs are looked up in a transverse grid with that cell size
+     * instead of going over all clusters.
+     */
+    template <class WeightClass>
+    class IndexedClusterFinder {
+
+        public:
+
+            void add(const EcalHit* eh, const EcalHexReadout& hex, double zPos) {
+                clusters_.push_back(WorkingCluster(eh, hex, zPos));
+            }
+
+            static bool compClusters(const WorkingCluster& a, const WorkingCluster& b) {
+                return a.centroid().E() > b.centroid().E();
+            }
+
+            void cluster(double seed_threshold, double cutoff) {
+                int ncluster = clusters_.size();
+                double minwgt = cutoff;
+
+                std::sort(clusters_.begin(), clusters_.end(), compClusters);
+
+                // seeds come first after sorting, and only ever gain energy, while the
+                // other clusters can only be absorbed. So a pair can be merged if the
+                // cluster with the lower index is one of the initial seeds.
+                nInitialSeeds_ = 0;
+                while (nInitialSeeds_ < clusters_.size() && clusters_[nInitialSeeds_].centroid().E() >= seed_threshold) nInitialSeeds_++;
+                int nseeds = nInitialSeeds_;
+
+                cellSize_ = clustering::maxDistance(wgt_, cutoff, 0);
+                if (cellSize_ < 0) cellSize_ = 0;
+                // leave some margin for the rounding of the weight calculation
+                cellSize_ = cellSize_*1.01 + 1e-3;
+                useGrid_ = std::isfinite(cellSize_);
+
+                version_.assign(clusters_.size(), 0);
+                gridKey_.assign(clusters_.size(), 0);
+                grid_.clear();
+                queue_ = CandidateQueue();
+                for (size_t i = 0; i < clusters_.size(); i++) insertInGrid(i);
+                for (size_t i = 0; i < nInitialSeeds_; i++) pushCandidates(i, cutoff, true);
+
+                do {
+                    nseeds_ = nseeds;
+
+                    // drop pairs involving a cluster that changed since they were computed
+                    while (!queue_.empty() && !isCurrent(queue_.top())) queue_.pop();
+
+                    if (queue_.empty()) {
+                        // nothing left to merge: the lowest weight still has to be reported
+                        bool any = false;
+                        for (size_t i = 0; i < nInitialSeeds_; i++) {
+                            if (clusters_[i].empty()) continue;
+                            for (size_t j = i + 1; j < clusters_.size(); j++) {
+                                if (clusters_[j].empty()) continue;
+                                double wgt = wgt_(clusters_[i],clusters_[j]);
+                                if (!any || wgt < minwgt) {
+                                    any = true;
+                                    minwgt = wgt;
+                                }
+                            }
+                        }
+                        transitionWeights_.insert(std::pair<int, double>(ncluster, minwgt));
+                        break;
+                    }
+
+                    Candidate best = queue_.top();
+                    queue_.pop();
+                    minwgt = best.wgt;
+                    transitionWeights_.insert(std::pair<int, double>(ncluster, minwgt));
+
+                    size_t mi = best.i, mj = best.j;
+                    // put the bigger one in mi
+                    if (clusters_[mi].centroid().E() < clusters_[mj].centroid().E()) { std::swap(mi,mj); }
+                    removeFromGrid(mi);
+                    removeFromGrid(mj);
+                    clusters_[mi].add(clusters_[mj]);
+                    clusters_[mj].clear();
+                    version_[mi]++;
+                    version_[mj]++;
+                    if (mj < nInitialSeeds_) nseeds--;
+                    ncluster--;
+                    insertInGrid(mi);
+                    pushCandidates(mi, cutoff, false);
+
+                } while (minwgt < cutoff && ncluster > 1);
+                finalwgt_ = minwgt;
+            }
+
+            double getYMax() const { return finalwgt_; }
+
+            int getNSeeds() const { return nseeds_; }
+
+            std::map<int, double> getWeights() const { return transitionWeights_; }
+
+            const std::vector<WorkingCluster>& getClusters() const {
+                return clusters_;
+            }
+
+        private:
+
+            /** A pair of clusters which may be merged, i < j. */
+            struct Candidate {
+                double wgt;
+                size_t i;
+                size_t j;
+                unsigned versionI;
+                unsigned versionJ;
+            };
+
+            /** Orders the queue like the pair scan: lowest weight first, then lowest (i,j). */
+            struct CandidateOrder {
+                bool operator()(const Candidate& a, const Candidate& b) const {
+                    if (a.wgt != b.wgt) return a.wgt > b.wgt;
+                    if (a.i != b.i) return a.i > b.i;
+                    return a.j > b.j;
+                }
+            };
+
+            typedef std::priority_queue<Candidate, std::vector<Candidate>, CandidateOrder> CandidateQueue;
+
+            bool isCurrent(const Candidate& c) const {
+                return c.versionI == version_[c.i] && c.versionJ == version_[c.j]
+                    && !clusters_[c.i].empty() && !clusters_[c.j].empty();
+            }
+
+            long long key(int ix, int iy) const {
+                return (static_cast<long long>(ix) << 32) ^ static_cast<unsigned int>(iy);
+            }
+
+            void cellOf(size_t k, int& ix, int& iy) const {
+                if (!useGrid_) { ix = 0; iy = 0; return; }
+                ix = static_cast<int>(std::floor(clusters_[k].centroid().Px()/cellSize_));
+                iy = static_cast<int>(std::floor(clusters_[k].centroid().Py()/cellSize_));
+            }
+
+            void insertInGrid(size_t k) {
+                int ix, iy;
+                cellOf(k, ix, iy);
+                gridKey_[k] = key(ix, iy);
+                grid_[gridKey_[k]].push_back(k);
+            }
+
+            void removeFromGrid(size_t k) {
+                std::vector<size_t>& cell = grid_[gridKey_[k]];
+                cell.erase(std::find(cell.begin(), cell.end(), k));
+            }
+
+            /**
+             * Queue the pairs of cluster k with its neighbors in the grid.
+             * @param onlyLater Only pair with clusters after k, used to avoid
+             * queueing the initial pairs twice.
+             */
+            void pushCandidates(size_t k, double cutoff, bool onlyLater) {
+                int ix, iy;
+                cellOf(k, ix, iy);
+                int reach = useGrid_ ? 1 : 0;
+                for (int dx = -reach; dx <= reach; dx++) {
+                    for (int dy = -reach; dy <= reach; dy++) {
+                        auto cell = grid_.find(key(ix+dx, iy+dy));
+                        if (cell == grid_.end()) continue;
+                        for (size_t other : cell->second) {
+                            if (other == k || (onlyLater && other < k)) continue;
+                            size_t i = std::min(k, other), j = std::max(k, other);
+                            if (i >= nInitialSeeds_) continue;
+                            double wgt = wgt_(clusters_[i],clusters_[j]);
+                            if (wgt < cutoff) queue_.push(Candidate{wgt, i, j, version_[i], version_[j]});
+                        }
+                    }
+                }
+            }
+
+            WeightClass wgt_;
+            double finalwgt_;
+            int nseeds_;
+            std::map<int, double> transitionWeights_;
+            std::vector<WorkingCluster> clusters_;
+
+            size_t nInitialSeeds_{0};
+            double cellSize_{0};
+            bool useGrid_{false};
+            std::vector<unsigned> version_;
+            std::vector<long long> gridKey_;
+            std::unordered_map<long long, std::vector<size_t> > grid_;
+            CandidateQueue queue_;
+    };
+}
+
+#endif
@@ -13,7 +13,6 @@ namespace ldmx {
     
             double operator()(const WorkingCluster& a, const WorkingCluster& b) { // returns weighting function, where smallest weights will be combined first
 
-                double rmol = 10.00; //Moliere radius of detector, roughly. In mm
                 double dzchar = 100.0; //Characteristic cluster longitudinal variable TO BE DETERMINED! in mm
 
                 double aE = a.centroid().E();
@@ -38,7 +37,7 @@ namespace ldmx {
 
                 double dijT = pow(pow(aX-bX,2) + pow(aY-bY,2),0.5);
 
-                double weightT = exp(pow(dijT/rmol,2))-1;
+                double weightT = exp(pow(dijT/rmol_,2))-1;
                 double weightZ = (exp(abs(dijz)/dzchar)-1);
 
                 //Return the highest of the two weights
@@ -48,6 +47,19 @@ namespace ldmx {
                     return weightT;
                 }
             }
+
+            /**
+             * Largest transverse distance between two clusters for which the weight
+             * can be below the cutoff, since the weight is at least the transverse one.
+             */
+            double maxDistance(double cutoff) const {
+                if (cutoff <= 0) return 0;
+                return rmol_*sqrt(log(1+cutoff));
+            }
+
+        private:
+
+            double rmol_{10.00}; //Moliere radius of detector, roughly. In mm
     };
 }
 
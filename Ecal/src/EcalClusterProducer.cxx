@@ -19,7 +19,7 @@ namespace ldmx {
 
     void EcalClusterProducer::configure(const ParameterSet& ps) {
 
-        hexReadout_ = std::make_shared<EcalHexReadout>();
+        hexReadout_ = &EcalHexReadout::getInstance();
         cutoff_ = ps.getDouble("cutoff");
         seedThreshold_ = ps.getDouble("seedThreshold"); 
         digisPassName_ = ps.getString("digisPassName");
@@ -34,7 +34,7 @@ namespace ldmx {
 
         static const double layerZPos[] = {-137.2, -134.3, -127.95, -123.55, -115.7, -109.8, -100.7, -94.3, -85.2, -78.8, -69.7, -63.3, -54.2, -47.8, -38.7, -32.3, -23.2, -16.8, -7.7, -1.3, 7.8, 14.2, 23.3, 29.7, 42.3, 52.2, 64.8, 74.7, 87.3, 97.2, 109.8, 119.7, 132.3, 142.2};
 
-        TemplatedClusterFinder<MyClusterWeight> cf;
+        IndexedClusterFinder<MyClusterWeight> cf;
 
         TClonesArray* ecalDigiHits = (TClonesArray*) event.getCollection("ecalDigis", digisPassName_);
         int nEcalDigis = ecalDigiHits->GetEntries();
@@ -49,11 +49,11 @@ namespace ldmx {
             //Skip zero energy digis.
             if (aDigi->getEnergy() == 0) { continue; }
 
-            cf.add(aDigi, hexReadout_, layerZPos[aDigi->getLayer()]);
+            cf.add(aDigi, *hexReadout_, layerZPos[aDigi->getLayer()]);
         }
 
         cf.cluster(seedThreshold_, cutoff_);
-        std::vector<WorkingCluster> wcVec = cf.getClusters();
+        const std::vector<WorkingCluster>& wcVec = cf.getClusters();
     
         std::map<int, double> cWeights = cf.getWeights();
     
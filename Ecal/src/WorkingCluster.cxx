@@ -7,11 +7,11 @@
 
 namespace ldmx {
 
-    WorkingCluster::WorkingCluster(const EcalHit* eh, const std::shared_ptr<EcalHexReadout> hex, double zPos) {
+    WorkingCluster::WorkingCluster(const EcalHit* eh, const EcalHexReadout& hex, double zPos) {
         add(eh, hex, zPos);
     }
 
-    void WorkingCluster::add(const EcalHit* eh, const std::shared_ptr<EcalHexReadout> hex, double zPos) {
+    void WorkingCluster::add(const EcalHit* eh, const EcalHexReadout& hex, double zPos) {
     
         double hitE = eh->getEnergy();
         unsigned int hitID = eh->getID();
@@ -20,7 +20,7 @@ namespace ldmx {
         unsigned int moduleID = (hitID<<17)>>29;
         unsigned int combinedID = 10*cellID + moduleID;
 
-        std::pair<double, double> hitXY = hex->getCellCenterAbsolute(combinedID);
+        const XYCoords& hitXY = hex.getCellCenterAbsolute(combinedID);
     
         double newE = hitE + centroid_.E();
         double newCentroidX = (centroid_.Px()*centroid_.E() + hitE*hitXY.first) / newE;
@@ -46,7 +46,7 @@ namespace ldmx {
     
         centroid_.SetPxPyPzE(newCentroidX, newCentroidY, newCentroidZ, newE);
 
-        std::vector<const EcalHit*> clusterHits = wc.getHits();
+        const std::vector<const EcalHit*>& clusterHits = wc.getHits();
     
         for (size_t i = 0; i < clusterHits.size(); i++) {
     
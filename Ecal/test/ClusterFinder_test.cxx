@@ -0,0 +1,147 @@
+// LDMX
+#include "DetDescr/EcalDetectorID.h"
+#include "DetDescr/EcalHexReadout.h"
+#include "Ecal/IndexedClusterFinder.h"
+#include "Ecal/MyClusterWeight.h"
+#include "Ecal/TemplatedClusterFinder.h"
+#include "Event/EcalHit.h"
+
+// STL
+#include <algorithm>
+#include <cmath>
+#include <iostream>
+#include <random>
+#include <stdexcept>
+#include <string>
+#include <vector>
+
+using namespace ldmx;
+
+/*
+ * Make the hits of a random event with a few showers, like the digis
+ * seen by EcalClusterProducer.
+ */
+std::vector<EcalHit> makeHits(const EcalHexReadout& hex, int nHits, int nShowers, std::mt19937& generator) {
+    std::uniform_real_distribution<double> uniform(-1., 1.);
+    std::normal_distribution<double> spread(0., 15.);
+    std::exponential_distribution<double> energy(1.);
+    std::uniform_int_distribution<int> layer(0, 33);
+
+    std::vector<std::pair<double, double>> showers;
+    for (int i = 0; i < nShowers; i++) showers.emplace_back(100.*uniform(generator), 100.*uniform(generator));
+
+    EcalDetectorID detID;
+    std::vector<EcalHit> hits(nHits);
+    for (int i = 0; i < nHits; i++) {
+        const auto& shower = showers[i % nShowers];
+        int cellModuleID = -1;
+        while (cellModuleID < 0) {
+            try {
+                cellModuleID = hex.getCellModuleID(shower.first + spread(generator), shower.second + spread(generator));
+            } catch (const std::exception&) {
+                // outside of the modules, draw again
+            }
+        }
+        std::pair<int, int> ids = hex.separateID(cellModuleID);
+        detID.setFieldValue(1, layer(generator));
+        detID.setFieldValue(2, ids.second);
+        detID.setFieldValue(3, ids.first);
+        hits[i].setID(detID.pack());
+        hits[i].setEnergy(energy(generator));
+    }
+    return hits;
+}
+
+/*
+ * Run a cluster finder on the hits, with the layer positions used by EcalClusterProducer.
+ */
+template <class Finder>
+void runFinder(Finder& finder, const EcalHexReadout& hex, const std::vector<EcalHit>& hits, double seedThreshold, double cutoff) {
+    EcalDetectorID detID;
+    for (const EcalHit& hit : hits) {
+        detID.setRawValue(hit.getID());
+        detID.unpack();
+        finder.add(&hit, hex, -137.2 + 8.5*detID.getFieldValue(1));
+    }
+    finder.cluster(seedThreshold, cutoff);
+}
+
+bool close(double a, double b) {
+    return std::abs(a - b) <= 1e-9*std::max(1., std::max(std::abs(a), std::abs(b)));
+}
+
+/*
+ * Compare the clusters, seeds and transition weights of IndexedClusterFinder
+ * with the exhaustive search of TemplatedClusterFinder on random hit sets.
+ */
+int main(int, const char* argv[])  {
+
+    std::cout << "Hello ClusterFinder test!" << std::endl;
+
+    const EcalHexReadout& hex = EcalHexReadout::getInstance();
+    std::mt19937 generator(3);
+    std::uniform_int_distribution<int> nHits(1, 150);
+    std::uniform_int_distribution<int> nShowers(1, 4);
+
+    int nEvents = 0, nClusters = 0;
+    for (double cutoff : {2., 10., 50.}) {
+        for (int ievent = 0; ievent < 40; ievent++) {
+            std::vector<EcalHit> hits = makeHits(hex, nHits(generator), nShowers(generator), generator);
+            std::string event = "event " + std::to_string(ievent) + " with cutoff " + std::to_string(cutoff);
+
+            TemplatedClusterFinder<MyClusterWeight> reference;
+            runFinder(reference, hex, hits, 1.5, cutoff);
+            IndexedClusterFinder<MyClusterWeight> indexed;
+            runFinder(indexed, hex, hits, 1.5, cutoff);
+
+            if (indexed.getNSeeds() != reference.getNSeeds()) {
+                throw std::runtime_error("Different number of seeds in " + event);
+            }
+            if (!close(indexed.getYMax(), reference.getYMax())) {
+                throw std::runtime_error("Different final weight in " + event);
+            }
+            std::map<int, double> weights = indexed.getWeights(), referenceWeights = reference.getWeights();
+            if (weights.size() != referenceWeights.size()) {
+                throw std::runtime_error("Different number of transition weights in " + event);
+            }
+            for (const auto& weight : referenceWeights) {
+                if (!weights.count(weight.first) || !close(weights[weight.first], weight.second)) {
+                    throw std::runtime_error("Different transition weight for " + std::to_string(weight.first) + " clusters in " + event);
+                }
+            }
+
+            const std::vector<WorkingCluster>& clusters = indexed.getClusters();
+            const std::vector<WorkingCluster>& referenceClusters = reference.getClusters();
+            if (clusters.size() != referenceClusters.size()) {
+                throw std::runtime_error("Different number of clusters in " + event);
+            }
+            for (size_t i = 0; i < clusters.size(); i++) {
+                std::string cluster = "cluster " + std::to_string(i) + " of " + event;
+
+                // the same hits, in any order
+                std::vector<const EcalHit*> members = clusters[i].getHits(), referenceMembers = referenceClusters[i].getHits();
+                std::sort(members.begin(), members.end());
+                std::sort(referenceMembers.begin(), referenceMembers.end());
+                if (members != referenceMembers) {
+                    throw std::runtime_error("Different hits in " + cluster);
+                }
+                if (clusters[i].empty()) continue;
+                nClusters++;
+
+                const TLorentzVector& centroid = clusters[i].centroid();
+                const TLorentzVector& referenceCentroid = referenceClusters[i].centroid();
+                if (!close(centroid.E(), referenceCentroid.E())) {
+                    throw std::runtime_error("Different energy of " + cluster);
+                }
+                if (!close(centroid.Px(), referenceCentroid.Px()) || !close(centroid.Py(), referenceCentroid.Py())
+                        || !close(centroid.Pz(), referenceCentroid.Pz())) {
+                    throw std::runtime_error("Different centroid of " + cluster);
+                }
+            }
+            nEvents++;
+        }
+    }
+
+    std::cout << "Same " << nClusters << " clusters in " << nEvents << " events ... okay" << std::endl;
+    return 0;
+}
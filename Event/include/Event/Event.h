@@ -18,6 +18,7 @@
 // STL
 #include <string>
 #include <map>
+#include <utility>
 
 namespace ldmx {
 
@@ -28,6 +29,11 @@ namespace ldmx {
      * @note
      * A backing EventImpl object provides the actual data collections
      * via ROOT data structures (trees and branches).
+     *
+     * Objects and collections can be accessed by name, or by a token which
+     * a processor requests once with getToken(), typically in onProcessStart().
+     * The event resolves a token on its first use and then looks it up by
+     * index, so the name is not matched against the products again.
      */
     class Event {
 
@@ -72,6 +78,32 @@ namespace ldmx {
                 return getReal(name, passName, false) != 0;
             }
 
+            /**
+             * Check the existence of the object or collection of a token in the event.
+             * @param token The token of the object, from getToken().
+             * @return True if the object or collection exists in the event.
+             */
+            bool exists(int token) const {
+                return getReal(token, false) != 0;
+            }
+
+            /**
+             * Get the token of an object or collection.  The same name and pass
+             * always give the same token, which is valid for all events of the job.
+             * @param name Name (label, not class name) of the object.
+             * @param passName The pass name of the object, or empty to match the only object
+             * with this name in gets and the current pass in adds.
+             * @return The token.
+             */
+            static int getToken(const std::string& name, const std::string& passName = "");
+
+            /**
+             * Get the name and pass name from which a token was made.
+             * @param token The token.
+             * @return The name and the pass name of the token.
+             */
+            static std::pair<std::string, std::string> getTokenName(int token);
+
             /**
              * Get a list of the data products in the event
 	     */
@@ -110,6 +142,16 @@ namespace ldmx {
                 return (ObjectType) getReal(name, passName, true);
             }
 
+            /**
+             * Get the object of a token with a specific type.  If there is no
+             * object which matches, an exception will be thrown.
+             * @param token The token of the object, from getToken().
+             * @return The object from the event.
+             */
+            template<typename ObjectType> const ObjectType get(int token) const {
+                return (ObjectType) getReal(token, true);
+            }
+
             /**
              * Get a collection (TClonesArray) from the event without specifying
              * the pass name.  If there is one-and-only-one object with the
@@ -134,6 +176,16 @@ namespace ldmx {
                 return (TClonesArray*) getReal(collectionName, passName, true);
             }
 
+            /**
+             * Get the collection (TClonesArray) of a token from the event.  If there
+             * is no collection which matches, an exception will be thrown.
+             * @param token The token of the collection, from getToken().
+             * @return The TClonesArray from the event.
+             */
+            const TClonesArray* getCollection(int token) const {
+                return (TClonesArray*) getReal(token, true);
+            }
+
             /**
              * Add a collection (TClonesArray) of objects to the event.
              * The current pass name will be used for the collection.
@@ -150,6 +202,22 @@ namespace ldmx {
              */
             virtual void add(const std::string& name, TObject* obj) = 0;
 
+            /**
+             * Add the collection (TClonesArray) of a token to the event.
+             * The token must have an empty pass name or the current one.
+             * @param token The token of the collection, from getToken().
+             * @param clones The TClonesArray containing the objects.
+             */
+            virtual void add(int token, TClonesArray* clones) = 0;
+
+            /**
+             * Add the object of a token to the event.
+             * The token must have an empty pass name or the current one.
+             * @param token The token of the object, from getToken().
+             * @param obj The object to add.
+             */
+            virtual void add(int token, TObject* obj) = 0;
+
             /**
              * Add the given object to the named TClonesArray collection
              * Objects can only be added to a TClonesArray during the current pass -- TClonesArrays loaded
@@ -160,6 +228,31 @@ namespace ldmx {
              */
             virtual void addToCollection(const std::string& name, const TObject& obj) = 0;
 
+            /**
+             * Get an object of the current pass to fill in place, instead of
+             * filling a separate object and copying it into the event with add().
+             * The object is created and owned by the event and is cleared
+             * before it is returned.
+             * @param name The name of the object.
+             * @return The object stored in the event.
+             */
+            template<typename ObjectType> ObjectType& emplace(const std::string& name) {
+                return *static_cast<ObjectType*>(emplaceReal(name, ObjectType::Class()));
+            }
+
+            /**
+             * Append a new object to the named TClonesArray collection of the
+             * current pass and return it to be filled in place, instead of
+             * copying an object into the collection with addToCollection().
+             * The objects of the collection are owned by the event and are
+             * cleared at the end of each event.
+             * @param name Name of the collection.
+             * @return The new object in the collection.
+             */
+            template<typename ObjectType> ObjectType& emplaceToCollection(const std::string& name) {
+                return *static_cast<ObjectType*>(emplaceToCollectionReal(name, ObjectType::Class()));
+            }
+
         protected:
 
             /**
@@ -171,6 +264,29 @@ namespace ldmx {
              */
             virtual const TObject* getReal(const std::string& itemName, const std::string& passName, bool mustExist) const = 0;
 
+            /**
+             * Actual get implementation by token, provided by derived class.
+             * @param token The token of the object or TClonesArray.
+             * @param mustExist Determines if an exception should be thrown if the object does not exist.
+             */
+            virtual const TObject* getReal(int token, bool mustExist) const = 0;
+
+            /**
+             * Actual emplace implementation, provided by derived class.
+             * @param name The name of the object.
+             * @param type The class of the object.
+             * @return The cleared object stored in the event.
+             */
+            virtual TObject* emplaceReal(const std::string& name, TClass* type) = 0;
+
+            /**
+             * Actual emplaceToCollection implementation, provided by derived class.
+             * @param name The name of the collection.
+             * @param type The class of the objects in the collection.
+             * @return The new object in the collection.
+             */
+            virtual TObject* emplaceToCollectionReal(const std::string& name, TClass* type) = 0;
+
     };
 }
 
@@ -123,6 +123,26 @@ namespace ldmx {
                 stringParameters_[name] = value;
             }
 
+            /**
+             * Get the roots of the random number seeds of the processing
+             * passes which have been run over the events of this run.
+             *
+             * @return The seed roots by pass name.
+             */
+            const std::map<std::string, int>& getRandomSeedRoots() const {
+                return randomSeedRoots_;
+            }
+
+            /**
+             * Record the root of the random number seeds of a processing pass.
+             *
+             * @param passName The name of the processing pass.
+             * @param seedRoot The seed root.
+             */
+            void setRandomSeedRoot(const std::string& passName, int seedRoot) {
+                randomSeedRoots_[passName] = seedRoot;
+            }
+
             /** Print a string desciption of this object. */
             void Print(Option_t *option = "") const;
 
@@ -159,7 +179,10 @@ namespace ldmx {
             /** Map of string parameters. */
             std::map<std::string, std::string> stringParameters_;
 
-            ClassDef(RunHeader, 2);
+            /** Map of the random number seed roots of the processing passes. */
+            std::map<std::string, int> randomSeedRoots_;
+
+            ClassDef(RunHeader, 3);
 
     }; // RunHeader
 
@@ -8,6 +8,7 @@
 #define EVENT_SIMCALORIMETERHIT_H_
 
 // ROOT
+#include "TClonesArray.h"
 #include "TObject.h"
 #include "TRefArray.h"
 
@@ -28,6 +29,16 @@ namespace ldmx {
      * to the relevant SimParticle, the PDG code of the actual particle which deposited
      * energy (may be different from the actual SimParticle), the time of the contribution
      * and the energy deposition.
+     *
+     * @par
+     * The SimParticle of a contribution is stored either as a reference in a TRefArray,
+     * or as its index in the SimParticle collection of the event when the contribution
+     * is added with addIndexedContrib().  The indices are plain integer columns, which are
+     * smaller on disk and faster to write and read than references, which are resolved
+     * through the TProcessID table.  Both layouts are read with getContrib(), which needs
+     * the SimParticle collection of the event to find the particles from their indices.
+     * A hit only has contributions of one layout, which is recorded with the
+     * first contribution, so adding one of the other layout throws an exception.
      */
     class SimCalorimeterHit: public TObject {
 
@@ -39,6 +50,7 @@ namespace ldmx {
              */
             struct Contrib {
                 SimParticle* particle{nullptr};
+                int particleIndex{-1};
                 int pdgCode{0};
                 float edep{0};
                 float time{0};
@@ -146,21 +158,46 @@ namespace ldmx {
              * @param pdgCode The PDG code of the actual track.
              * @param edep The energy deposition of the hit [MeV].
              * @param time The time of the hit [ns].
+             * @throw std::logic_error if the hit has indexed contributions.
              */
             void addContrib(SimParticle* simParticle, int pdgCode, float edep, float time);
 
+            /**
+             * Add a hit contribution from a SimParticle given by its index in the
+             * SimParticle collection of the event.
+             * @param simParticleIndex The index of the particle that made the contribution.
+             * @param pdgCode The PDG code of the actual track.
+             * @param edep The energy deposition of the hit [MeV].
+             * @param time The time of the hit [ns].
+             * @throw std::logic_error if the hit has contributions with references.
+             */
+            void addIndexedContrib(int simParticleIndex, int pdgCode, float edep, float time);
+
+            /**
+             * Check if the contributions store indices of SimParticles instead of references.
+             * @return True if the contributions store indices of SimParticles.
+             */
+            bool hasIndexedContribs() const {
+                return indexedContribs_;
+            }
+
             /**
              * Get a hit contribution by index.
              * @param i The index of the hit contribution.
+             * @param simParticles The SimParticle collection of the event, which is used
+             * to find the particle of indexed contributions.
              * @return The hit contribution at the index.
+             * @note The particle of an indexed contribution is null if no collection is
+             * given, but its index in the collection is set.
              */
-            Contrib getContrib(int i);
+            Contrib getContrib(int i, const TClonesArray* simParticles = nullptr);
 
             /**
              * Find the index of a hit contribution from a SimParticle and PDG code.
              * @param simParticle The sim particle that made the contribution.
              * @param pdgCode The PDG code of the contribution.
              * @return The index of the contribution or -1 if none exists.
+             * @note Only contributions stored with references are searched.
              */
             int findContribIndex(SimParticle* simParticle, int pdgCode);
 
@@ -210,6 +247,11 @@ namespace ldmx {
              */
             TRefArray* simParticleContribs_;
 
+            /**
+             * The list of indices in the SimParticle collection contributing to the hit.
+             */
+            std::vector<int> simParticleIndexContribs_;
+
             /**
              * The list of PDG codes contributing to the hit.
              */
@@ -230,10 +272,15 @@ namespace ldmx {
              */
             unsigned nContribs_{0};
 
+            /**
+             * True if the contributions store indices of SimParticles instead of references.
+             */
+            bool indexedContribs_{false};
+
             /**
              * ROOT class definition.
              */
-            ClassDef(SimCalorimeterHit, 2)
+            ClassDef(SimCalorimeterHit, 4)
     };
 
 }
@@ -1,9 +1,44 @@
 #include "Event/Event.h"
 #include <sys/types.h>
 #include <regex.h>
+#include <mutex>
+#include <stdexcept>
 
 namespace ldmx {
 
+  /** The names of the tokens, shared by all events of the job. */
+  struct TokenRegistry {
+    std::mutex mutex_;
+    std::map<std::pair<std::string, std::string>, int> tokens_;
+    std::vector<std::pair<std::string, std::string> > names_;
+  };
+
+  static TokenRegistry& getTokenRegistry() {
+    static TokenRegistry registry;
+    return registry;
+  }
+
+  int Event::getToken(const std::string& name, const std::string& passName) {
+    TokenRegistry& registry = getTokenRegistry();
+    std::lock_guard<std::mutex> lock(registry.mutex_);
+    auto key = std::make_pair(name, passName);
+    auto it = registry.tokens_.find(key);
+    if (it != registry.tokens_.end()) return it->second;
+    int token = registry.names_.size();
+    registry.tokens_[key] = token;
+    registry.names_.push_back(key);
+    return token;
+  }
+
+  std::pair<std::string, std::string> Event::getTokenName(int token) {
+    TokenRegistry& registry = getTokenRegistry();
+    std::lock_guard<std::mutex> lock(registry.mutex_);
+    if (token < 0 || token >= int(registry.names_.size())) {
+      throw std::out_of_range("Event token " + std::to_string(token) + " was not made by Event::getToken");
+    }
+    return registry.names_[token];
+  }
+
   std::vector<ProductTag> Event::searchProducts(const std::string& namematch, const std::string& passmatch, const std::string& typematch) const {
     std::vector<ProductTag> retval;
 
@@ -41,6 +41,11 @@ namespace ldmx {
             std::cout << "    " << entry.first
                     << " = " << entry.second << std::endl;
         }
+        std::cout << "  randomSeedRoots: " << std::endl;
+        for (auto entry : randomSeedRoots_) {
+            std::cout << "    " << entry.first
+                    << " = " << entry.second << std::endl;
+        }
         std::cout << "}" << std::endl;
     }
 
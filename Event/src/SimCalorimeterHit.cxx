@@ -2,6 +2,7 @@
 
 // STL
 #include <iostream>
+#include <stdexcept>
 
 ClassImp(ldmx::SimCalorimeterHit)
 
@@ -22,11 +23,13 @@ namespace ldmx {
         TObject::Clear();
 
         simParticleContribs_->Delete();
+        simParticleIndexContribs_.clear();
         pdgCodeContribs_.clear();
         edepContribs_.clear();
         timeContribs_.clear();
 
         nContribs_ = 0;
+        indexedContribs_ = false;
         id_ = 0;
         edep_ = 0;
         x_ = 0;
@@ -41,6 +44,9 @@ namespace ldmx {
     }
 
     void SimCalorimeterHit::addContrib(SimParticle* simParticle, int pdgCode, float edep, float time) {
+        if (indexedContribs_) {
+            throw std::logic_error("Can not add a SimParticle reference to a hit with indexed contributions");
+        }
         simParticleContribs_->Add(simParticle);
         pdgCodeContribs_.push_back(pdgCode);
         edepContribs_.push_back(edep);
@@ -52,9 +58,32 @@ namespace ldmx {
         ++nContribs_;
     }
 
-    SimCalorimeterHit::Contrib SimCalorimeterHit::getContrib(int i) {
+    void SimCalorimeterHit::addIndexedContrib(int simParticleIndex, int pdgCode, float edep, float time) {
+        if (nContribs_ > 0 && !indexedContribs_) {
+            throw std::logic_error("Can not add a SimParticle index to a hit with referenced contributions");
+        }
+        indexedContribs_ = true;
+        simParticleIndexContribs_.push_back(simParticleIndex);
+        pdgCodeContribs_.push_back(pdgCode);
+        edepContribs_.push_back(edep);
+        timeContribs_.push_back(time);
+        edep_ += edep;
+        if (time < time_ || time_ == 0) {
+            time_ = time;
+        }
+        ++nContribs_;
+    }
+
+    SimCalorimeterHit::Contrib SimCalorimeterHit::getContrib(int i, const TClonesArray* simParticles) {
         Contrib contrib;
-        contrib.particle = (SimParticle*) simParticleContribs_->At(i);
+        if (hasIndexedContribs()) {
+            contrib.particleIndex = simParticleIndexContribs_[i];
+            if (simParticles && contrib.particleIndex >= 0) {
+                contrib.particle = (SimParticle*) simParticles->At(contrib.particleIndex);
+            }
+        } else {
+            contrib.particle = (SimParticle*) simParticleContribs_->At(i);
+        }
         contrib.edep = edepContribs_[i];
         contrib.time = timeContribs_[i];
         contrib.pdgCode = pdgCodeContribs_[i];
@@ -64,8 +93,8 @@ namespace ldmx {
     int SimCalorimeterHit::findContribIndex(SimParticle* simParticle, int pdgCode) {
         int contribIndex = -1;
         for (int iContrib = 0; iContrib < nContribs_; iContrib++) {
-            Contrib contrib = getContrib(iContrib);
-            if (contrib.particle == simParticle && contrib.pdgCode == pdgCode) {
+            // compare the PDG codes first to resolve fewer references
+            if (pdgCodeContribs_[iContrib] == pdgCode && simParticleContribs_->At(iContrib) == simParticle) {
                 contribIndex = iContrib;
                 break;
             }
@@ -0,0 +1,119 @@
+// LDMX
+#include "Event/EventConstants.h"
+#include "Event/SimCalorimeterHit.h"
+#include "Event/SimParticle.h"
+
+// ROOT
+#include "TClonesArray.h"
+#include "TFile.h"
+#include "TTree.h"
+
+// STL
+#include <iostream>
+#include <stdexcept>
+#include <string>
+
+using namespace ldmx;
+
+/*
+ * Write hits with contributions stored as SimParticle indices, read them back
+ * and check that getContrib() finds the particles in the SimParticle collection
+ * of the same event.  Also check that a hit does not take contributions of both
+ * layouts.
+ */
+int main(int, const char* argv[])  {
+
+    std::cout << "Hello SimCalorimeterHit test!" << std::endl;
+
+    SimCalorimeterHit mixed;
+    mixed.addIndexedContrib(0, 11, 1., 1.);
+    bool thrown = false;
+    try {
+        mixed.addContrib(nullptr, 11, 1., 1.);
+    } catch (const std::logic_error&) {
+        thrown = true;
+    }
+    if (!thrown) throw std::runtime_error("Added a referenced contribution to a hit with indexed contributions");
+
+    mixed.Clear();
+    mixed.addContrib(nullptr, 11, 1., 1.);
+    thrown = false;
+    try {
+        mixed.addIndexedContrib(0, 11, 1., 1.);
+    } catch (const std::logic_error&) {
+        thrown = true;
+    }
+    if (!thrown) throw std::runtime_error("Added an indexed contribution to a hit with referenced contributions");
+
+    const int nEvents = 50;
+    {
+        TFile file("simcalorimeterhit_test.root", "RECREATE");
+        TTree tree("LDMX_Events", "LDMX Events");
+        TClonesArray* particles = new TClonesArray(EventConstants::SIM_PARTICLE.c_str(), 50);
+        TClonesArray* hits = new TClonesArray(EventConstants::SIM_CALORIMETER_HIT.c_str(), 50);
+        tree.Branch("SimParticles_sim", &particles, 100000, 3);
+        tree.Branch("EcalSimHits_sim", &hits, 100000, 3);
+        for (int ievent = 0; ievent < nEvents; ievent++) {
+            particles->Clear("C");
+            hits->Clear("C");
+            int nParticles = 1 + ievent % 7;
+            for (int i = 0; i < nParticles; i++) {
+                static_cast<SimParticle*>(particles->ConstructedAt(i))->setTrackID(100*ievent + i);
+            }
+            // hit i has contributions from the particles i and i + 1, with an empty hit at the end
+            for (int i = 0; i <= nParticles; i++) {
+                SimCalorimeterHit* hit = static_cast<SimCalorimeterHit*>(hits->ConstructedAt(i));
+                hit->setID(i);
+                for (int j = i; j < nParticles && j <= i + 1; j++) {
+                    hit->addIndexedContrib(j, 11, 0.5, j);
+                }
+            }
+            tree.Fill();
+        }
+        tree.Write();
+        file.Close();
+        delete particles;
+        delete hits;
+    }
+
+    TFile file("simcalorimeterhit_test.root");
+    TTree* tree = static_cast<TTree*>(file.Get("LDMX_Events"));
+    TClonesArray* particles = nullptr;
+    TClonesArray* hits = nullptr;
+    tree->SetBranchAddress("SimParticles_sim", &particles);
+    tree->SetBranchAddress("EcalSimHits_sim", &hits);
+    if (tree->GetEntries() != nEvents) {
+        throw std::runtime_error("Expected " + std::to_string(nEvents) + " events, got " + std::to_string(tree->GetEntries()));
+    }
+
+    int nContribs = 0;
+    for (int ievent = 0; ievent < nEvents; ievent++) {
+        tree->GetEntry(ievent);
+        std::string event = " in event " + std::to_string(ievent);
+        int nParticles = particles->GetEntriesFast();
+        if (nParticles != 1 + ievent % 7 || hits->GetEntriesFast() != nParticles + 1) {
+            throw std::runtime_error("Wrong number of particles or hits" + event);
+        }
+        for (int i = 0; i < hits->GetEntriesFast(); i++) {
+            SimCalorimeterHit* hit = static_cast<SimCalorimeterHit*>(hits->At(i));
+            std::string name = "hit " + std::to_string(i) + event;
+            if (hit->getNumberOfContribs() > 0 && !hit->hasIndexedContribs()) {
+                throw std::runtime_error("Layout of the contributions of " + name + " was not read back");
+            }
+            for (unsigned j = 0; j < hit->getNumberOfContribs(); j++) {
+                SimCalorimeterHit::Contrib contrib = hit->getContrib(j, particles);
+                int index = i + j;
+                if (contrib.particleIndex != index || contrib.particle != particles->At(index)
+                        || contrib.particle->getTrackID() != 100*ievent + index || contrib.time != index) {
+                    throw std::runtime_error("Wrong particle of contribution " + std::to_string(j) + " of " + name);
+                }
+                nContribs++;
+            }
+        }
+    }
+
+    std::cout << "Read back " << nContribs << " indexed contributions ... okay" << std::endl;
+
+    file.Close();
+    return 0;
+}
@@ -0,0 +1,120 @@
+// LDMX
+#include "DetDescr/EcalDetectorID.h"
+#include "DetDescr/EcalHexReadout.h"
+#include "Event/EcalHit.h"
+#include "Event/EventConstants.h"
+#include "EventProc/EcalVetoProcessor.h"
+#include "Framework/Benchmark.h"
+#include "Framework/EventImpl.h"
+#include "Framework/ParameterSet.h"
+#include "Framework/Process.h"
+
+// ROOT
+#include "TClonesArray.h"
+
+// STL
+#include <algorithm>
+#include <chrono>
+#include <cstdio>
+#include <fstream>
+#include <random>
+#include <stdexcept>
+#include <string>
+#include <vector>
+
+using namespace ldmx;
+
+/*
+ * Benchmark of the computation of the ECal veto features on synthetic events,
+ * with the digis of an electromagnetic shower and of uniform noise.
+ */
+int main(int, const char* argv[])  {
+
+    const EcalHexReadout& hex = EcalHexReadout::getInstance();
+    const int nLayers = 34;
+
+    // the fiducial check needs the cell centers, sorted by x
+    std::vector<std::pair<double, double>> centers;
+    for (int module = 0; module < hex.getNModules(); module++) {
+        for (int cell = 0; cell < hex.getNCellsPerModule(); cell++) {
+            centers.push_back(hex.getCellCenterAbsolute(hex.combineID(cell, module)));
+        }
+    }
+    std::sort(centers.begin(), centers.end());
+    std::string cellFile = "EcalVetoProcessor_bench_cellxy.txt";
+    {
+        std::ofstream out(cellFile);
+        for (const auto& center : centers) out << center.first << " " << center.second << "\n";
+    }
+
+    Process process("bench");
+    EcalVetoProcessor veto("ecalVeto", process);
+    ParameterSet parameters;
+    parameters.insert("do_bdt", 0);
+    parameters.insert("cellxy_file", cellFile);
+    parameters.insert("num_ecal_layers", nLayers);
+    parameters.insert("disc_cut", 0.99);
+    parameters.insert("collection_name", std::string("EcalVeto"));
+    veto.configure(parameters);
+    veto.onProcessStart();
+    std::remove(cellFile.c_str());
+
+    // synthetic events with a shower along z from a random point and some noise hits
+    std::mt19937 generator(1);
+    std::uniform_real_distribution<double> uniform(-1., 1.);
+    std::exponential_distribution<double> energy(1.);
+    const int nEvents = 100;
+    const int nShowerHits = 400;
+    const int nNoiseHits = 100;
+    EcalDetectorID detID;
+    std::vector<std::vector<std::pair<int, float>>> events(nEvents);
+    for (auto& hits : events) {
+        double x0 = 100.*uniform(generator), y0 = 100.*uniform(generator);
+        for (int i = 0; i < nShowerHits + nNoiseHits; i++) {
+            int layer = static_cast<int>((nLayers - 1)*(0.5 + 0.5*uniform(generator)));
+            double width = i < nShowerHits ? 5. + 0.5*layer : 200.;
+            int cellModuleID = -1;
+            while (cellModuleID < 0) {
+                try {
+                    cellModuleID = hex.getCellModuleID(x0 + width*uniform(generator), y0 + width*uniform(generator));
+                } catch (const std::exception&) {
+                    // outside of the modules, draw again
+                }
+            }
+            std::pair<int, int> ids = hex.separateID(cellModuleID);
+            detID.setFieldValue(1, layer);
+            detID.setFieldValue(2, ids.second);
+            detID.setFieldValue(3, ids.first);
+            hits.emplace_back(detID.pack(), i < nShowerHits ? 10.*energy(generator) : 0.5*energy(generator));
+        }
+    }
+
+    EventImpl event("bench");
+    TClonesArray* digis = new TClonesArray(EventConstants::ECAL_HIT.c_str(), 1000);
+
+    // only the veto itself is timed, not the filling of the digis
+    double seconds = 0;
+    long nProcessed = 0;
+    for (double minimumTime = benchmark::getMinimumTime(); seconds < minimumTime; ) {
+        for (const auto& hits : events) {
+            for (size_t i = 0; i < hits.size(); i++) {
+                EcalHit* hit = static_cast<EcalHit*>(digis->ConstructedAt(i));
+                hit->setID(hits[i].first);
+                hit->setEnergy(hits[i].second);
+            }
+            event.add("ecalDigis", digis);
+            process.getStorageController().resetEventState();
+
+            auto start = std::chrono::steady_clock::now();
+            veto.produce(event);
+            seconds += std::chrono::duration<double>(std::chrono::steady_clock::now() - start).count();
+
+            event.Clear();
+            nProcessed++;
+        }
+    }
+    benchmark::report("EcalVetoProcessor.produce.hits" + std::to_string(nShowerHits + nNoiseHits), nProcessed/seconds, "events/s");
+
+    delete digis;
+    return 0;
+}
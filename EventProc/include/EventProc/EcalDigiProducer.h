@@ -11,13 +11,12 @@
 //----------------//
 //   C++ StdLib   //
 //----------------//
-#include <time.h>
 #include <memory> //for smart pointers
+#include <vector>
 
 //----------//
 //   ROOT   //
 //----------//
-#include "TRandom3.h"
 #include "TClonesArray.h"
 
 //----------//
@@ -75,6 +74,16 @@ namespace ldmx {
                 return (std::make_pair(layer, cellid));
             }
 
+            /**
+             * Get the channel index used for the noise hits of a cell.
+             * @return The index or -1 if the cell is outside of the readout.
+             */
+            int getChannel(int layer, int module, int cell) const {
+                if (layer < 0 || layer >= NUM_ECAL_LAYERS || module < 0 || module >= HEX_MODULES_PER_LAYER
+                        || cell < 0 || cell >= CELLS_PER_HEX_MODULE) return -1;
+                return (layer*HEX_MODULES_PER_LAYER + module)*CELLS_PER_HEX_MODULE + cell;
+            }
+
         private:
 
             /** Electrons per MIP. */
@@ -96,13 +105,15 @@ namespace ldmx {
             static const int TOTAL_CELLS{NUM_ECAL_LAYERS*HEX_MODULES_PER_LAYER*CELLS_PER_HEX_MODULE};
 
 
-            std::unique_ptr<TRandom3> noiseInjector_;
             TClonesArray* ecalDigis_{nullptr};
             EcalDetectorID detID_;
-            std::unique_ptr<EcalHexReadout> hexReadout_;
+            const EcalHexReadout* hexReadout_{nullptr};
           
             /** Generator of noise hits. */ 
             std::unique_ptr<NoiseGenerator> noiseGenerator_; 
+
+            /** Channels with a simulated hit in the current event. */
+            std::vector<int> occupiedChannels_;
            
             /** Set the noise (in electrons) when the capacitance is 0. */
             double noiseIntercept_{900.};
@@ -18,6 +18,7 @@
 #include "Event/EcalVetoResult.h"
 #include "Event/SimTrackerHit.h"
 #include "Framework/EventProcessor.h"
+#include "Tools/BoostedTreeEvaluator.h"
 
 //C++
 #include <map>
@@ -41,7 +42,7 @@ namespace ldmx {
             virtual ~BDTHelper() {
             }
 
-            void buildFeatureVector(std::vector<float>& bdtFeatures,
+            static void buildFeatureVector(std::vector<float>& bdtFeatures,
                     ldmx::EcalVetoResult& result);
 
             float getSinglePred(std::vector<float> bdtFeatures);
@@ -76,6 +77,12 @@ namespace ldmx {
 
             void produce(Event& event);
 
+            /** Request the tokens of the collections read in each event. */
+            void onProcessStart();
+
+            /** Print the summary of the BDT validation, if enabled. */
+            void onProcessEnd();
+
         private:
 
             /** Wrappers for ecalHexReadout functions. See hitToPair().
@@ -88,13 +95,13 @@ namespace ldmx {
             bool isInShowerOuterRing(int centroidID, int probeID){
                 return hexReadout_->isNNN(centroidID, probeID);
             }
-            XYCoords getCellCentroidXYPair(int centroidID){
+            const XYCoords& getCellCentroidXYPair(int centroidID){
                 return hexReadout_->getCellCenterAbsolute(centroidID);
             }
-            std::vector<int> getInnerRingCellIds(int cellModuleID){
+            CellIDSpan getInnerRingCellIds(int cellModuleID){
                 return hexReadout_->getNN(cellModuleID);
             }
-            std::vector<int> getOuterRingCellIds(int cellModuleID){
+            CellIDSpan getOuterRingCellIds(int cellModuleID){
                 return hexReadout_->getNNN(cellModuleID);
             }
 
@@ -149,20 +156,46 @@ namespace ldmx {
         
             double bdtCutVal_{0};
 
-            EcalVetoResult result_;
             EcalDetectorID detID_;
             bool verbose_{false};
             bool doesPassVeto_{false};
 
-            std::unique_ptr<EcalHexReadout> hexReadout_;
+            const EcalHexReadout* hexReadout_{nullptr};
 
             std::string bdtFileName_;
             std::string cellFileNamexy_;
             std::unique_ptr<BDTHelper> BDTHelper_;
             std::vector<float> bdtFeatures_;
 
+            /** Text dump of the xgboost model used by the native evaluator. */
+            std::string bdtModelFileName_;
+
+            /** Native BDT evaluator, used instead of python when a model dump is given. */
+            std::unique_ptr<BoostedTreeEvaluator> bdtEvaluator_;
+
+            /** Compare the native BDT score to the python one for every event. */
+            bool validateBdt_{false};
+
+            /** Largest allowed difference between the native and python scores. */
+            double bdtValidationTolerance_{1e-5};
+
+            /** Number of events compared during validation. */
+            int nBdtValidated_{0};
+
+            /** Number of events with scores differing by more than the tolerance. */
+            int nBdtMismatches_{0};
+
+            /** Largest difference between the native and python scores. */
+            double maxBdtDifference_{0};
+
             /** Name of the collection which will containt the results. */
-            std::string collectionName_{"EcalVeto"}; 
+            std::string collectionName_{"EcalVeto"};
+
+            /** Tokens of the collections read in each event. */
+            int ecalDigisToken_{-1};
+            int ecalSpHitsToken_{-1};
+            int targetSpHitsToken_{-1};
+            int simParticlesToken_{-1}; 
 
     };
 
@@ -8,11 +8,12 @@
 #define EVENTPROC_HCALDIGIPRODUCER_H_
 
 // C++/STL
-#include <time.h>
+#include <memory>
+#include <unordered_map>
+#include <vector>
 
 // ROOT
 #include "TString.h"
-#include "TRandom3.h"
 
 // LDMX
 #include "DetDescr/DetectorID.h"
@@ -21,6 +22,7 @@
 #include "Event/HcalHit.h"
 #include "Event/SimCalorimeterHit.h"
 #include "Framework/EventProcessor.h"
+#include "Tools/ChannelSampler.h"
 #include "Tools/NoiseGenerator.h"
 
 namespace ldmx {
@@ -28,6 +30,13 @@ namespace ldmx {
     /**
      * @class HcalDigiProducer
      * @brief Performs digitization of simulated HCal data
+     *
+     * @note
+     * The channels of the configured layout are numbered densely, the back
+     * HCal first, then the top/bottom and the left/right side HCal, each by
+     * section, layer and strip.  The energy deposits of an event are summed
+     * in flat per-channel buffers which only hold the channels with a
+     * deposit, so the cost of the digitization scales with the occupancy.
      */
     class HcalDigiProducer : public Producer {
 
@@ -41,26 +50,94 @@ namespace ldmx {
 
             virtual ~HcalDigiProducer() {
                 delete hits_;
-                if (random_)
-                    delete random_;
             }
 
             virtual void configure(const ParameterSet&);
 
             virtual void produce(Event& event);
 
-            unsigned int generateRandomID(HcalSection sec);
-
         private:
 
+            /**
+             * Channels of one part of the HCal, which has the same number
+             * of layers and strips in each of its sections.
+             */
+            struct ChannelGroup {
+
+                /** The first section of the group. */
+                int firstSection{0};
+
+                /** The number of sections in the group. */
+                int nSections{0};
+
+                /** The number of layers in each section. */
+                int nLayers{0};
+
+                /** The number of (super) strips in each layer. */
+                int nStrips{0};
+
+                /** Index of the first channel of the group. */
+                int firstChannel{0};
+
+                /**
+                 * Sampler for the channels of noise hits, by index within the
+                 * group.  The back HCal has two entries per channel, one for
+                 * each readout end.
+                 */
+                ChannelSampler sampler;
+            };
+
+            /**
+             * Get the dense index of a channel.
+             * @return The index or -1 if the channel is outside of the configured layout.
+             */
+            int getChannelIndex(int section, int layer, int strip) const;
+
+            /**
+             * Get the channel group which contains a section.
+             * @return The index of the group or -1 if the section is not known.
+             */
+            static int getChannelGroup(int section);
+
+            /**
+             * Get the buffer slot of a channel, adding the channel to the buffers if needed.
+             * @param rawID The raw ID of the channel.
+             * @param channel The dense index of the channel or -1 if it is outside of the layout.
+             * @return The slot in the per-channel buffers.
+             */
+            int getSlot(unsigned int rawID, int channel);
+
             TClonesArray* hits_{nullptr};
-            TRandom3* random_{new TRandom3(time(nullptr))};
             std::map<layer, zboundaries> hcalLayers_;
             bool verbose_{false};
-            DetectorID* detID_{nullptr};
-            
+            HcalID detID_;
+
             /** Generator for simulating noise hits. */
-            NoiseGenerator* noiseGenerator_;
+            std::unique_ptr<NoiseGenerator> noiseGenerator_;
+
+            /** The back, top/bottom and left/right channel groups. */
+            ChannelGroup channelGroups_[3];
+
+            /** Raw ID of each channel in the layout. */
+            std::vector<unsigned int> channelIDs_;
+
+            /** Buffer slot of each channel in the layout, -1 if the channel has no energy deposit. */
+            std::vector<int> channelSlots_;
+
+            /** Buffer slots of the channels outside of the layout, by raw ID. */
+            std::unordered_map<unsigned int, int> overflowSlots_;
+
+            /** Raw ID of the channel in each buffer slot. */
+            std::vector<unsigned int> slotIDs_;
+
+            /** Dense index of the channel in each buffer slot, -1 if it is outside of the layout. */
+            std::vector<int> slotChannels_;
+
+            /** Energy deposit and energy weighted time and position sums of each buffer slot. */
+            std::vector<float> slotEdep_, slotTime_, slotXpos_, slotYpos_, slotZpos_;
+
+            /** Buffer slots ordered by raw ID. */
+            std::vector<int> slotOrder_;
 
             double meanNoise_{0};
             int    nProcessed_{0};
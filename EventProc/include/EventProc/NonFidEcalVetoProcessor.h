@@ -86,13 +86,13 @@ namespace ldmx {
             bool isInShowerOuterRing(int centroidID, int probeID){
                 return hexReadout_->isNNN(centroidID, probeID);
             }
-            XYCoords getCellCentroidXYPair(int centroidID){
+            const XYCoords& getCellCentroidXYPair(int centroidID){
                 return hexReadout_->getCellCenterAbsolute(centroidID);
             }
-            std::vector<int> getInnerRingCellIds(int cellModuleID){
+            CellIDSpan getInnerRingCellIds(int cellModuleID){
                 return hexReadout_->getNN(cellModuleID);
             }
-            std::vector<int> getOuterRingCellIds(int cellModuleID){
+            CellIDSpan getOuterRingCellIds(int cellModuleID){
                 return hexReadout_->getNNN(cellModuleID);
             }
 
@@ -149,7 +149,7 @@ namespace ldmx {
             bool verbose_{false};
             bool doesPassVeto_{false};
 
-            std::unique_ptr<EcalHexReadout> hexReadout_;
+            const EcalHexReadout* hexReadout_{nullptr};
 
             std::vector<std::basic_string<char>> nfbdtFileNames_;
             std::vector<int> bdtdrop_;
@@ -8,15 +8,9 @@
 #ifndef EVENTPROC_TRACKERHITKILLER_H_
 #define EVENTPROC_TRACKERHITKILLER_H_
 
-//----------------//
-//   C++ StdLib   //
-//----------------//
-#include <time.h>
-
 //----------//
 //   ROOT   //
 //----------//
-#include "TRandom3.h"
 #include "TClonesArray.h"
 
 //----------//
@@ -55,12 +49,6 @@ namespace ldmx {
 
         private: 
 
-            /** 
-             * Random number generator used to determine if hit should be
-             * dropped. 
-             */
-            std::unique_ptr<TRandom3> random_;
-
             /** Collection of digitized tracker strip hits. */
             TClonesArray* siStripHits_{nullptr};
 
@@ -58,6 +58,14 @@ namespace ldmx {
              */
             virtual void produce(Event& event);
 
+            /**
+             * The trigger decision only depends on the event and the
+             * configuration, so copies can run on worker threads.
+             */
+            virtual bool isCloneSafe() const {
+                return true;
+            }
+
         private:
 
             /** The energy sum to make cut on. */
@@ -6,5 +6,10 @@ ecalVeto = ldmxcfg.Producer("EcalVeto","ldmx::EcalVetoProcessor")
 ecalVeto.parameters["num_ecal_layers"] = 34
 ecalVeto.parameters["do_bdt"] = 1
 ecalVeto.parameters["bdt_file"] = "erin.pkl" 
+# Text dump of the xgboost model (see bdt-dump-model.py) used by the native
+# evaluator.  If empty, the pickled model in bdt_file is evaluated with python.
+ecalVeto.parameters["bdt_model_file"] = ""
+# Compare the native score with the python one in every event
+ecalVeto.parameters["bdt_validate"] = 0
 ecalVeto.parameters["disc_cut"] = 0.94
 ecalVeto.parameters["collection_name"] = "EcalVeto"
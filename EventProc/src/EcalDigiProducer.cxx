@@ -22,7 +22,7 @@ namespace ldmx {
     EcalDigiProducer::EcalDigiProducer(const std::string& name, Process& process) :
         Producer(name, process) {
         noiseGenerator_ = std::make_unique<NoiseGenerator>();
-        noiseInjector_ = std::make_unique<TRandom3>(time(nullptr));
+        noiseGenerator_->setRandom(random_);
     }
 
     EcalDigiProducer::~EcalDigiProducer() {
@@ -31,7 +31,7 @@ namespace ldmx {
 
     void EcalDigiProducer::configure(const ParameterSet& ps) {
 
-        hexReadout_ = std::make_unique<EcalHexReadout>();
+        hexReadout_ = &EcalHexReadout::getInstance();
 
         noiseIntercept_ = ps.getDouble("noiseIntercept",0.); 
         noiseSlope_     = ps.getDouble("noiseSlope",1.);
@@ -67,13 +67,17 @@ namespace ldmx {
 
         //First we simulate noise injection into each hit and store layer-wise 
         // max cell ids
+        occupiedChannels_.clear(); 
         for (int iHit = 0; iHit < numEcalSimHits; iHit++) {
             
             SimCalorimeterHit* simHit = (SimCalorimeterHit*) ecalSimHits->At(iHit);
 
-            double hitNoise = noiseInjector_->Gaus(0, noiseRMS_);
+            double hitNoise = random_.Gaus(0, noiseRMS_);
             layer_cell_pair hit_pair = hitToPair(simHit);
 
+            int channel = getChannel(hit_pair.first, detID_.getFieldValue(2), hit_pair.second); 
+            if (channel >= 0) occupiedChannels_.push_back(channel); 
+
             EcalHit* digiHit = (EcalHit*) (ecalDigis_->ConstructedAt(iHit));
 
             digiHit->setID(simHit->getID());
@@ -88,16 +92,13 @@ namespace ldmx {
             }
         }
 
-        // Given the number of channels without a hit, calculate the expected 
-        // number of noise hits above the readout threshold and randomly 
-        // assign them to Ecal cells
-        int emptyChannels = TOTAL_CELLS - numEcalSimHits;
-        //std::cout << "[ EcalDigiProducer ]: Total number of empty channels: " << emptyChannels << std::endl;
-        std::vector<double> noiseHits = noiseGenerator_->generateNoiseHits(emptyChannels);
-        //std::cout << "[ EcalDigiProducer ]: Total number of noise hits: " << noiseHits.size() << std::endl; 
+        // Given the channels with a hit, generate the noise hits above the 
+        // readout threshold in distinct channels without a hit
+        std::vector<std::pair<int, double> > noiseHits 
+            = noiseGenerator_->generateNoiseHits(TOTAL_CELLS, occupiedChannels_);
         int iHit = numEcalSimHits; 
-        for (double noiseHit : noiseHits) { 
-            //std::cout << "[ EcalDigiProducer ]: Noise hit amplitude: " << noiseHit << std::endl;
+        for (const auto& noise : noiseHits) { 
+            double noiseHit = noise.second; 
 
             // Construct a hit in the ith position
             EcalHit* digiHit = (EcalHit*) (ecalDigis_->ConstructedAt(iHit));
@@ -105,13 +106,10 @@ namespace ldmx {
             // Set the raw energy of the hit
             digiHit->setAmplitude(noiseHit);
 
-            // Generate a random ID and pack it
-            int layerID = noiseInjector_->Integer(NUM_ECAL_LAYERS); 
-            //std::cout << "[ EcalDigiProducer ]: Random layer ID: " << layerID << std::endl;
-            int moduleID = noiseInjector_->Integer(HEX_MODULES_PER_LAYER); 
-            //std::cout << "[ EcalDigiProducer ]: Random module ID: " << moduleID << std::endl;
-            int cellID = noiseInjector_->Integer(CELLS_PER_HEX_MODULE); 
-            //std::cout << "[ EcalDigiProducer ]: Random cell ID: " << cellID << std::endl;
+            // Unpack the channel into an ID
+            int layerID = noise.first/(HEX_MODULES_PER_LAYER*CELLS_PER_HEX_MODULE); 
+            int moduleID = (noise.first/CELLS_PER_HEX_MODULE) % HEX_MODULES_PER_LAYER; 
+            int cellID = noise.first % CELLS_PER_HEX_MODULE; 
             detID_.setFieldValue(1, layerID); 
             detID_.setFieldValue(2, moduleID); 
             detID_.setFieldValue(3, cellID); 
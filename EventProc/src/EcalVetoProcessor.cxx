@@ -16,6 +16,8 @@
 #include <stdlib.h>
 #include <fstream>
 #include <cmath>
+#include <iostream>
+#include <stdexcept>
 
 namespace ldmx {
 
@@ -103,14 +105,28 @@ namespace ldmx {
     void EcalVetoProcessor::configure(const ParameterSet& ps) {
         doBdt_ = ps.getInteger("do_bdt");
         if (doBdt_){
-            // Config and init the BDT.
-            bdtFileName_ = ps.getString("bdt_file");
-            if (!std::ifstream(bdtFileName_).good()) {
-                EXCEPTION_RAISE("EcalVetoProcessor",
-                        "The specified BDT file '" + bdtFileName_ + "' does not exist!");
+            // Config and init the native BDT evaluator if a model dump is given.
+            bdtModelFileName_ = ps.getString("bdt_model_file", "");
+            validateBdt_ = ps.getInteger("bdt_validate", 0);
+            bdtValidationTolerance_ = ps.getDouble("bdt_validation_tolerance", bdtValidationTolerance_);
+            if (!bdtModelFileName_.empty()) {
+                try {
+                    bdtEvaluator_ = std::make_unique<BoostedTreeEvaluator>(bdtModelFileName_, ps.getDouble("bdt_base_score", 0.5));
+                } catch (const std::runtime_error& e) {
+                    EXCEPTION_RAISE("EcalVetoProcessor", e.what());
+                }
             }
 
-            BDTHelper_ = std::make_unique<BDTHelper>(bdtFileName_);
+            // The python BDT is needed if there is no native model or to validate it.
+            if (!bdtEvaluator_ || validateBdt_) {
+                bdtFileName_ = ps.getString("bdt_file");
+                if (!std::ifstream(bdtFileName_).good()) {
+                    EXCEPTION_RAISE("EcalVetoProcessor",
+                            "The specified BDT file '" + bdtFileName_ + "' does not exist!");
+                }
+
+                BDTHelper_ = std::make_unique<BDTHelper>(bdtFileName_);
+            }
         }
 
         cellFileNamexy_ = ps.getString("cellxy_file");
@@ -128,7 +144,7 @@ namespace ldmx {
         }
 
 
-        hexReadout_ = std::make_unique<EcalHexReadout>();
+        hexReadout_ = &EcalHexReadout::getInstance();
         nEcalLayers_ = ps.getInteger("num_ecal_layers");
 
         bdtCutVal_ = ps.getDouble("disc_cut");
@@ -142,6 +158,21 @@ namespace ldmx {
         collectionName_ = ps.getString("collection_name"); 
     }
 
+    void EcalVetoProcessor::onProcessStart() {
+        ecalDigisToken_ = Event::getToken("ecalDigis");
+        ecalSpHitsToken_ = Event::getToken("EcalScoringPlaneHits");
+        targetSpHitsToken_ = Event::getToken("TargetScoringPlaneHits");
+        simParticlesToken_ = Event::getToken("SimParticles");
+    }
+
+    void EcalVetoProcessor::onProcessEnd() {
+        if (validateBdt_ && bdtEvaluator_) {
+            std::cout << "[ EcalVetoProcessor ] : BDT validation: " << nBdtMismatches_ << " of "
+                      << nBdtValidated_ << " events differ by more than " << bdtValidationTolerance_
+                      << " (largest difference " << maxBdtDifference_ << ")" << std::endl;
+        }
+    }
+
     void EcalVetoProcessor::clearProcessor(){
         for (int i = 0; i < nEcalLayers_; i++) {
             cellMap_[i].clear();
@@ -167,7 +198,6 @@ namespace ldmx {
     }
 
     void EcalVetoProcessor::produce(Event& event) {
-        result_.Clear();
         clearProcessor();
 
         // Get the collection of Ecal scoring plane hits. If it doesn't exist,
@@ -178,12 +208,12 @@ namespace ldmx {
         std::vector<double> recoilPAtTarget;
         std::vector<float> recoilPosAtTarget;
 
-        if (event.exists("EcalScoringPlaneHits")) {
-            const TClonesArray* ecalSpHits{event.getCollection("EcalScoringPlaneHits")};
+        if (event.exists(ecalSpHitsToken_)) {
+            const TClonesArray* ecalSpHits{event.getCollection(ecalSpHitsToken_)};
 
             // Loop through all of the sim particles and find the recoil 
             // electron.
-            const TClonesArray* simParticles{event.getCollection("SimParticles")};
+            const TClonesArray* simParticles{event.getCollection(simParticlesToken_)};
             SimParticle* recoilElectron{nullptr}; 
             for (int simParticleIndex = 0; simParticleIndex < simParticles->GetEntriesFast();
                     ++simParticleIndex) { 
@@ -214,8 +244,8 @@ namespace ldmx {
             }
 
             // Find target SP hit for recoil electron
-            if (event.exists("TargetScoringPlaneHits")) {
-                const TClonesArray* targetSpHits{event.getCollection("TargetScoringPlaneHits")};
+            if (event.exists(targetSpHitsToken_)) {
+                const TClonesArray* targetSpHits{event.getCollection(targetSpHitsToken_)};
                 pmax = 0;
                 for (int targetSpIndex = 0; targetSpIndex < targetSpHits->GetEntriesFast(); ++targetSpIndex) {
                     SimTrackerHit* spHit =  static_cast<SimTrackerHit*>(targetSpHits->At(targetSpIndex)); 
@@ -256,7 +286,7 @@ namespace ldmx {
 
 
         // Get the collection of digitized Ecal hits from the event. 
-        const TClonesArray* ecalDigis = event.getCollection("ecalDigis");
+        const TClonesArray* ecalDigis = event.getCollection(ecalDigisToken_);
         int nEcalHits = ecalDigis->GetEntriesFast();
 
         //std::cout << "[ EcalVetoProcessor ] : Got " << nEcalHits << " ECal digis in event "
@@ -450,19 +480,38 @@ namespace ldmx {
             }
         }
 
-        result_.setVariables(nReadoutHits_, deepestLayerHit_, summedDet_, summedTightIso_, maxCellDep_,
+        // the result is filled in place in the event, rather than copied into it
+        EcalVetoResult& result = event.emplaceToCollection<EcalVetoResult>(collectionName_);
+        result.setVariables(nReadoutHits_, deepestLayerHit_, summedDet_, summedTightIso_, maxCellDep_,
             showerRMS_, xStd_, yStd_, avgLayerHit_, stdLayerHit_, ecalBackEnergy_, electronContainmentEnergy, photonContainmentEnergy, outsideContainmentEnergy, outsideContainmentNHits, outsideContainmentXstd, outsideContainmentYstd, ecalLayerEdepReadout_, recoilP, recoilPos);
         
         if (doBdt_) {
-            BDTHelper_->buildFeatureVector(bdtFeatures_, result_);
-            float pred = BDTHelper_->getSinglePred(bdtFeatures_);
-            result_.setVetoResult(pred > bdtCutVal_);
-            result_.setDiscValue(pred);
+            BDTHelper::buildFeatureVector(bdtFeatures_, result);
+            float pred;
+            if (bdtEvaluator_) {
+                pred = bdtEvaluator_->predict(bdtFeatures_);
+                if (validateBdt_) {
+                    float pythonPred = BDTHelper_->getSinglePred(bdtFeatures_);
+                    double difference = std::abs(pred - pythonPred);
+                    maxBdtDifference_ = std::max(maxBdtDifference_, difference);
+                    nBdtValidated_++;
+                    if (difference > bdtValidationTolerance_) {
+                        nBdtMismatches_++;
+                        std::cout << "[ EcalVetoProcessor ] : [WARNING] BDT score mismatch in event "
+                                  << event.getEventHeader()->getEventNumber() << ": native = " << pred
+                                  << ", python = " << pythonPred << std::endl;
+                    }
+                }
+            } else {
+                pred = BDTHelper_->getSinglePred(bdtFeatures_);
+            }
+            result.setVetoResult(pred > bdtCutVal_);
+            result.setDiscValue(pred);
             //std::cout << "  pred > bdtCutVal = " << (pred > bdtCutVal_) << std::endl;
         
             // If the event passes the veto, keep it. Otherwise, 
             // drop the event.
-            if (result_.passesVeto() && inside) { 
+            if (result.passesVeto() && inside) { 
                 setStorageHint(hint_shouldKeep); 
             } else { 
                 setStorageHint(hint_shouldDrop);
@@ -474,7 +523,6 @@ namespace ldmx {
         } else {
             setStorageHint(hint_shouldDrop);
         }
-        event.addToCollection(collectionName_, result_);
     }
 
     EcalVetoProcessor::LayerCellPair EcalVetoProcessor::hitToPair(EcalHit* hit) {
@@ -559,13 +607,13 @@ namespace ldmx {
             }
 
             //Skip hits that have a readout neighbor
-            std::vector<int> cellNbrIds = getInnerRingCellIds(hit_pair.second);
+            CellIDSpan cellNbrIds = getInnerRingCellIds(hit_pair.second);
 
             //Get neighboring cell id's and try to look them up in the full cell map (constant speed algo.)
-            for (int k = 0; k < 6; k++) {
-                std::map<int, float>::iterator it = cellMap_[hit_pair.first].find(cellNbrIds[k]);
+            for (int cellNbrId : cellNbrIds) {
+                std::map<int, float>::iterator it = cellMap_[hit_pair.first].find(cellNbrId);
                 if (it != cellMap_[hit_pair.first].end()) {
-                    isolatedHit = std::make_pair(false, cellNbrIds[k]);
+                    isolatedHit = std::make_pair(false, cellNbrId);
                     break;
                 }
             }
@@ -73,7 +73,7 @@ namespace ldmx {
         // If the maximum PE found is below threshold, it passes the veto.
         bool passesVeto = (maxPE < totalPEThreshold_) ? true : false;
 
-        HcalVetoResult result; 
+        HcalVetoResult& result = event.emplaceToCollection<HcalVetoResult>("HcalVeto");
         result.setVetoResult(passesVeto);
         result.setMaxPEHit(maxPEHit); 
 
@@ -82,8 +82,6 @@ namespace ldmx {
         } else { 
             setStorageHint(hint_shouldDrop); 
         } 
-
-        event.addToCollection("HcalVeto", result);
     }
 }
 
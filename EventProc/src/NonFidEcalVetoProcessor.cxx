@@ -103,7 +103,7 @@ namespace ldmx {
             }
         }
 
-        hexReadout_ = std::make_unique<EcalHexReadout>();
+        hexReadout_ = &EcalHexReadout::getInstance();
         nEcalLayers_ = ps.getInteger("num_ecal_layers");
 
         bdtCutVal_ = ps.getVDouble("disc_cut");
@@ -449,13 +449,13 @@ namespace ldmx {
             }
 
             //Skip hits that have a readout neighbor
-            std::vector<int> cellNbrIds = getInnerRingCellIds(hit_pair.second);
+            CellIDSpan cellNbrIds = getInnerRingCellIds(hit_pair.second);
 
             //Get neighboring cell id's and try to look them up in the full cell map (constant speed algo.)
-            for (int k = 0; k < 6; k++) {
-                std::map<int, float>::iterator it = cellMap_[hit_pair.first].find(cellNbrIds[k]);
+            for (int cellNbrId : cellNbrIds) {
+                std::map<int, float>::iterator it = cellMap_[hit_pair.first].find(cellNbrId);
                 if (it != cellMap_[hit_pair.first].end()) {
-                    isolatedHit = std::make_pair(false, cellNbrIds[k]);
+                    isolatedHit = std::make_pair(false, cellNbrId);
                     break;
                 }
             }
@@ -58,7 +58,7 @@ namespace ldmx {
                       << simHit->getNumberOfContribs() << std::endl;*/
 
             for (int iContrib = 0; iContrib < simHit->getNumberOfContribs(); ++iContrib) {
-                SimCalorimeterHit::Contrib contrib = simHit->getContrib(iContrib);
+                SimCalorimeterHit::Contrib contrib = simHit->getContrib(iContrib, simParticles);
 
                 if (contrib.particle == recoilElectron) { 
                     /*std::cout << "[ RecoilMissesEcalSkimmer ]: " 
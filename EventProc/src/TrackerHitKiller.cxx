@@ -11,8 +11,6 @@ namespace ldmx {
 
     TrackerHitKiller::TrackerHitKiller(const std::string& name, Process& process) :
         Producer(name, process) { 
-
-        random_ = std::make_unique<TRandom3>(time(nullptr));
     }
     
     TrackerHitKiller::~TrackerHitKiller() { 
@@ -38,7 +36,7 @@ namespace ldmx {
         int iHit = 0;
         for (int hitCount = 0; hitCount < recoilSimHits->GetEntriesFast(); ++hitCount) { 
             
-            if (random_->Integer(100) >= hitEff_) { 
+            if (random_.Integer(100) >= hitEff_) { 
                 std::cout << "[ TrackerHitKiller ]: Dropping hit." << std::endl;
                 continue;
             } else {
@@ -88,7 +88,7 @@ namespace ldmx {
         if ((map.findable.size() == 1) && recoilIsFindable && (p < 1200)) passesTrackVeto = true; 
 
 
-        TrackerVetoResult result; 
+        TrackerVetoResult& result = event.emplaceToCollection<TrackerVetoResult>("TrackerVeto");
         result.setVetoResult(passesTrackVeto);
 
         if (passesTrackVeto) { 
@@ -96,8 +96,6 @@ namespace ldmx {
         } else { 
             setStorageHint(hint_shouldDrop); 
         } 
-
-        event.addToCollection("TrackerVeto", result);
     }
 }
 
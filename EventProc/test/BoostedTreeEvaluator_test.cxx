@@ -0,0 +1,75 @@
+// LDMX
+#include "EventProc/EcalVetoProcessor.h"
+#include "Tools/BoostedTreeEvaluator.h"
+
+// ROOT
+#include "TPython.h"
+
+// STL
+#include <algorithm>
+#include <cmath>
+#include <iostream>
+#include <random>
+#include <stdexcept>
+#include <string>
+#include <vector>
+
+using ldmx::BDTHelper;
+using ldmx::BoostedTreeEvaluator;
+
+/*
+ * Compare the scores of the native evaluator with the scores of the
+ * original python BDT on fixed feature vectors.  A small model is
+ * trained with xgboost on integer features, so that all split thresholds
+ * are exact in the text dump, and the test vectors lie on a grid of
+ * quarters, which are exact in the feature string given to python.
+ */
+int main(int, const char* argv[])  {
+
+    std::cout << "Hello BoostedTreeEvaluator test!" << std::endl;
+
+    const int nFeatures = 6;
+
+    TPython::Exec("try:\n    import xgboost as xgb\n    has_xgb = 1\nexcept ImportError:\n    has_xgb = 0\n");
+    if (double(TPython::Eval("has_xgb")) == 0) {
+        std::cout << "xgboost is not available, skipping the comparison" << std::endl;
+        return 0;
+    }
+
+    TPython::Exec("import numpy as np");
+    TPython::Exec("import pickle as pkl");
+    TPython::Exec("rng = np.random.RandomState(7)");
+    TPython::Exec(("x = rng.randint(0, 20, size=(2000, " + std::to_string(nFeatures) + ")).astype(float)").c_str());
+    TPython::Exec("y = ((x[:, 0] + 2*x[:, 1] - x[:, 3] + rng.normal(0, 4, 2000)) > 20).astype(int)");
+    TPython::Exec("booster = xgb.train({'objective': 'binary:logistic', 'max_depth': 4, 'eta': 0.3, 'tree_method': 'exact'},"
+                  " xgb.DMatrix(x, label=y), 40)");
+    TPython::Exec("pkl.dump(booster, open('bdt_test_model.pkl', 'w'))");
+    TPython::Exec("booster.dump_model('bdt_test_model.txt')");
+
+    // the original BDT, which reloads the pickled model as 'model'
+    BDTHelper reference("bdt_test_model.pkl");
+    BoostedTreeEvaluator evaluator("bdt_test_model.txt");
+
+    if (evaluator.getNFeatures() > nFeatures) {
+        throw std::runtime_error("Model uses " + std::to_string(evaluator.getNFeatures()) + " features out of " + std::to_string(nFeatures));
+    }
+
+    std::mt19937 generator(11);
+    std::uniform_int_distribution<int> quarters(-8, 88);
+    std::vector<float> features(nFeatures);
+    double maxDifference = 0;
+    for (int ivec = 0; ivec < 500; ivec++) {
+        for (auto& feature : features) feature = quarters(generator)/4.;
+        float expected = reference.getSinglePred(features);
+        float score = evaluator.predict(features);
+        double difference = std::abs(score - expected);
+        if (difference > 1e-5) {
+            throw std::runtime_error("Vector " + std::to_string(ivec) + " scored " + std::to_string(score)
+                                     + " instead of " + std::to_string(expected));
+        }
+        maxDifference = std::max(maxDifference, difference);
+    }
+
+    std::cout << "Scores of " << evaluator.getNTrees() << " trees agree within " << maxDifference << " ... okay" << std::endl;
+    return 0;
+}
@@ -0,0 +1,119 @@
+// LDMX
+#include "Event/EcalHit.h"
+#include "Event/EventConstants.h"
+#include "Event/HcalHit.h"
+#include "Framework/Benchmark.h"
+#include "Framework/EventImpl.h"
+
+// ROOT
+#include "TClonesArray.h"
+#include "TTree.h"
+
+// STL
+#include <string>
+#include <vector>
+
+using namespace ldmx;
+
+/*
+ * Benchmark of the product bookkeeping of EventImpl for a synthetic event
+ * with a few collections, as seen by a sequence of processors.
+ */
+int main(int, const char* argv[])  {
+
+    const int nCollections = 8;
+    const int nHits = 500;
+
+    EventImpl event("bench");
+    TTree* tree = event.createTree();
+
+    std::vector<std::string> names;
+    std::vector<TClonesArray*> collections;
+    for (int i = 0; i < nCollections; i++) {
+        names.push_back("benchDigis" + std::to_string(i));
+        collections.push_back(new TClonesArray(i % 2 ? EventConstants::ECAL_HIT.c_str() : EventConstants::HCAL_HIT.c_str(), nHits));
+    }
+
+    EcalHit extra;
+    extra.setEnergy(1.);
+
+    // each event: fill and add the collections, then look each of them up
+    // from a few processors, like a sequence of producers and analyzers does
+    double seconds = benchmark::measure([&]() {
+        for (int i = 0; i < nCollections; i++) {
+            for (int j = 0; j < nHits; j++) {
+                static_cast<CalorimeterHit*>(collections[i]->ConstructedAt(j))->setEnergy(j);
+            }
+            event.add(names[i], collections[i]);
+        }
+        for (int j = 0; j < 10; j++) event.addToCollection("benchExtra", extra);
+        for (int processor = 0; processor < 4; processor++) {
+            for (const auto& name : names) {
+                if (event.exists(name)) benchmark::keep(event.getCollection(name)->GetEntriesFast());
+            }
+        }
+        event.beforeFill();
+        event.Clear();
+    });
+    benchmark::report("EventImpl.event.collections" + std::to_string(nCollections), 1/seconds, "events/s");
+
+    // the lookups alone, once the products are known
+    for (int i = 0; i < nCollections; i++) event.add(names[i], collections[i]);
+    seconds = benchmark::measure([&]() {
+        for (const auto& name : names) benchmark::keep(event.getCollection(name));
+    });
+    benchmark::report("EventImpl.getCollection", nCollections/seconds, "lookups/s");
+
+    seconds = benchmark::measure([&]() {
+        for (const auto& name : names) benchmark::keep(event.getCollection(name, "bench"));
+    });
+    benchmark::report("EventImpl.getCollection.passName", nCollections/seconds, "lookups/s");
+
+    std::vector<int> tokens;
+    for (const auto& name : names) tokens.push_back(Event::getToken(name));
+    seconds = benchmark::measure([&]() {
+        for (int token : tokens) benchmark::keep(event.getCollection(token));
+    });
+    benchmark::report("EventImpl.getCollection.token", nCollections/seconds, "lookups/s");
+
+    // the same event as above, with tokens for all gets and adds
+    std::vector<int> addTokens;
+    for (const auto& name : names) addTokens.push_back(Event::getToken(name, "bench"));
+    int extraToken = Event::getToken("benchExtra");
+    event.Clear();
+    seconds = benchmark::measure([&]() {
+        for (int i = 0; i < nCollections; i++) {
+            for (int j = 0; j < nHits; j++) {
+                static_cast<CalorimeterHit*>(collections[i]->ConstructedAt(j))->setEnergy(j);
+            }
+            event.add(addTokens[i], collections[i]);
+        }
+        for (int j = 0; j < 10; j++) event.addToCollection("benchExtra", extra);
+        for (int processor = 0; processor < 4; processor++) {
+            for (int token : tokens) {
+                if (event.exists(token)) benchmark::keep(event.getCollection(token)->GetEntriesFast());
+            }
+        }
+        benchmark::keep(event.exists(extraToken));
+        event.beforeFill();
+        event.Clear();
+    });
+    benchmark::report("EventImpl.event.collections" + std::to_string(nCollections) + ".token", 1/seconds, "events/s");
+
+    // a result object per event, copied in or filled in place
+    seconds = benchmark::measure([&]() {
+        for (int j = 0; j < 10; j++) event.addToCollection("benchExtra", extra);
+        event.Clear();
+    });
+    benchmark::report("EventImpl.addToCollection", 10/seconds, "objects/s");
+
+    seconds = benchmark::measure([&]() {
+        for (int j = 0; j < 10; j++) event.emplaceToCollection<EcalHit>("benchExtra").setEnergy(1.);
+        event.Clear();
+    });
+    benchmark::report("EventImpl.emplaceToCollection", 10/seconds, "objects/s");
+
+    delete tree;
+    for (auto collection : collections) delete collection;
+    return 0;
+}
@@ -0,0 +1,81 @@
+/**
+ * @file Benchmark.h
+ * @brief Helpers for the benchmark programs of the modules.
+ */
+
+#ifndef FRAMEWORK_BENCHMARK_H_
+#define FRAMEWORK_BENCHMARK_H_
+
+// STL
+#include <chrono>
+#include <cstdlib>
+#include <iostream>
+#include <string>
+
+namespace ldmx {
+
+    /**
+     * @namespace benchmark
+     * @brief Timing and reporting for the programs in the 'bench' directories.
+     *
+     * @note Each result is printed as one line of JSON on standard output,
+     * like <tt>{"benchmark":"EcalHexReadout.getCellModuleID","value":2.1e+07,"unit":"lookups/s"}</tt>,
+     * so that the output of all programs can be collected and compared between
+     * builds.  The minimum time spent in each measurement can be set with the
+     * environment variable LDMX_BENCHMARK_TIME in seconds.
+     */
+    namespace benchmark {
+
+        /**
+         * Keep the compiler from optimizing away the computation of a value.
+         * @param value The value which has to be computed.
+         */
+        template <class T>
+        inline void keep(const T& value) {
+            asm volatile("" : : "g"(&value) : "memory");
+        }
+
+        /**
+         * @return The minimum time in seconds to spend in each measurement.
+         */
+        inline double getMinimumTime() {
+            const char* env = std::getenv("LDMX_BENCHMARK_TIME");
+            return env ? std::atof(env) : 0.5;
+        }
+
+        /**
+         * Measure the time of a call, which is repeated in batches of doubling
+         * size until the minimum time has passed.  At least one batch is
+         * run, even if the minimum time is zero or negative.
+         * @param call The call to measure.
+         * @return The average wall time per call in seconds.
+         */
+        template <class Call>
+        double measure(Call&& call) {
+            const double minimumTime = getMinimumTime();
+            long calls = 0, batch = 1;
+            double seconds = 0;
+            do {
+                auto start = std::chrono::steady_clock::now();
+                for (long i = 0; i < batch; i++) call();
+                seconds += std::chrono::duration<double>(std::chrono::steady_clock::now() - start).count();
+                calls += batch;
+                batch *= 2;
+            } while (seconds < minimumTime);
+            return seconds/calls;
+        }
+
+        /**
+         * Print the result of a benchmark.
+         * @param name The name of the benchmark, like Class.method.variant.
+         * @param value The measured value.
+         * @param unit The unit of the value.
+         */
+        inline void report(const std::string& name, double value, const std::string& unit) {
+            std::cout << "{\"benchmark\":\"" << name << "\",\"value\":" << value
+                      << ",\"unit\":\"" << unit << "\"}" << std::endl;
+        }
+    }
+}
+
+#endif
@@ -74,6 +74,15 @@ namespace ldmx {
             /** The frequency with which event info is printed. */
             int logFrequency_{-1}; 
 
+            /** The number of threads used for event processing. */
+            int numThreads_{1};
+
+            /** The root of the random number seeds of the processors. */
+            int randomSeed_{0};
+
+            /** True if the calls of the processors are measured. */
+            bool profile_{false};
+
             /** 
              * List of input ROOT files to process in the job, if provided in 
              * python file. 
@@ -86,6 +95,12 @@ namespace ldmx {
              */
             std::vector<std::string> keepRules_;
 
+            /** 
+             * List of collections read from the input files, if provided in
+             * python file. 
+             */
+            std::vector<std::string> inputCollections_;
+
             /** Default sense for keeping events (keep or drop) */
             bool skimDefaultIsKeep_;
 
@@ -127,6 +142,8 @@ namespace ldmx {
                     std::string instancename_;
                     ParameterSet params_;
                     std::vector<HistogramInfo> histograms_; 
+                    bool enabled_{true};
+                    int prescale_{1};
             };
 
             /** The sequence of EventProcessor objects to be executed in order. */
@@ -15,6 +15,7 @@
 #include "TFile.h"
 
 // STL
+#include <functional>
 #include <string>
 #include <vector>
 #include <map>
@@ -71,6 +72,24 @@ namespace ldmx {
              */
             void addDrop(const std::string& rule);
 
+            /**
+             * Only read the given collections and the event header from this input file.
+             * All other branches are disabled, so they are neither read nor copied to an
+             * output file cloned from this one.
+             * @param collections Collection names, optionally followed by "_" and
+             * the pass name, which may contain wildcards.
+             * @throw Exception if this is not an input file.
+             */
+            void selectInputCollections(const std::vector<std::string>& collections);
+
+            /**
+             * Read the same branches as another input file with the same layout,
+             * by copying which of its branches are active.
+             * @param other The input file to copy the active branches from.
+             * @throw Exception if either file is not an input file.
+             */
+            void selectBranches(EventFile& other);
+
             /**
              * Set an EventImpl object containing the event data to work with this file.
              * @param evt The EventImpl object with event data.
@@ -95,6 +114,22 @@ namespace ldmx {
              */
             bool nextEvent(bool storeCurrentEvent=true);
 
+            /**
+             * Read a specific entry from an input file, clearing the previous event.
+             * @param ientry The index of the entry in the event tree.
+             * @return False if the entry is beyond the end of the file.
+             * @throw Exception if this is not a plain input file.
+             */
+            bool readEntry(Long64_t ientry);
+
+            /**
+             * Get the number of entries in the event tree.
+             * @return The number of entries.
+             */
+            Long64_t getEntries() const {
+                return entries_;
+            }
+
             /**
              * Close the file, writing the tree to disk if creating an output file.
              */
@@ -107,6 +142,15 @@ namespace ldmx {
              */
             void writeRunHeader(RunHeader* runHeader);
 
+            /**
+             * Modify the run headers copied into this output file, e.g. to
+             * record the settings of the current processing pass, and write
+             * them again.
+             * @param update The modification to apply to each run header.
+             * @throw Exception if file is not writable.
+             */
+            void updateRunHeaders(const std::function<void(RunHeader&)>& update);
+
             /**
              * Get the RunHeader for a given run, if it exists in the input file.
              * @param runNumber The run number.
@@ -139,6 +183,12 @@ namespace ldmx {
              */
             void copyRunHeaders();
 
+            /**
+             * Read the active branches of the parent which were not requested
+             * during the current event, so they can be copied to the output.
+             */
+            void readRemainingBranches();
+
         private:
 
             /** The number of entries in the tree. */
@@ -17,7 +17,7 @@
 // STL
 #include <string>
 #include <map>
-#include <set>
+#include <vector>
 
 class TTree;
 class TBranch;
@@ -33,6 +33,14 @@ namespace ldmx {
      * on the fly.  The same TClonesArray and TObject pointers should be
      * used to add objects and collections from user code, as the class will
      * add a data structure for new ones automatically.
+     *
+     * Branches of the input tree are read on demand, the first time a
+     * collection is requested in an event, so that collections which are
+     * not used by any processor are never read or decompressed.
+     *
+     * Whether a product was read or added in the current event is recorded
+     * with the number of the event generation, which is incremented instead
+     * of clearing a set of names, so a token lookup never searches a map.
      */
     class EventImpl : public Event {
 
@@ -74,10 +82,25 @@ namespace ldmx {
              * simply call "new" and create an empty new object and
              * implement TObject::Copy() to either copy the contents of
              * the object or swap them to the calling function, which
-             * is more efficient.
+             * is more efficient.  Objects which are made only to be added
+             * can instead be filled in place with emplace().
              */
             virtual void add(const std::string& name, TObject* obj);
 
+            /**
+             * Adds the collection of a token to the event/tree.
+             * @param token The token of the collection.
+             * @param tca The clones array to add.
+             */
+            virtual void add(int token, TClonesArray* tca);
+
+            /**
+             * Adds the object of a token to the event/tree.
+             * @param token The token of the object.
+             * @param obj The object to add.
+             */
+            virtual void add(int token, TObject* obj);
+
             /**
              * Add the given object to the named TClonesArray collection
              * Objects can only be added to a TClonesArray during the current pass -- TClonesArrays loaded
@@ -97,6 +120,27 @@ namespace ldmx {
              */
             virtual const TObject* getReal(const std::string& collectionName, const std::string& passName, bool mustExist) const;
 
+            /**
+             * Get an object from the event by token.
+             * @param token The token of the object.
+             * @param mustExist True to throw an exception if the object does not exist.
+             */
+            virtual const TObject* getReal(int token, bool mustExist) const;
+
+            /**
+             * Get an object of the current pass to fill in place, creating it and its branch if needed.
+             * @param name The name of the object.
+             * @param type The class of the object.
+             */
+            virtual TObject* emplaceReal(const std::string& name, TClass* type);
+
+            /**
+             * Append a new object to a collection of the current pass, creating the collection if needed.
+             * @param name The name of the collection.
+             * @param type The class of the objects in the collection.
+             */
+            virtual TObject* emplaceToCollectionReal(const std::string& name, TClass* type);
+
         public:
 
             /** ********* Functionality for storage  ********** **/
@@ -164,6 +208,50 @@ namespace ldmx {
              */
             bool nextEvent();
 
+            /**
+             * Go to the given entry of the input tree.
+             * @param ientry The entry index.
+             * @return Hard-coded to return true.
+             */
+            bool setEntry(Long64_t ientry);
+
+            /**
+             * Borrow the products of another event on the same input entry until
+             * the end of the current event.  The input products read by the other
+             * event and the products it added in this pass are used in place, so
+             * they are neither read nor copied again, and references between them
+             * stay valid.  The event header of the other event is used if it has
+             * one.  The other event must not be changed until this event has been
+             * cleared.
+             * @param lender The event lending its products.
+             */
+            void borrowProducts(EventImpl& lender);
+
+            /**
+             * Expect the input products of each entry to be borrowed with
+             * borrowProducts(), so that the event header is not read from
+             * the input tree when moving to a new entry.
+             * @param borrowInput True if the input products are borrowed.
+             */
+            void setBorrowInput(bool borrowInput) {
+                borrowInput_ = borrowInput;
+            }
+
+            /**
+             * Get the input tree of the event whose products are borrowed in the
+             * current event.
+             * @return The input tree of the lender, or null if nothing is borrowed.
+             */
+            TTree* getLenderTree() const {
+                return lenderTree_;
+            }
+
+            /**
+             * Read all active branches of the input tree for the current entry, so
+             * that another event can borrow them with borrowProducts().
+             */
+            void readInputBranches();
+
             /**
              * Action to be executed before the tree is filled.
              */
@@ -194,6 +282,104 @@ namespace ldmx {
 
         private:
 
+            /**
+             * @struct Product
+             * @brief An object or collection known to this event, and its input branch if it is read from the input tree.
+             */
+            struct Product {
+                    /** The object or collection. */
+                    TObject* object_{nullptr};
+                    /** The input branch, or null if the product is made in this pass. */
+                    TBranch* branch_{nullptr};
+                    /** The read generation in which the input branch was last read. */
+                    long read_{-1};
+                    /** The fill generation in which the product was last added. */
+                    long filled_{-1};
+                    /** The own object of this event while object_ is borrowed from another event. */
+                    TObject* own_{nullptr};
+                    /** True while object_ is borrowed from another event. */
+                    bool borrowed_{false};
+            };
+
+            /**
+             * @struct TokenSlot
+             * @brief The products a token refers to in this event.
+             */
+            struct TokenSlot {
+                    /** The product returned by gets, or null if it does not exist. */
+                    Product* get_{nullptr};
+                    /** True if get_ has been looked up. */
+                    bool getResolved_{false};
+                    /** The product of the current pass written by adds, or null if not added yet. */
+                    Product* add_{nullptr};
+            };
+
+            /**
+             * Find a product by name, loading its branch from the input tree if needed.
+             * @param collectionName The collection name.
+             * @param passName The pass name, or empty to match the only product with this name.
+             * @param mustExist True to throw an exception if the product does not exist.
+             * @return The product, or null if it does not exist.
+             */
+            Product* findProduct(const std::string& collectionName, const std::string& passName, bool mustExist) const;
+
+            /**
+             * Find a product by branch name, loading its branch from the input tree if needed.
+             * @param branchName The branch name.
+             * @return The product, or null if it does not exist.
+             */
+            Product* findBranch(const std::string& branchName) const;
+
+            /**
+             * Read the input branch of a product if it has not been read for the current entry.
+             * @param product The product.
+             * @return The object of the product.
+             */
+            TObject* read(Product& product) const;
+
+            /**
+             * Make a new product of the current pass owning an object, with its output branch.
+             * @param collectionName The name of the object.
+             * @param branchName The branch name of the object.
+             * @param object The object, which will be deleted by this event.
+             * @return The new product.
+             */
+            Product& addOwnedObject(const std::string& collectionName, const std::string& branchName, TObject* object);
+
+            /**
+             * Mark a product as added in the current event.
+             * @param product The product.
+             * @return False if the product has already been added in the current event.
+             */
+            bool markFilled(Product& product) {
+                if (product.filled_ == fillGeneration_) return false;
+                product.filled_ = fillGeneration_;
+                return true;
+            }
+
+            /**
+             * Get the name of a token for adding a product in the current pass.
+             * @param token The token.
+             * @return The name of the product.
+             */
+            std::string getAddName(int token) const;
+
+            /**
+             * Get the slot of a token, growing the list of slots if needed.
+             * @param token The token.
+             * @return The slot.
+             */
+            TokenSlot& getSlot(int token) const;
+
+            /**
+             * Forget the products found for the tokens, as a new product may change
+             * which product a name without pass refers to.
+             */
+            void invalidateLookups() {
+                knownLookups_.clear();
+                for (auto& slot : tokenSlots_) slot.getResolved_ = false;
+            }
+
             /**
              * The event header object (as pointer).
              */
@@ -225,14 +411,25 @@ namespace ldmx {
             TTree* inputTree_{nullptr};
 
             /**
-             * Map of names to branches.
+             * Map of branch names to products.  The products are never removed, so
+             * pointers to them stay valid.
              */
-            mutable std::map<std::string, TBranch*> branches_;
+            mutable std::map<std::string, Product> objects_;
 
             /**
-             * Map of names to objects.
+             * Incremented when a new entry is read, so that no input branch counts as read.
              */
-            mutable std::map<std::string, TObject*> objects_;
+            long readGeneration_{0};
+
+            /**
+             * Incremented at the end of each event, so that no product counts as added.
+             */
+            long fillGeneration_{0};
+
+            /**
+             * The products of each token, indexed by token.
+             */
+            mutable std::vector<TokenSlot> tokenSlots_;
 
             /**
              * Map of owned objects that should eventually be cleared at end of event
@@ -250,11 +447,6 @@ namespace ldmx {
              */
             std::vector<std::string> branchNames_;
 
-            /**
-             * Names of branches filled during this event.
-             */
-            std::set<std::string> branchesFilled_;
-
             /**
              * Efficiency cache for empty pass name lookups.
              */
@@ -264,7 +456,17 @@ namespace ldmx {
              * List of all the event products
              */
             std::vector<ProductTag> products_;
-    }; 
+
+            /**
+             * True if the input products are borrowed from another event instead of being read.
+             */
+            bool borrowInput_{false};
+
+            /**
+             * The input tree of the event whose products are borrowed in the current event.
+             */
+            TTree* lenderTree_{nullptr};
+    };
 }
 
 #endif
@@ -11,11 +11,15 @@
 #include "Framework/Exception.h"
 #include "Event/Event.h"
 #include "Event/RunHeader.h"
+#include "Framework/HistogramPool.h"
 #include "Framework/ParameterSet.h"
+#include "Framework/ProcessorStatistics.h"
 #include "Framework/StorageControl.h"
+#include "Tools/RandomStream.h"
 
 // STL
 #include <map>
+#include <memory>
 
 class TDirectory;
 
@@ -23,6 +27,7 @@ namespace ldmx {
 
     class Process;
     class EventProcessor;
+    class RandomSeedService;
 
     /** Typedef for EventProcessorFactory use. */
     typedef EventProcessor* EventProcessorMaker(const std::string& name, Process& process);
@@ -102,6 +107,28 @@ namespace ldmx {
             virtual void onProcessEnd() {
             }
 
+            /**
+             * Get the name of this instance of the processor.
+             * @return The instance name given in the configuration.
+             */
+            const std::string& getName() const {
+                return name_;
+            }
+
+            /**
+             * Declare whether independent copies of this processor may be run
+             * concurrently on different events.  A processor is clone-safe if
+             * each instance keeps all of its mutable state in its own members
+             * (no static or global state) and creates its histograms through
+             * its own HistogramPool, whose contents are merged at the end of
+             * the processing.  Processors
+             * which are not clone-safe are always run on the main thread.
+             * @return True if the processor may be cloned onto worker threads.
+             */
+            virtual bool isCloneSafe() const {
+                return false;
+            }
+
             /** Access/create a directory in the histogram file for this event
              * processor to create histograms and analysis tuples.
              * @note This method makes the returned directory the current directory
@@ -109,12 +136,50 @@ namespace ldmx {
              */
             TDirectory* getHistoDirectory();
 
+            /**
+             * Get the pool of histograms of this instance of the processor.
+             * @return The pool of histograms.
+             */
+            HistogramPool& getHistograms() {
+                return histograms_;
+            }
+
+            /**
+             * Get the random number stream of this instance of the processor.
+             * The stream is restarted by the framework for each event, so the
+             * random numbers of an event are reproducible.
+             * @return The random number stream.
+             */
+            RandomStream& getRandom() {
+                return random_;
+            }
+
+            /**
+             * Get the resource usage of the calls of this instance of the processor.
+             * @return The statistics, or null if the processors are not profiled.
+             */
+            ProcessorStatistics* getStatistics() {
+                return statistics_.get();
+            }
+
+            /**
+             * Start recording the resource usage of the calls of this instance
+             * of the processor.
+             */
+            void enableStatistics();
+
+            /**
+             * Restart the random number stream of this processor for an event.
+             * @param seeds The seed service of the process.
+             * @param header The header of the event.
+             */
+            void startRandomStream(const RandomSeedService& seeds, const EventHeader& header);
 
             /** Mark the current event as having the given storage control hint from this module
              * @param controlhint The storage control hint to apply for the given event
              */
             void setStorageHint(ldmx::StorageControlHint hint) {
-                setStorageHint(hint,"");
+                setStorageHint(hint,storageHintID_);
             }
 
             /** Mark the current event as having the given storage control hint from this module and the given purpose string
@@ -122,6 +187,20 @@ namespace ldmx {
              * @param purposeString A purpose string which can be used in the skim control configuration
              */
             void setStorageHint(ldmx::StorageControlHint hint, const std::string& purposeString);
+
+            /** Mark the current event as having the given storage control hint from this module,
+             * with a purpose registered beforehand with getStorageHintID()
+             * @param controlhint The storage control hint to apply for the given event
+             * @param hintID The ID of the purpose string
+             */
+            void setStorageHint(ldmx::StorageControlHint hint, int hintID);
+
+            /** Register a purpose string for the storage hints of this module, so that
+             * hints can be given without looking up the string for each event
+             * @param purposeString A purpose string which can be used in the skim control configuration
+             * @return The ID to pass to setStorageHint()
+             */
+            int getStorageHintID(const std::string& purposeString) const;
     
             /**
              * Internal function which is part of the EventProcessorFactory machinery.
@@ -135,6 +214,12 @@ namespace ldmx {
             /** Handle to the Process. */
             Process& process_;
 
+            /** The histograms of this instance of the processor. */
+            HistogramPool histograms_;
+
+            /** The random number stream of this instance of the processor. */
+            RandomStream random_;
+
         private:
 
             /** The name of the EventProcessor. */
@@ -142,6 +227,12 @@ namespace ldmx {
 
             /** Histogram directory */
             TDirectory* histoDir_{0};
+
+            /** ID of the storage hints of this module without a purpose string */
+            int storageHintID_;
+
+            /** Resource usage of the calls of this instance, if the processors are profiled. */
+            std::unique_ptr<ProcessorStatistics> statistics_;
     };
 
     /**
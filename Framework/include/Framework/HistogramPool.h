@@ -1,6 +1,6 @@
 /**
  * @file HistogramPool.h
- * @brief Singleton class used to create and pool histograms.
+ * @brief Class used to create and pool the histograms of an event processor.
  * @author Omar Moreno, SLAC National Accelerator Laboratory
  */
 
@@ -14,60 +14,104 @@
 #include <unordered_map>
 #include <iostream>
 
-// Forward declarations
-class TH1; 
-
-namespace ldmx { 
+//----------//
+//   ROOT   //
+//----------//
+#include "TDirectory.h"
 
+// Forward declarations
+class TH1;
+
+namespace ldmx {
+
+    /**
+     * @class HistogramPool
+     * @brief Pool of the histograms of one EventProcessor.
+     *
+     * @note
+     * The histograms returned by create() should be kept by the processor and
+     * filled directly, so that no lookup by name is needed for each event.
+     *
+     * The pool of a copy of a processor running on a worker thread is made
+     * with copyEmpty().  Its histograms are not attached to any directory, are
+     * owned by the pool and are added to the histograms of the original pool
+     * with merge() when the processing ends.
+     */
     class HistogramPool {
 
-        private: 
+        private:
 
             /** Container for all histograms. */
             std::unordered_map< std::string, TH1* > histograms_;
 
-            /** HistogramPool singlenton. */
-            static HistogramPool* instance;
+            /** True if the histograms are owned by this pool rather than by a directory. */
+            bool detached_{false};
+
+            /** Add a histogram to the pool, replacing any histogram with the same name. */
+            void insert(const std::string& name, TH1* hist);
+
+            /**
+             * Make a new histogram of type T.  The histograms of a detached pool
+             * are made while no directory is current, as ROOT would otherwise
+             * replace the histogram with the same name of the original pool in
+             * the current directory.
+             */
+            template <typename T, typename... Args>
+            T* make(Args... args) {
+                if (!detached_) return new T(args...);
+                TDirectory::TContext context(nullptr);
+                return new T(args...);
+            }
+
+        public:
 
-            /** Private constructor to prevent instantiation */
-            HistogramPool(); 
+            /** Constructor */
+            HistogramPool();
 
-        public: 
+            /** Destructor */
+            ~HistogramPool();
 
-            static HistogramPool* getInstance();  
+            /** The histograms can not be shared between pools. */
+            HistogramPool(const HistogramPool&) = delete;
+
+            /** The histograms can not be shared between pools. */
+            HistogramPool& operator=(const HistogramPool&) = delete;
 
             /**
              * Create a ROOT 1D histogram of type T and pool it for later use.
              *
-             * @param name Name of the histogram. This will also be used as a 
+             * @param name Name of the histogram. This will also be used as a
              *             title.
              * @param xLabel Title of the x axis.
              * @param bins Total number of histogram bins.
              * @param xmin The lower histogram limit.
              * @param xmax The upper histogram limit.
+             * @return The new histogram.
              */
             template <typename T>
-            void create(const std::string& name, const std::string& xLabel, 
+            T* create(const std::string& name, const std::string& xLabel,
                         const int& bins, const int& xmin, const int& xmax) {
-                
+
                 // Create a histogram of type T
-                T* hist = new T(name.c_str(), name.c_str(), bins, xmin, xmax);
+                T* hist = make<T>(name.c_str(), name.c_str(), bins, xmin, xmax);
 
                 // Set the title
-                hist->SetTitle(""); 
+                hist->SetTitle("");
 
                 // Set the x-axis label
-                hist->GetXaxis()->SetTitle(xLabel.c_str()); 
-                hist->GetXaxis()->CenterTitle(); 
+                hist->GetXaxis()->SetTitle(xLabel.c_str());
+                hist->GetXaxis()->CenterTitle();
 
                 // Insert it into the pool of histograms for later use
-                histograms_[name] = hist; 
+                insert(name, hist);
+
+                return hist;
             }
 
             /**
              * Create a ROOT 2D histogram of type T and pool it for later use.
              *
-             * @param name Name of the histogram. This will also be used as a 
+             * @param name Name of the histogram. This will also be used as a
              *             title.
              * @param xLabel Title of the x axis.
              * @param xbins Total number of histogram bins in x.
@@ -77,36 +121,58 @@ namespace ldmx {
              * @param ybins Total number of histogram bins in y.
              * @param ymin The lower histogram limit in y.
              * @param ymax The upper histogram limit in y.
+             * @return The new histogram.
              */
             template <typename T>
-            void create(const std::string& name, const std::string& xLabel, 
+            T* create(const std::string& name, const std::string& xLabel,
                         const int& xbins, const int& xmin, const int& xmax,
-                        const std::string& yLabel, 
+                        const std::string& yLabel,
                         const int& ybins, const int& ymin, const int& ymax) {
-                
+
                 // Create a histogram of type T
-                T* hist = new T(name.c_str(), name.c_str(), xbins, xmin, xmax, ybins, ymin, ymax);
+                T* hist = make<T>(name.c_str(), name.c_str(), xbins, xmin, xmax, ybins, ymin, ymax);
 
                 // Set the title
-                hist->SetTitle(""); 
+                hist->SetTitle("");
 
                 // Set the x-axis label
-                hist->GetXaxis()->SetTitle(xLabel.c_str()); 
-                hist->GetXaxis()->CenterTitle(); 
+                hist->GetXaxis()->SetTitle(xLabel.c_str());
+                hist->GetXaxis()->CenterTitle();
 
                 // Set the x-axis label
-                hist->GetYaxis()->SetTitle(yLabel.c_str()); 
-                hist->GetYaxis()->CenterTitle(); 
+                hist->GetYaxis()->SetTitle(yLabel.c_str());
+                hist->GetYaxis()->CenterTitle();
 
                 // Insert it into the pool of histograms for later use
-                histograms_[name] = hist; 
+                insert(name, hist);
+
+                return hist;
             }
 
-            /** 
-             * @return Retrieve the histogram named "name" from the pool. 
+            /**
+             * @return Retrieve the histogram named "name" from the pool.
+             * @note This looks the histogram up by name, so it should be used
+             *       once to keep the histogram rather than for each event.
              */
             TH1* get(const std::string& name);
 
+            /**
+             * Fill this pool with empty copies of the histograms of another
+             * pool.  The copies, and all histograms created afterwards, are
+             * owned by this pool instead of being written to a directory.
+             *
+             * @param other The pool to copy.
+             */
+            void copyEmpty(const HistogramPool& other);
+
+            /**
+             * Add the contents of the histograms of another pool to the
+             * histograms with the same names in this pool.
+             *
+             * @param other The pool to merge into this one.
+             */
+            void merge(const HistogramPool& other);
+
     }; // HistogramPool
 
 } // ldmx
@@ -106,6 +106,12 @@ namespace ldmx {
              */
             const std::vector<std::string>& getVString(const std::string& name, const std::vector<std::string>& defaultValue) const;
 
+            /**
+             * Check whether a parameter of any type was provided.
+             * @param name Name of the parameter.
+             */
+            bool has(const std::string& name) const;
+
             /**
              * Add an integer to the ParameterSet.
              * @param name Name of the integer parameter.
@@ -9,6 +9,9 @@
 
 // LDMX
 #include "Framework/Exception.h"
+#include "Framework/ParameterSet.h"
+#include "Framework/ProcessorDispatch.h"
+#include "Framework/RandomSeedService.h"
 #include "Framework/StorageControl.h"
 
 // STL
@@ -52,6 +55,18 @@ namespace ldmx {
              */
             void addToSequence(EventProcessor* evtproc);
 
+            /**
+             * Add an event processor to the sequence, along with the information needed
+             * to create further copies of it for worker threads.
+             * @param evtproc EventProcessor (Producer, Analyzer) to add to the sequence
+             * @param classname The class name used to create the processor with the EventProcessorFactory
+             * @param parameters The parameters the processor was configured with
+             * @param enabled False if the processor should not be called for any event
+             * @param prescale Call the processor only for the events whose number is a multiple of this
+             */
+            void addToSequence(EventProcessor* evtproc, const std::string& classname, const ParameterSet& parameters,
+                               bool enabled = true, int prescale = 1);
+
             /**
              * Add an input file name to the list.
              * @param filename Input ROOT event file name
@@ -72,6 +87,23 @@ namespace ldmx {
              */
             void addDropKeepRule(const std::string& rule);
 
+            /**
+             * Declare a collection which is read by the processors in this job.
+             * Once any collection is declared, all other branches of the input
+             * files are disabled before the event loop starts, so they are
+             * neither read nor copied into the output files.
+             * @param collection Collection name, optionally followed by "_" and the pass name.
+             */
+            void addInputCollection(const std::string& collection);
+
+            /**
+             * Get the collections declared as inputs of this job.
+             * @return The declared input collections, empty if all branches are read.
+             */
+            const std::vector<std::string>& getInputCollections() const {
+                return inputCollections_;
+            }
+
             /**
              * Set a single output event file name
              * @param filenameOut Output ROOT event file name
@@ -101,6 +133,22 @@ namespace ldmx {
                 runForGeneration_=run;
             }
 
+            /**
+             * Set the root of the random number seeds of the processors.  The
+             * seed root is recorded in the run headers of the output files.
+             * @param seedRoot The seed root.
+             */
+            void setRandomSeedRoot(int seedRoot) {
+                randomSeeds_.setSeedRoot(seedRoot);
+            }
+
+            /**
+             * Access the service which derives the random number seeds of the processors.
+             */
+            const RandomSeedService& getRandomSeeds() const {
+                return randomSeeds_;
+            }
+
             /**
              * Set the maximum number of events to process.  Processing will stop 
              * when either there are no more input events or when this number of events have been processed.
@@ -116,6 +164,23 @@ namespace ldmx {
              */
             inline void setLogFrequency(int logFrequency) { logFrequency_ = logFrequency; }
 
+            /**
+             * Set the number of threads used to process events.  With more than one
+             * thread, the leading clone-safe processors of the sequence are run on 
+             * worker threads, each with its own copy of the processors, while the
+             * remaining processors and the output are handled in order on the main thread.
+             * @param numThreads The number of worker threads.
+             */
+            void setNumThreads(int numThreads) { numThreads_ = numThreads; }
+
+            /**
+             * Record the wall time, CPU time and memory allocations of each call of
+             * each processor.  A summary is printed at the end of the processing
+             * and the wall time per event of each processor is histogrammed.
+             * @param profile True to measure the calls of the processors.
+             */
+            void setProfiling(bool profile) { profile_ = profile; }
+
             /**
              * Run the process.
              */
@@ -134,7 +199,13 @@ namespace ldmx {
             /**  
              * Access the storage control unit for this process
              */
-            StorageControl& getStorageController() { return m_storageController; }
+            StorageControl& getStorageController();
+
+            /**
+             * Direct storage hints made on the calling thread to the given controller
+             * @param controller The storage controller of a worker thread, or null to restore the default
+             */
+            void setThreadStorageController(StorageControl* controller);
     
         private:
 
@@ -150,9 +221,34 @@ namespace ldmx {
             /** Storage controller */
             StorageControl m_storageController;
 
+            /** Seeds of the random number streams of the processors. */
+            RandomSeedService randomSeeds_;
+
             /** Ordered list of EventProcessors to execute. */
             std::vector<EventProcessor*> sequence_;
 
+            /** How to call each EventProcessor in the sequence for an event. */
+            std::vector<ProcessorDispatch> dispatch_;
+
+            /**
+             * @struct ProcessorRecipe
+             * @brief Information needed to create copies of an EventProcessor.
+             */
+            struct ProcessorRecipe {
+                    std::string classname_;
+                    ParameterSet parameters_;
+                    bool valid_{false};
+            };
+
+            /** How to recreate each EventProcessor in the sequence. */
+            std::vector<ProcessorRecipe> recipes_;
+
+            /** Number of threads to use for event processing. */
+            int numThreads_{1};
+
+            /** True if the calls of the processors are measured. */
+            bool profile_{false};
+
             /** List of input files to process.  May be empty if this Process will generate new events. */
             std::vector<std::string> inputFiles_;
 
@@ -162,6 +258,9 @@ namespace ldmx {
             /** Set of drop/keep rules. */
             std::vector<std::string> dropKeepRules_;
 
+            /** Collections read from the input files, or empty to read all of them. */
+            std::vector<std::string> inputCollections_;
+
             /** Run number to use if generating events. */
             int runForGeneration_{1};
 
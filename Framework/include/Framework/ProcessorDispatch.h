@@ -0,0 +1,96 @@
+/**
+ * @file ProcessorDispatch.h
+ * @brief Class which calls the event method of a processor in the sequence.
+ */
+
+#ifndef FRAMEWORK_PROCESSORDISPATCH_H_
+#define FRAMEWORK_PROCESSORDISPATCH_H_
+
+// LDMX
+#include "Event/EventHeader.h"
+#include "Framework/EventProcessor.h"
+
+namespace ldmx {
+
+    /**
+     * @class ProcessorDispatch
+     * @brief Entry of the processor sequence which calls produce() or analyze() of its processor.
+     *
+     * @note Whether the processor is a Producer or an Analyzer is resolved
+     * once, when the entry is made, so the event loop does not need to cast
+     * the processors for each event.  An entry can also be disabled, or be
+     * prescaled so that its processor only sees the events whose number is a
+     * multiple of the prescale.  As the prescale depends only on the event
+     * number, the same events are selected with any number of threads.
+     */
+    class ProcessorDispatch {
+
+        public:
+
+            /**
+             * Class constructor.
+             * @param processor The processor, which must be a Producer or an Analyzer.
+             * @param enabled False if the processor should not be called for any event.
+             * @param prescale Call the processor only for every prescale-th event.
+             */
+            ProcessorDispatch(EventProcessor* processor, bool enabled = true, int prescale = 1);
+
+            /**
+             * Get the processor of this entry.
+             * @return The processor.
+             */
+            EventProcessor* getProcessor() const {
+                return processor_;
+            }
+
+            /** @return True if the processor is called for any event. */
+            bool isEnabled() const {
+                return enabled_;
+            }
+
+            /** @return The prescale of the processor. */
+            int getPrescale() const {
+                return prescale_;
+            }
+
+            /**
+             * Check if the processor should be called for an event.
+             * @param header The header of the event.
+             * @return True if the processor is enabled and not prescaled away.
+             */
+            bool isSelected(const EventHeader& header) const {
+                return enabled_ && (prescale_ == 1 || header.getEventNumber() % prescale_ == 0);
+            }
+
+            /**
+             * Call produce() or analyze() of the processor.
+             * @param event The event to process.
+             */
+            void process(Event& event) const {
+                if (producer_) {
+                    producer_->produce(event);
+                } else {
+                    analyzer_->analyze(event);
+                }
+            }
+
+        private:
+
+            /** The processor. */
+            EventProcessor* processor_;
+
+            /** The processor as a Producer, or null if it is an Analyzer. */
+            Producer* producer_;
+
+            /** The processor as an Analyzer, or null if it is a Producer. */
+            Analyzer* analyzer_;
+
+            /** Call the processor only for every prescale-th event. */
+            int prescale_;
+
+            /** False if the processor is not called for any event. */
+            bool enabled_;
+    };
+}
+
+#endif
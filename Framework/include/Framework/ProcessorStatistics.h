@@ -0,0 +1,182 @@
+/**
+ * @file ProcessorStatistics.h
+ * @brief Class which records the resource usage of the calls of an event processor.
+ */
+
+#ifndef FRAMEWORK_PROCESSORSTATISTICS_H_
+#define FRAMEWORK_PROCESSORSTATISTICS_H_
+
+// STL
+#include <chrono>
+#include <cstdint>
+#include <ostream>
+#include <string>
+#include <vector>
+
+class TDirectory;
+class TH1F;
+
+namespace ldmx {
+
+    /**
+     * @class ProcessorStatistics
+     * @brief Records the wall time, CPU time and memory allocations of the calls of one event processor.
+     *
+     * @note The Process only creates statistics for its processors if
+     * profiling is enabled, otherwise the cost of the instrumentation is a
+     * null check per call.  The CPU time is the time of the calling thread.
+     * Allocations are only counted if the application registers a counter
+     * with setAllocationCounter(), which ldmx-app does when it is built with
+     * the COUNT_ALLOCATIONS option.
+     */
+    class ProcessorStatistics {
+
+        public:
+
+            /** The calls which are measured. */
+            enum Callback {
+                EVENT,          ///< produce() or analyze()
+                NEW_RUN,        ///< onNewRun()
+                FILE_OPEN,      ///< onFileOpen()
+                FILE_CLOSE,     ///< onFileClose()
+                PROCESS_START,  ///< onProcessStart()
+                PROCESS_END,    ///< onProcessEnd()
+                NUM_CALLBACKS
+            };
+
+            /**
+             * @struct Usage
+             * @brief Resources used by all calls of one callback.
+             */
+            struct Usage {
+                    /** Number of calls. */
+                    long calls_{0};
+                    /** Total wall time in seconds. */
+                    double wallTime_{0};
+                    /** Total CPU time in seconds. */
+                    double cpuTime_{0};
+                    /** Total number of memory allocations. */
+                    uint64_t allocations_{0};
+            };
+
+            /**
+             * @class Scope
+             * @brief Measures a call for as long as it is in scope.
+             */
+            class Scope {
+
+                public:
+
+                    /**
+                     * Start measuring a call.
+                     * @param statistics The statistics to record the call in, or null to not measure it.
+                     * @param callback The callback which is called.
+                     */
+                    Scope(ProcessorStatistics* statistics, Callback callback) : statistics_(statistics) {
+                        if (statistics_) statistics_->start(callback);
+                    }
+
+                    /** Finish measuring the call. */
+                    ~Scope() {
+                        if (statistics_) statistics_->stop();
+                    }
+
+                private:
+
+                    /** The statistics to record the call in. */
+                    ProcessorStatistics* statistics_;
+            };
+
+            /**
+             * Class constructor.
+             * @param name The name of the processor.
+             */
+            ProcessorStatistics(const std::string& name);
+
+            /**
+             * Class destructor.
+             */
+            ~ProcessorStatistics();
+
+            /** The statistics of a processor can not be shared. */
+            ProcessorStatistics(const ProcessorStatistics&) = delete;
+
+            /** The statistics of a processor can not be shared. */
+            ProcessorStatistics& operator=(const ProcessorStatistics&) = delete;
+
+            /**
+             * Get the resources used by the calls of a callback.
+             * @param callback The callback.
+             * @return The resource usage.
+             */
+            const Usage& getUsage(Callback callback) const {
+                return usage_[callback];
+            }
+
+            /**
+             * Add the statistics of a copy of the processor to this one.
+             * @param other The statistics of the copy.
+             */
+            void merge(const ProcessorStatistics& other);
+
+            /**
+             * Move the histogram of the wall time per event into a directory,
+             * which takes the ownership of it.
+             * @param directory The directory to write the histogram to.
+             */
+            void writeEventTimes(TDirectory* directory);
+
+            /**
+             * Print a table of the resource usage of a list of processors.
+             * @param out The stream to print to.
+             * @param statistics The statistics of the processors.
+             */
+            static void printSummary(std::ostream& out, const std::vector<const ProcessorStatistics*>& statistics);
+
+            /**
+             * Register the function which returns the number of memory allocations
+             * made so far by the calling thread.
+             * @param counter The counter function, or null if allocations are not counted.
+             */
+            static void setAllocationCounter(uint64_t (*counter)()) {
+                allocationCounter_ = counter;
+            }
+
+        private:
+
+            /** Start measuring a call. */
+            void start(Callback callback);
+
+            /** Finish measuring the current call. */
+            void stop();
+
+            /** @return The CPU time used by the calling thread in seconds. */
+            static double getCPUTime();
+
+            /** The name of the processor. */
+            std::string name_;
+
+            /** The resource usage of each callback. */
+            Usage usage_[NUM_CALLBACKS];
+
+            /** Histogram of the wall time per event, owned by this object until it is written. */
+            TH1F* eventTimes_{nullptr};
+
+            /** The callback of the current call. */
+            Callback current_{EVENT};
+
+            /** The wall time at the start of the current call. */
+            std::chrono::steady_clock::time_point wallStart_;
+
+            /** The CPU time at the start of the current call. */
+            double cpuStart_{0};
+
+            /** The allocation count at the start of the current call. */
+            uint64_t allocationStart_{0};
+
+            /** The allocation counter of the application. */
+            static uint64_t (*allocationCounter_)();
+    };
+}
+
+#endif
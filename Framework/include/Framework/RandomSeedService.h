@@ -0,0 +1,61 @@
+/**
+ * @file RandomSeedService.h
+ * @brief Class which derives the keys of the random number streams of the event processors.
+ */
+
+#ifndef FRAMEWORK_RANDOMSEEDSERVICE_H_
+#define FRAMEWORK_RANDOMSEEDSERVICE_H_
+
+// STL
+#include <cstdint>
+#include <string>
+
+namespace ldmx {
+
+    /**
+     * @class RandomSeedService
+     * @brief Derives the key of the random number stream of each event processor in each event.
+     *
+     * @note The key is a hash of the seed root of the process, the name of
+     * the processor and the run and event numbers.  The random numbers drawn
+     * by a processor for an event therefore only depend on the event itself,
+     * and not on the events processed before it or on the thread which
+     * processes it, so a pass can be repeated event by event.
+     */
+    class RandomSeedService {
+
+        public:
+
+            /**
+             * Set the root from which all keys of this process are derived.
+             * @param seedRoot The seed root.
+             */
+            void setSeedRoot(int seedRoot) {
+                seedRoot_ = seedRoot;
+            }
+
+            /**
+             * Get the root from which all keys of this process are derived.
+             * @return The seed root.
+             */
+            int getSeedRoot() const {
+                return seedRoot_;
+            }
+
+            /**
+             * Get the key of the random number stream of a processor for an event.
+             * @param name The name of the processor.
+             * @param run The run number of the event.
+             * @param event The event number.
+             * @return The key of the stream.
+             */
+            uint64_t getStreamKey(const std::string& name, int run, int event) const;
+
+        private:
+
+            /** The root from which all keys are derived. */
+            int seedRoot_{0};
+    };
+}
+
+#endif
@@ -7,6 +7,7 @@
 #ifndef FRAMEWORK_STORAGECONTROL_H_
 #define FRAMEWORK_STORAGECONTROL_H_
 
+#include <memory>
 #include <string>
 #include <vector>
 
@@ -30,11 +31,27 @@ namespace ldmx {
      * StorageControl object until the end of the event.  At that
      * point, the process queries the StorageControl to determine if
      * the event should be stored in the output file.
+     *
+     * @note
+     * Each combination of processor name and purpose string is interned
+     * once into an integer hint ID, shared by all StorageControl objects of
+     * the job.  The skim rules are matched against each hint ID only once,
+     * giving a table of the number of rules which listen to it, so that
+     * deciding on an event only sums up the votes of its hints.
      */
     class StorageControl {
 
         public:
 
+            /**
+             * Get the ID for hints from the given processor with the given purpose,
+             * registering it if it is new.
+             * @param processor_name Name of the event processor
+             * @param purposeString A purpose string which can be used in the skim control configuration
+             * @return The hint ID
+             */
+            static int getHintID(const std::string& processor_name, const std::string& purposeString);
+
             /** Set the default state */
             void setDefaultKeep(bool keep) { defaultIsKeep_=keep; }
 
@@ -51,6 +68,19 @@ namespace ldmx {
              */
             void addHint(const std::string& processor_name, ldmx::StorageControlHint hint, const std::string& purposeString);
 
+            /** 
+             * Add a storage hint using a hint ID from getHintID()
+             * @param hintID The ID of the processor and purpose giving the hint
+             * @param controlhint The storage control hint to apply for the given event
+             */
+            void addHint(int hintID, ldmx::StorageControlHint hint);
+
+            /**
+             * Append the hints collected by another storage controller for the current event
+             * @param other Storage controller (e.g. of a worker thread) holding the hints
+             */
+            void addHints(const StorageControl& other);
+
             /** 
              * Add a rule
              * @param processor_pattern Regex pattern to compare with event processor
@@ -58,11 +88,22 @@ namespace ldmx {
              */
             void addRule(const std::string& processor_pat, const std::string& purpose_pat);
 
+            /**
+             * Match the rules against all hint IDs registered so far.  IDs registered
+             * later are matched the first time they are seen in keepEvent().
+             */
+            void compileRules();
+
             /** Determine if the current event should be kept, based on the defined rules */
             bool keepEvent() const;
     
         private:
 
+            /**
+             * Extend the table of rule matches to all registered hint IDs.
+             */
+            void updateMatches() const;
+
             /**
              * Default state for storage control
              */
@@ -73,17 +114,13 @@ namespace ldmx {
              */
             struct Hint {
                 /** 
-                 * Event Processor name
+                 * ID of the event processor and purpose string
                  */
-                std::string evpName_;
+                int id_;
                 /**
                  * Hint level
                  */
                 StorageControlHint hint_;
-                /**
-                 * Purpose string, if used
-                 */
-                std::string purpose_;
             };
     
             /** 
@@ -93,12 +130,10 @@ namespace ldmx {
 
             /** 
              * Structure to hold rules
-             *
-             * Eventually need a cleanup function to remove the compiled regex buffers, but only in the _StorageControl_ destructor, not during regular vector operations.
              */
             struct Rule {
 
-                bool matches(const Hint& h);
+                bool matches(const std::string& evpName, const std::string& purpose) const;
                 
                 /** 
                  * Event Processor Regex
@@ -113,18 +148,23 @@ namespace ldmx {
                 /** 
                  * Compiled event processor regex
                  */
-                void* evpNameRegex_{0};
+                std::shared_ptr<void> evpNameRegex_;
 
                 /** 
-                 * Compiled event processor regex
+                 * Compiled purpose string regex, empty to match any purpose
                  */
-                void* purposeRegex_{0};        
+                std::shared_ptr<void> purposeRegex_;
             };
             
             /** 
-             * Collection of hints from the event processors
+             * Collection of rules from the configuration
              */
             std::vector<Rule> rules_;
+
+            /**
+             * Number of rules matching each hint ID
+             */
+            mutable std::vector<int> ruleMatches_;
     };
 }
 
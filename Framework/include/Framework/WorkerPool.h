@@ -0,0 +1,166 @@
+/**
+ * @file WorkerPool.h
+ * @brief Class which runs the clone-safe head of the processor sequence on worker threads
+ */
+
+#ifndef FRAMEWORK_WORKERPOOL_H_
+#define FRAMEWORK_WORKERPOOL_H_
+
+// ROOT
+#include "Rtypes.h"
+
+// LDMX
+#include "Framework/ProcessorDispatch.h"
+#include "Framework/StorageControl.h"
+
+// STL
+#include <condition_variable>
+#include <exception>
+#include <map>
+#include <memory>
+#include <mutex>
+#include <string>
+#include <thread>
+#include <vector>
+
+namespace ldmx {
+
+    class EventFile;
+    class EventImpl;
+    class Process;
+
+    /**
+     * @class WorkerPool
+     * @brief Runs the clone-safe head of the processor sequence on a set of worker threads
+     *
+     * @note
+     * Each worker owns an EventFile opened on the current input file, an
+     * EventImpl and its own copy of the parallel processors.  Workers claim
+     * input entries in increasing order, process them and then wait until
+     * the main thread has finished with their event.  The main thread collects
+     * events strictly in entry order, so the output tree is filled in the
+     * same order as in a single-threaded job.  The main event borrows the
+     * products of the worker, so each input entry is read only once.
+     */
+    class WorkerPool {
+
+        public:
+
+            /**
+             * Class constructor.
+             * @param process The Process which owns the pool.
+             * @param processors One list of processors for each worker thread.  The
+             * processors are not owned by the pool.
+             */
+            WorkerPool(Process& process, const std::vector<std::vector<ProcessorDispatch> >& processors);
+
+            /**
+             * Class destructor, stops any running workers.
+             */
+            ~WorkerPool();
+
+            /**
+             * Get the number of worker threads.
+             * @return The number of workers.
+             */
+            unsigned int getNumWorkers() const {
+                return workers_.size();
+            }
+
+            /**
+             * Open the input file of the main thread in every worker and start processing.
+             * The workers read the same branches as the main thread.
+             * @param input The input file of the main thread.
+             * @param maxEntries Maximum number of entries to process from this file.
+             * @param readAllBranches True to read all active branches in the workers,
+             * for writing them to an output file.
+             */
+            void startFile(EventFile& input, Long64_t maxEntries, bool readAllBranches);
+
+            /**
+             * Wait for the next event in entry order and lend its products to the
+             * main event, and copy its storage hints.  The worker of the previous
+             * event, which must have been written, moves on to a new entry.
+             * @param target The event being filled on the main thread.
+             * @param storage The storage controller of the main thread.
+             * @throw Exception rethrown from a worker thread, if any.
+             */
+            void collect(EventImpl& target, StorageControl& storage);
+
+            /**
+             * Stop the workers and close their copies of the input file.
+             */
+            void stopFile();
+
+        private:
+
+            /**
+             * @struct Worker
+             * @brief State owned by a single worker thread
+             */
+            struct Worker {
+
+                /** The processors run by this worker. */
+                std::vector<ProcessorDispatch> processors_;
+
+                /** This worker's handle on the input file. */
+                std::unique_ptr<EventFile> file_;
+
+                /** The event buffer of this worker. */
+                std::unique_ptr<EventImpl> event_;
+
+                /** Storage hints set by this worker's processors for the current event. */
+                StorageControl storage_;
+
+                /** The run number of the last event processed. */
+                int wasRun_{-1};
+
+                /** The thread. */
+                std::thread thread_;
+            };
+
+            /**
+             * Event loop of a single worker thread.
+             * @param worker The worker state.
+             */
+            void work(Worker& worker);
+
+            /** Handle to the Process. */
+            Process& process_;
+
+            /** The workers. */
+            std::vector<std::unique_ptr<Worker> > workers_;
+
+            /** Lock protecting the bookkeeping below. */
+            std::mutex mutex_;
+
+            /** Signalled when an event is ready or has been released. */
+            std::condition_variable cv_;
+
+            /** Next entry to be claimed by a worker. */
+            Long64_t nextEntry_{0};
+
+            /** Next entry to be collected by the main thread. */
+            Long64_t nextCollect_{0};
+
+            /** Entries below this one are no longer used by the main thread. */
+            Long64_t released_{0};
+
+            /** Number of entries to process in the current file. */
+            Long64_t maxEntries_{0};
+
+            /** Workers holding a finished event, by entry. */
+            std::map<Long64_t, Worker*> ready_;
+
+            /** First exception thrown on a worker thread. */
+            std::exception_ptr error_;
+
+            /** True if the workers read all active branches of each entry. */
+            bool readAllBranches_{false};
+
+            /** Set when the workers should stop. */
+            bool stop_{false};
+    };
+}
+
+#endif
@@ -9,6 +9,8 @@ class Producer:
         self.className=className
         self.parameters=dict()
         self.histograms=[]
+        self.enabled=True
+        self.prescale=1
 
     def build1DHistogram(self, name, xlabel, bins, xmin, xmax):
         self.histograms.append(h.histogram1D(name, xlabel, bins, xmin, xmax))
@@ -19,6 +21,8 @@ class Producer:
 
     def printMe(self,prex):
         print "%sProducer(%s of class %s)"%(prex,self.instanceName,self.className)
+        if not self.enabled: print "%s Disabled"%(prex)
+        elif self.prescale>1: print "%s Prescale: %d"%(prex,self.prescale)
         if len(self.parameters)>0:
             print "%s Parameters:"%(prex)
             for k, v in self.parameters.items():
@@ -36,6 +40,8 @@ class Analyzer:
         self.className=className
         self.parameters=dict()
         self.histograms=[]
+        self.enabled=True
+        self.prescale=1
    
     def build1DHistogram(self, name, xlabel, bins, xmin, xmax):
         self.histograms.append(h.histogram1D(name, xlabel, bins, xmin, xmax))
@@ -46,6 +52,8 @@ class Analyzer:
     
     def printMe(self,prex):
         print "%sAnalyzer(%s of class %s)"%(prex,self.instanceName,self.className)        
+        if not self.enabled: print "%s Disabled"%(prex)
+        elif self.prescale>1: print "%s Prescale: %d"%(prex,self.prescale)
         if len(self.parameters)>0:
             print "%s Parameters:"%(prex)
             for k, v in self.parameters.items():
@@ -67,10 +75,14 @@ class Process:
         self.outputFiles=[]
         self.sequence=[]
         self.keep=[]
+        self.inputCollections=[]
         self.libraries=[]
         self.skimDefaultIsKeep=True
         self.skimRules=[]
         self.logFrequency=-1
+        self.numThreads=1
+        self.randomSeed=0
+        self.profile=False
         Process.lastProcess=self
 
     def skimDefaultIsSave(self):
@@ -92,6 +104,9 @@ class Process:
         if (self.run>0): print " using run number %d"%(self.run)
         if (self.maxEvents>0): print " Maximum events to process: %d"%(self.maxEvents)
         else: " No limit on maximum events to process"
+        if (self.numThreads>1): print " Using %d threads for clone-safe processors"%(self.numThreads)
+        print " Random number seed root: %d"%(self.randomSeed)
+        if self.profile: print " Measuring the resource usage of the processors"
         print "Processor sequence:"
         for proc in self.sequence:
             proc.printMe("  ")
@@ -116,6 +131,10 @@ class Process:
                 print " Listen to hints from processors with names matching '%s'"%(self.skimRules[i])
             else:
                 print " Listen to hints with labels matching '%s' from processors with names matching '%s'"%(self.skimRules[i+1],self.skimRules[i])
+        if len(self.inputCollections) > 0:
+            print "Only reading the input collections:"
+            for acoll in self.inputCollections:
+                print "   %s"%(acoll)
         if len(self.keep) > 0:
             print "Rules for keeping previous products:"
             for arule in self.keep:
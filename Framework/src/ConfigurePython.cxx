@@ -92,6 +92,15 @@ namespace ldmx {
         // Get the print frequency
         logFrequency_ = intMember(pProcess, "logFrequency"); 
 
+        // Get the number of event processing threads
+        numThreads_ = intMember(pProcess, "numThreads");
+
+        // Get the root of the random number seeds
+        randomSeed_ = intMember(pProcess, "randomSeed");
+
+        // Check if the calls of the processors should be measured
+        profile_ = intMember(pProcess, "profile");
+
         PyObject* pysequence = PyObject_GetAttrString(pProcess, "sequence");
         if (!PyList_Check(pysequence)) {
             EXCEPTION_RAISE("ConfigureError", "sequence is not a python list as expected.");
@@ -102,6 +111,8 @@ namespace ldmx {
             ProcessorInfo pi;
             pi.classname_ = stringMember(processor, "className");
             pi.instancename_ = stringMember(processor, "instanceName");
+            if (PyObject_HasAttrString(processor, "enabled")) pi.enabled_ = intMember(processor, "enabled");
+            if (PyObject_HasAttrString(processor, "prescale")) pi.prescale_ = intMember(processor, "prescale");
 
             PyObject* histos = PyObject_GetAttrString(processor, "histograms");
             
@@ -177,6 +188,17 @@ namespace ldmx {
         }
         Py_DECREF(pylist);
 
+        pylist = PyObject_GetAttrString(pProcess, "inputCollections");
+        if (!PyList_Check(pylist)) {
+            std::cerr << "inputCollections is not a python list as expected.\n";
+            return;
+        }
+        for (Py_ssize_t i = 0; i < PyList_Size(pylist); i++) {
+            PyObject* elem = PyList_GetItem(pylist, i);
+            inputCollections_.push_back(PyString_AsString(elem));
+        }
+        Py_DECREF(pylist);
+
         skimDefaultIsKeep_=intMember(pProcess, "skimDefaultIsKeep");
         pylist = PyObject_GetAttrString(pProcess, "skimRules");
         if (!PyList_Check(pylist)) {
@@ -233,6 +255,9 @@ namespace ldmx {
         p->setHistogramFileName(histoOutFile_);
         p->setEventLimit(eventLimit_);
         p->setLogFrequency(logFrequency_); 
+        p->setNumThreads(numThreads_);
+        p->setRandomSeedRoot(randomSeed_);
+        p->setProfiling(profile_);
 
         for (auto lib : libraries_) {
             EventProcessorFactory::getInstance().loadLibrary(lib);
@@ -245,14 +270,13 @@ namespace ldmx {
             }
             
             if (!proc.histograms_.empty()) {
-                HistogramPool* histograms = HistogramPool::getInstance(); 
                 ep->getHistoDirectory();
                 for (const auto& hist : proc.histograms_) { 
-                    histograms->create<TH1F>(hist.name_, hist.xLabel_, hist.bins_, hist.xmin_, hist.xmax_); 
+                    ep->getHistograms().create<TH1F>(hist.name_, hist.xLabel_, hist.bins_, hist.xmin_, hist.xmax_); 
                 } 
             }
             ep->configure(proc.params_);
-            p->addToSequence(ep);
+            p->addToSequence(ep, proc.classname_, proc.params_, proc.enabled_, proc.prescale_);
         }
         for (auto file : inputFiles_) {
             p->addFileToProcess(file);
@@ -263,6 +287,9 @@ namespace ldmx {
         for (auto rule : keepRules_) {
             p->addDropKeepRule(rule);
         }
+        for (auto collection : inputCollections_) {
+            p->addInputCollection(collection);
+        }
         p->getStorageController().setDefaultKeep(skimDefaultIsKeep_);
         for (size_t i=0; i<skimRules_.size(); i+=2) {
             p->getStorageController().addRule(skimRules_[i],skimRules_[i+1]);
@@ -6,7 +6,6 @@
 
 // ROOT
 #include "TClonesArray.h"
-#include "TRandom.h"
 
 // LDMX
 #include "Event/SimParticle.h"
@@ -74,7 +73,6 @@ namespace ldmx {
             int nParticles_{0};
             double aveEnergy_{0};
             std::vector<double> direction_;
-            TRandom random_;
     };
 
 }
@@ -5,6 +5,9 @@
 #include "Event/EventConstants.h"
 #include "Event/RunHeader.h"
 
+// STL
+#include <iostream>
+
 namespace ldmx {
 
     EventFile::EventFile(const std::string& filename, std::string treeName, bool isOutputFile, int compressionLevel) :
@@ -141,7 +144,13 @@ namespace ldmx {
         if (ientry_ >= 0) {
             if (isOutputFile_) {
                 event_->beforeFill();
-                if (storeCurrentEvent) tree_->Fill(); // fill the clones...
+                if (storeCurrentEvent) {
+                    // borrowed input products are written from the tree of the event which read them
+                    TTree* lenderTree = event_->getLenderTree();
+                    if (lenderTree) lenderTree->CopyAddresses(tree_);
+                    else if (parent_) readRemainingBranches();
+                    tree_->Fill(); // fill the clones...
+                }
             }
             if (event_) {
                 event_->Clear();
@@ -153,7 +162,7 @@ namespace ldmx {
             if (!parent_->nextEvent()) {
                 return false;
             }
-            parent_->tree_->GetEntry(parent_->ientry_);
+            // input branches are read on demand, see EventImpl::getReal
             ientry_ = parent_->ientry_;
             event_->nextEvent();
             entries_++;
@@ -185,6 +194,76 @@ namespace ldmx {
         return false;
     }
 
+    bool EventFile::readEntry(Long64_t ientry) {
+
+        if (isOutputFile_ || parent_) {
+            EXCEPTION_RAISE("EventFile", "Random access is only supported for input files");
+        }
+
+        if (ientry_ >= 0 && event_) {
+            event_->Clear();
+            event_->onEndOfEvent();
+        }
+
+        if (ientry < 0 || ientry >= entries_) {
+            return false;
+        }
+
+        ientry_ = ientry;
+        tree_->LoadTree(ientry_);
+
+        if (event_) {
+            event_->setEntry(ientry_);
+        }
+        return true;
+    }
+
+    void EventFile::selectInputCollections(const std::vector<std::string>& collections) {
+
+        if (isOutputFile_ || !tree_) {
+            EXCEPTION_RAISE("EventFile", "Input collections can only be selected on an input file");
+        }
+
+        tree_->SetBranchStatus("*", 0);
+        tree_->SetBranchStatus((EventConstants::EVENT_HEADER + "*").c_str(), 1);
+
+        for (auto collection : collections) {
+            // without a pass name, read the collection from all passes
+            if (collection.find('_') == std::string::npos) collection += '_';
+            if (collection.back() != '*') collection += '*';
+            UInt_t found = 0;
+            tree_->SetBranchStatus(collection.c_str(), 1, &found);
+            if (found == 0) {
+                std::cout << "[ EventFile ] : [WARNING] No branch matching '" << collection << "' in " << fileName_ << std::endl;
+            }
+        }
+    }
+
+    void EventFile::selectBranches(EventFile& other) {
+
+        if (isOutputFile_ || !tree_ || !other.tree_) {
+            EXCEPTION_RAISE("EventFile", "Branches can only be selected on an input file");
+        }
+
+        tree_->SetBranchStatus("*", 0);
+
+        TObjArray* branches = other.tree_->GetListOfBranches();
+        for (int i = 0; i < branches->GetEntriesFast(); i++) {
+            TBranch* branch = (TBranch*) branches->UncheckedAt(i);
+            if (branch->TestBit(kDoNotProcess)) continue;
+            tree_->SetBranchStatus((std::string(branch->GetName()) + "*").c_str(), 1);
+        }
+    }
+
+    void EventFile::readRemainingBranches() {
+        TObjArray* branches = parent_->tree_->GetListOfBranches();
+        for (int i = 0; i < branches->GetEntriesFast(); i++) {
+            TBranch* branch = (TBranch*) branches->UncheckedAt(i);
+            if (branch->GetReadEntry() == ientry_ || !parent_->tree_->GetBranchStatus(branch->GetName())) continue;
+            branch->GetEntry(ientry_);
+        }
+    }
+
     void EventFile::setupEvent(EventImpl* evt) {
         event_ = evt;
         if (isOutputFile_) {
@@ -249,6 +328,27 @@ namespace ldmx {
         runTree->Write();
     }
 
+    void EventFile::updateRunHeaders(const std::function<void(RunHeader&)>& update) {
+        if (!isOutputFile_) {
+            EXCEPTION_RAISE("FileError", "Output file '" + fileName_ + "' is not writable.");
+        }
+        if (runMap_.empty()) return;
+
+        // replace the run header tree copied from the parent
+        file_->cd();
+        file_->Delete("LDMX_Run;*");
+        TTree* runTree = new TTree("LDMX_Run", "LDMX run header");
+        RunHeader* runHeader = runMap_.begin()->second;
+        runTree->Branch("RunHeader", EventConstants::RUN_HEADER.c_str(), &runHeader, 32000, 3);
+        for (auto& entry : runMap_) {
+            update(*entry.second);
+            runHeader = entry.second;
+            runTree->Fill();
+        }
+        runTree->Write();
+        runTree->ResetBranchAddresses();
+    }
+
     const RunHeader& EventFile::getRunHeader(int runNumber) {
         if (runMap_.find(runNumber) != runMap_.end()) {
             return *(runMap_[runNumber]);
@@ -31,14 +31,10 @@ namespace ldmx {
 
         std::string branchName = makeBranchName(collectionName);
 
-        if (branchesFilled_.find(branchName) != branchesFilled_.end()) {
-            EXCEPTION_RAISE("ProductExists", "A product named '" + collectionName + "' already exists in the event (has been loaded by a previous producer in this process.");
-        }
-        branchesFilled_.insert(branchName);
-
-        std::map<std::string, TObject*>::iterator ito = objects_.find(branchName);
+        std::map<std::string, Product>::iterator ito = objects_.find(branchName);
         if (ito == objects_.end()) { // create a new branch
-            ito = objects_.insert(std::pair<std::string, TObject*>(branchName, tca)).first;
+            ito = objects_.insert(std::pair<std::string, Product>(branchName, Product())).first;
+            ito->second.object_ = tca;
             if (outputTree_ != 0) {
                 TBranch *outBranch = outputTree_->GetBranch( branchName.c_str() );
                 if ( outBranch ) {
@@ -54,7 +50,11 @@ namespace ldmx {
 	    if (!tcaContains.empty()) tcaContains.pop_back();
 	    products_.push_back(ProductTag(collectionName,passName_,"TClonesArray("+tcaContains+")"));
             branchNames_.push_back(branchName);
-            knownLookups_.clear(); // have to invalidate this cache
+            invalidateLookups(); // have to invalidate these caches
+        }
+
+        if (!markFilled(ito->second)) {
+            EXCEPTION_RAISE("ProductExists", "A product named '" + collectionName + "' already exists in the event (has been loaded by a previous producer in this process.");
         }
     }
 
@@ -69,66 +69,168 @@ namespace ldmx {
         if (collectionName==EventConstants::EVENT_HEADER) branchName=collectionName;
         else branchName = makeBranchName(collectionName);
 
-        if (branchesFilled_.find(branchName)!=branchesFilled_.end()) {
+        std::map<std::string, Product>::iterator ito = objects_.find(branchName);
+        Product& product = (ito == objects_.end()) ? addOwnedObject(collectionName, branchName, to->Clone()) : ito->second;
+
+        if (!markFilled(product)) {
             EXCEPTION_RAISE("ProductExists","A product named '"+collectionName+"' already exists in the event (has been loaded by a previous producer in this process.");
         }
-        branchesFilled_.insert(branchName);
-
-        std::map<std::string, TObject*>::iterator ito = objects_.find(branchName);
+        to->Copy(*product.object_);
+    }
 
-        if (ito == objects_.end()) { // create a new branch
-            TObject* myCopy = to->Clone();
-            ito = objects_.insert(std::pair<std::string, TObject*>(branchName, myCopy)).first;
-            objectsOwned_.insert(std::pair<std::string, TObject*>(branchName, myCopy));
-            if (outputTree_ != 0) {
-                //outputTree_ exists
-                TBranch* outBranch = outputTree_->GetBranch( branchName.c_str() );
-                if ( outBranch ) {
-                    //branch already exists on output Tree
-                    outBranch->SetAddress( &to );
-                } else {
-                    //branch doesn't exist on tree yet
-                    outBranch = outputTree_->Branch(branchName.c_str(), myCopy);
-                }
-                newBranches_.push_back(outBranch);
+    EventImpl::Product& EventImpl::addOwnedObject(const std::string& collectionName, const std::string& branchName, TObject* object) {
+        Product& product = objects_[branchName];
+        product.object_ = object;
+        objectsOwned_.insert(std::pair<std::string, TObject*>(branchName, object));
+        if (outputTree_ != 0) {
+            //outputTree_ exists
+            TBranch* outBranch = outputTree_->GetBranch( branchName.c_str() );
+            if ( outBranch ) {
+                //branch already exists on output Tree
+                outBranch->SetAddress( &product.object_ );
+            } else {
+                //branch doesn't exist on tree yet
+                outBranch = outputTree_->Branch(branchName.c_str(), object);
             }
-	    products_.push_back(ProductTag(collectionName,passName_,to->Class()->GetName()));
-            branchNames_.push_back(branchName);
-            knownLookups_.clear(); // have to invalidate this cache
+            newBranches_.push_back(outBranch);
         }
-        to->Copy(*ito->second);
+        products_.push_back(ProductTag(collectionName,passName_,object->IsA()->GetName()));
+        branchNames_.push_back(branchName);
+        invalidateLookups(); // have to invalidate these caches
+        return product;
     }
 
+    TObject* EventImpl::emplaceReal(const std::string& name, TClass* type) {
+
+        if (name.find('_') != std::string::npos) {
+            EXCEPTION_RAISE("IllegalName", "The product name '" + name + "' is illegal as it contains an underscore.");
+        }
 
-    void EventImpl::addToCollection(const std::string& name, const TObject& obj) {
         std::string branchName;
-        if (name == EventConstants::EVENT_HEADER) return; // no adding to the event header...
-        branchName = makeBranchName(name);
+        if (name == EventConstants::EVENT_HEADER) branchName = name;
+        else branchName = makeBranchName(name);
+
+        // the object is made once and then reused by each event, so nothing is copied
+        std::map<std::string, Product>::iterator ito = objects_.find(branchName);
+        if (ito == objects_.end()) {
+            addOwnedObject(name, branchName, static_cast<TObject*>(type->New()));
+            ito = objects_.find(branchName);
+        } else if (ito->second.object_->IsA() != type) {
+            EXCEPTION_RAISE("ProductProblem", "Attempted to emplace the product '" + name + "' with the class " + type->GetName() + " instead of " + ito->second.object_->ClassName() + ".");
+        }
+
+        if (!markFilled(ito->second)) {
+            EXCEPTION_RAISE("ProductExists", "A product named '" + name + "' already exists in the event (has been loaded by a previous producer in this process.");
+        }
+        ito->second.object_->Clear();
+        return ito->second.object_;
+    }
+
+    TObject* EventImpl::emplaceToCollectionReal(const std::string& name, TClass* type) {
+        std::string branchName = makeBranchName(name);
 
+        TClonesArray* tca{nullptr};
         auto location = objectsOwned_.find(branchName);
         if (location == objectsOwned_.end()) {
             //TCA not found in existing objects
-            TClonesArray* tca = new TClonesArray(obj.ClassName(), 100);
+            tca = new TClonesArray(type, 100);
             objectsOwned_[branchName] = tca;
             add(name, tca);
-            //copy object into TCA
-            TObject* to = tca->ConstructedAt(0);
-            obj.Copy(*to);
         } else {
-            TClonesArray* ptca = dynamic_cast<TClonesArray*>(location->second);
-            if (ptca == 0) {
+            tca = dynamic_cast<TClonesArray*>(location->second);
+            if (tca == 0) {
                 EXCEPTION_RAISE("ProductProblem", "Attempted to add to the collection '" + name + "' which is not a TClonesArray.");
             }
-            if (ptca->At(0)->Class() != obj.Class()) {
+            if (tca->GetClass() != type) {
                 EXCEPTION_RAISE("ProductProblem", "Attempted to add object of different class to the collection '" + name + "'");
             }
-            TObject* to = ptca->ConstructedAt(ptca->GetEntriesFast());
-            obj.Copy(*to);
+            // further objects in the same event are allowed
+            objects_.find(branchName)->second.filled_ = fillGeneration_;
+        }
+
+        // the elements are cleared at the end of each event and constructed in place
+        return tca->ConstructedAt(tca->GetEntriesFast());
+    }
+
+    std::string EventImpl::getAddName(int token) const {
+        std::pair<std::string, std::string> name = getTokenName(token);
+        if (!name.second.empty() && name.second != passName_) {
+            EXCEPTION_RAISE("IllegalPass", "The product '" + name.first + "' can only be added with the current pass '" + passName_ + "', not '" + name.second + "'.");
         }
+        return name.first;
+    }
+
+    void EventImpl::add(int token, TClonesArray* tca) {
+        TokenSlot& slot = getSlot(token);
+        if (!slot.add_) {
+            std::string collectionName = getAddName(token);
+            add(collectionName, tca);
+            slot.add_ = &objects_.find(makeBranchName(collectionName))->second;
+        } else if (!markFilled(*slot.add_)) {
+            EXCEPTION_RAISE("ProductExists", "A product named '" + getAddName(token) + "' already exists in the event (has been loaded by a previous producer in this process.");
+        }
+    }
+
+    void EventImpl::add(int token, TObject* to) {
+        TokenSlot& slot = getSlot(token);
+        if (!slot.add_) {
+            std::string collectionName = getAddName(token);
+            add(collectionName, to);
+            slot.add_ = &objects_.find(collectionName == EventConstants::EVENT_HEADER ? collectionName : makeBranchName(collectionName))->second;
+            return;
+        }
+        if (!markFilled(*slot.add_)) {
+            EXCEPTION_RAISE("ProductExists", "A product named '" + getAddName(token) + "' already exists in the event (has been loaded by a previous producer in this process.");
+        }
+        to->Copy(*slot.add_->object_);
+    }
+
+
+    void EventImpl::addToCollection(const std::string& name, const TObject& obj) {
+        if (name == EventConstants::EVENT_HEADER) return; // no adding to the event header...
+        obj.Copy(*emplaceToCollectionReal(name, obj.IsA()));
     }
 
 
     const TObject* EventImpl::getReal(const std::string& collectionName, const std::string& passName, bool mustExist) const {
+        Product* product = findProduct(collectionName, passName, mustExist);
+        return product ? read(*product) : nullptr;
+    }
+
+    const TObject* EventImpl::getReal(int token, bool mustExist) const {
+        TokenSlot& slot = getSlot(token);
+        if (!slot.getResolved_) {
+            std::pair<std::string, std::string> name = getTokenName(token);
+            slot.get_ = findProduct(name.first, name.second, false);
+            slot.getResolved_ = true;
+        }
+        if (slot.get_) return read(*slot.get_);
+        if (!mustExist) return nullptr;
+
+        // look the name up again to report why it is missing
+        std::pair<std::string, std::string> name = getTokenName(token);
+        findProduct(name.first, name.second, true);
+        EXCEPTION_RAISE("ProductNotFound", "No product found for name '" + name.first + "' and pass '" + name.second + "'");
+    }
+
+    EventImpl::TokenSlot& EventImpl::getSlot(int token) const {
+        if (token < 0) {
+            EXCEPTION_RAISE("InvalidToken", "Event tokens can not be negative.");
+        }
+        if (token >= int(tokenSlots_.size())) tokenSlots_.resize(token + 1);
+        return tokenSlots_[token];
+    }
+
+    TObject* EventImpl::read(Product& product) const {
+        // input branches are only read the first time they are requested in an event
+        if (product.branch_ && product.read_ != readGeneration_) {
+            product.branch_->GetEntry(ientry_);
+            product.read_ = readGeneration_;
+        }
+        return product.object_;
+    }
+
+    EventImpl::Product* EventImpl::findProduct(const std::string& collectionName, const std::string& passName, bool mustExist) const {
 
         std::string branchName;
         if (collectionName== EventConstants::EVENT_HEADER) branchName=collectionName;
@@ -164,63 +266,46 @@ namespace ldmx {
         }
 
 
-        std::map<std::string, TBranch*>::const_iterator itb = branches_.find(branchName);
-
-        // check the objects map
-        std::map<std::string, TObject*>::const_iterator ito = objects_.find(branchName);
-        if (ito != objects_.end()) {
-           if (itb!=branches_.end())
-              itb->second->GetEntry(ientry_);
-           return ito->second;
-        } else if (inputTree_ == 0) {
+        Product* product = findBranch(branchName);
+        if (product == 0) {
+            if (!mustExist)
+                return nullptr;
             EXCEPTION_RAISE("ProductNotFound", "No product found for name '" + collectionName + "' and pass '" + passName_ + "'");
         }
+        return product;
+    }
 
-        // find the active branch and update if necessary
-        if (itb != branches_.end()) {
-
-            std::map<std::string, TObject*>::iterator ito = objects_.find(branchName);
-
-            // update buffers if needed
-            if (itb->second->GetReadEntry() != ientry_) {
-
-                TBranchElement* tbe = dynamic_cast<TBranchElement*>(itb->second);
-                if (!tbe)
-                    itb->second->SetAddress(ito->second);
-                int nr = itb->second->GetEntry(ientry_, 1);
-            }
-
-            // check the objects map
+    EventImpl::Product* EventImpl::findBranch(const std::string& branchName) const {
 
-            if (ito != objects_.end())
-                return ito->second;
+        // check the objects map, an input product which was only borrowed has no branch yet
+        std::map<std::string, Product>::iterator ito = objects_.find(branchName);
+        if (ito != objects_.end() && (ito->second.object_ || ito->second.branch_)) {
+            return &ito->second;
+        }
 
-            // this case is hard to achieve
-            return 0;
+        // ok, maybe we've not loaded this yet, look for a branch
+        TBranch* branch = inputTree_ ? inputTree_->GetBranch(branchName.c_str()) : nullptr;
+        if (branch == 0) {
+            return nullptr;
+        }
+        // ooh, new branch!
+        TObject* top(0);
+        branch->SetAutoDelete(false);
+        branch->SetStatus(1);
+        branch->GetEntry((ientry_<0)?(0):(ientry_));
+        TBranchElement* tbe = dynamic_cast<TBranchElement*>(branch);
+        if (tbe) {
+            top = (TObject*) tbe->GetObject();
         } else {
+            branch->SetAddress(&top);
+        }
 
-            // ok, maybe we've not loaded this yet, look for a branch
-            TBranch* branch = inputTree_->GetBranch(branchName.c_str());
-            if (branch == 0) {
-                EXCEPTION_RAISE("ProductNotFound", "No product found for name '" + collectionName + "' and pass '" + passName_ + "'");
-            }
-            // ooh, new branch!
-            TObject* top(0);
-            branch->SetAutoDelete(false);
-            branch->SetStatus(1);
-            branch->GetEntry((ientry_<0)?(0):(ientry_));
-            TBranchElement* tbe = dynamic_cast<TBranchElement*>(branch);
-            if (tbe) {
-                top = (TObject*) tbe->GetObject();
-            } else {
-                branch->SetAddress(&top);
-            }
-
-            branches_.insert(std::pair<std::string, TBranch*>(branchName, branch));
-            objects_.insert(std::pair<std::string, TObject*>(branchName, top));
+        Product& product = objects_[branchName];
+        product.object_ = top;
+        product.branch_ = branch;
+        product.read_ = readGeneration_;
 
-            return top;
-        }
+        return &product;
     }
 
     TTree* EventImpl::createTree() {
@@ -239,6 +324,7 @@ namespace ldmx {
         inputTree_ = tree;
         entries_ = inputTree_->GetEntriesFast();
         branchNames_.clear();
+        invalidateLookups();
 
 
 	products_.push_back(ProductTag(EventConstants::EVENT_HEADER,"","ldmx::EventHeader"));
@@ -263,26 +349,101 @@ namespace ldmx {
     }
 
     bool EventImpl::nextEvent() {
-        ientry_++;
-        eventHeader_=get<EventHeader*>(EventConstants::EVENT_HEADER);
+        return setEntry(ientry_ + 1);
+    }
+
+    bool EventImpl::setEntry(Long64_t ientry) {
+        ientry_ = ientry;
+        readGeneration_++;
+        // a borrowed header is set by borrowProducts()
+        if (borrowInput_) eventHeader_ = nullptr;
+        else eventHeader_=get<EventHeader*>(EventConstants::EVENT_HEADER);
         return true;
     }
 
+    void EventImpl::borrowProducts(EventImpl& lender) {
+        for (auto& entry : lender.objects_) {
+            const std::string& branchName = entry.first;
+            const Product& from = entry.second;
+            bool read = from.branch_ && from.read_ == lender.readGeneration_;
+            bool filled = from.filled_ == lender.fillGeneration_;
+            if (!read && !filled) continue;
+
+            std::map<std::string, Product>::iterator ito = objects_.find(branchName);
+            if (ito == objects_.end()) {
+                if (read) {
+                    // the names of the input branches are already known from the input tree
+                    ito = objects_.insert(std::pair<std::string, Product>(branchName, Product())).first;
+                } else {
+                    // product names cannot contain underscores, so the first one separates the pass
+                    std::string collectionName = branchName.substr(0, branchName.find('_'));
+
+                    // written while nothing is borrowed, so that events without the product store an empty one
+                    TClonesArray* tca = dynamic_cast<TClonesArray*>(from.object_);
+                    TObject* empty = tca ? new TClonesArray(tca->GetClass(), 100) : static_cast<TObject*>(from.object_->IsA()->New());
+                    addOwnedObject(collectionName, branchName, empty);
+                    ito = objects_.find(branchName);
+
+                    // the output branch follows the borrowed object through the address of the pointer
+                    if (outputTree_ != 0) outputTree_->GetBranch(branchName.c_str())->SetAddress(&ito->second.object_);
+                }
+            }
+
+            Product& product = ito->second;
+            if (filled && !markFilled(product)) {
+                EXCEPTION_RAISE("ProductExists", "A product named '" + branchName + "' already exists in the event (has been loaded by a previous producer in this process.");
+            }
+            if (read) product.read_ = readGeneration_;
+            if (!product.borrowed_) {
+                product.own_ = product.object_;
+                product.borrowed_ = true;
+            }
+            product.object_ = from.object_;
+        }
+
+        // an event which was not read from a file has no header to lend
+        if (lender.eventHeader_) eventHeader_ = lender.eventHeader_;
+        lenderTree_ = lender.inputTree_;
+    }
+
+    void EventImpl::readInputBranches() {
+        TObjArray* branches = inputTree_->GetListOfBranches();
+        for (int i = 0; i < branches->GetEntriesFast(); i++) {
+            TBranch* branch = (TBranch*) branches->UncheckedAt(i);
+            if (branch->TestBit(kDoNotProcess)) continue;
+            Product* product = findBranch(branch->GetName());
+            if (product) read(*product);
+        }
+    }
+
     void EventImpl::beforeFill() {
-        if (inputTree_==0 && branchesFilled_.find(EventConstants::EVENT_HEADER)==branchesFilled_.end()) {
+        if (inputTree_ != 0) return;
+        auto ito = objects_.find(EventConstants::EVENT_HEADER);
+        if (ito == objects_.end() || ito->second.filled_ != fillGeneration_) {
             add(EventConstants::EVENT_HEADER, eventHeader_);
         }
     }
 
     void EventImpl::Clear() {
-        // clear the event objects
-        for (auto obj : objects_)
-            obj.second->Clear("C");
-        branchesFilled_.clear();
-
+        // clear the event objects, borrowed objects are cleared by the event which lent them
+        for (auto& obj : objects_) {
+            Product& product = obj.second;
+            if (product.borrowed_) {
+                product.object_ = product.own_;
+                product.own_ = nullptr;
+                product.borrowed_ = false;
+            } else if (product.object_) {
+                product.object_->Clear("C");
+            }
+        }
+        lenderTree_ = nullptr;
+        fillGeneration_++;
+        readGeneration_++;
     }
+
     void EventImpl::onEndOfEvent() {
-        branchesFilled_.clear();
+        fillGeneration_++;
+        readGeneration_++;
     }
 
     void EventImpl::onEndOfFile() {
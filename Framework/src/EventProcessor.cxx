@@ -4,6 +4,7 @@
 #include "Framework/Process.h"
 #include "Framework/ParameterSet.h"
 #include "Framework/EventProcessorFactory.h"
+#include "Framework/RandomSeedService.h"
 #include "TDirectory.h"
 #include "Event/RunHeader.h"
 
@@ -11,6 +12,7 @@ namespace ldmx {
 
     EventProcessor::EventProcessor(const std::string& name, Process& process) :
         process_ (process ), name_ { name } {
+        storageHintID_ = StorageControl::getHintID(name_, "");
     }
 
     void EventProcessor::declare(const std::string& classname, int classtype,EventProcessorMaker* maker) {
@@ -20,7 +22,23 @@ namespace ldmx {
     void EventProcessor::setStorageHint(ldmx::StorageControlHint hint, const std::string& purposeString) {
         process_.getStorageController().addHint(name_,hint,purposeString);
     }
+
+    void EventProcessor::setStorageHint(ldmx::StorageControlHint hint, int hintID) {
+        process_.getStorageController().addHint(hintID,hint);
+    }
+
+    int EventProcessor::getStorageHintID(const std::string& purposeString) const {
+        return StorageControl::getHintID(name_, purposeString);
+    }
   
+    void EventProcessor::enableStatistics() {
+        if (!statistics_) statistics_.reset(new ProcessorStatistics(name_));
+    }
+
+    void EventProcessor::startRandomStream(const RandomSeedService& seeds, const EventHeader& header) {
+        random_.setKey(seeds.getStreamKey(name_, header.getRun(), header.getEventNumber()));
+    }
+
     TDirectory* EventProcessor::getHistoDirectory() {
         if (!histoDir_) {
             histoDir_=process_.makeHistoDirectory(name_);
@@ -1,6 +1,6 @@
 /**
  * @file HistogramPool.h
- * @brief Singleton class used to create and pool histograms.
+ * @brief Class used to create and pool the histograms of an event processor.
  * @author Omar Moreno, SLAC National Accelerator Laboratory
  */
 
@@ -9,6 +9,7 @@
 //----------------//
 //   C++ StdLib   //
 //----------------//
+#include <mutex>
 #include <stdexcept>
 
 //----------//
@@ -17,45 +18,72 @@
 #include "TH1.h"
 #include "TStyle.h"
 
-namespace ldmx { 
-
-    HistogramPool* HistogramPool::instance = nullptr;
+namespace ldmx {
 
     HistogramPool::HistogramPool() {
-        
-        gStyle->SetOptStat(0);
-        gStyle->SetGridColor(17);
-        gStyle->SetFrameBorderMode(0);
-        gStyle->SetTitleOffset(1.2, "yx");
-        gStyle->SetTitleFontSize(25);
-
-        gStyle->SetPadBottomMargin(0.1);
-        gStyle->SetPadTopMargin(0.01);
-        gStyle->SetPadLeftMargin(0.1);
-        gStyle->SetPadRightMargin(0.09);
-        gStyle->SetPadGridX(1);
-        gStyle->SetPadGridY(1);
-        gStyle->SetPadTickX(1);
-        gStyle->SetPadTickY(1);
-        
-        gStyle->SetHistLineWidth(2); 
+
+        // the style is global, so it only has to be set up by the first pool
+        static std::once_flag styleFlag;
+        std::call_once(styleFlag, []() {
+            gStyle->SetOptStat(0);
+            gStyle->SetGridColor(17);
+            gStyle->SetFrameBorderMode(0);
+            gStyle->SetTitleOffset(1.2, "yx");
+            gStyle->SetTitleFontSize(25);
+
+            gStyle->SetPadBottomMargin(0.1);
+            gStyle->SetPadTopMargin(0.01);
+            gStyle->SetPadLeftMargin(0.1);
+            gStyle->SetPadRightMargin(0.09);
+            gStyle->SetPadGridX(1);
+            gStyle->SetPadGridY(1);
+            gStyle->SetPadTickX(1);
+            gStyle->SetPadTickY(1);
+
+            gStyle->SetHistLineWidth(2);
+        });
 
     }
 
-    HistogramPool* HistogramPool::getInstance() { 
-        
-        // Create an instance of HistogramPool if needed
-        if (!instance) instance = new HistogramPool; 
+    HistogramPool::~HistogramPool() {
+
+        // otherwise the histograms belong to their directory
+        if (detached_) {
+            for (auto& histo : histograms_) delete histo.second;
+        }
+    }
+
+    void HistogramPool::insert(const std::string& name, TH1* hist) {
+        if (detached_) {
+            hist->SetDirectory(nullptr);
+            auto histo = histograms_.find(name);
+            if (histo != histograms_.end()) delete histo->second;
+        }
+        histograms_[name] = hist;
+    }
+
+    TH1* HistogramPool::get(const std::string& name) {
+        auto histo = histograms_.find(name);
+        if (histo == histograms_.end()) {
+            throw std::invalid_argument("Histogram " + name + " not found.");
+        }
+
+        return histo->second;
+    }
 
-        return instance; 
+    void HistogramPool::copyEmpty(const HistogramPool& other) {
+        detached_ = true;
+        TDirectory::TContext context(nullptr);
+        for (const auto& histo : other.histograms_) {
+            TH1* hist = static_cast<TH1*>(histo.second->Clone());
+            hist->Reset();
+            insert(histo.first, hist);
+        }
     }
 
-    TH1* HistogramPool::get(const std::string& name) { 
-        auto histo = histograms_.find(name); 
-        if (histo == histograms_.end()) { 
-            throw std::invalid_argument("Histogram " + name + " not found.");  
-        }  
-        
-        return histograms_[name];
+    void HistogramPool::merge(const HistogramPool& other) {
+        for (const auto& histo : other.histograms_) {
+            get(histo.first)->Add(histo.second);
+        }
     }
 }
@@ -3,6 +3,10 @@
 
 namespace ldmx {
 
+    bool ParameterSet::has(const std::string& name) const {
+        return elements_.find(name) != elements_.end();
+    }
+
     void ParameterSet::insert(const std::string& name, int value) {
         elements_[name] = Element(value);
     }
@@ -1,14 +1,21 @@
+#include <algorithm>
 #include <iostream>
+#include <memory>
 #include "TFile.h"
 #include "TROOT.h"
 #include "Framework/EventProcessor.h"
+#include "Framework/EventProcessorFactory.h"
 #include "Framework/EventImpl.h"
 #include "Framework/EventFile.h"
 #include "Framework/Process.h"
+#include "Framework/WorkerPool.h"
 #include "Event/RunHeader.h"
 
 namespace ldmx {
 
+    /** Storage controller used for hints made on the current worker thread. */
+    static thread_local StorageControl* threadStorageController = nullptr;
+
     Process::Process(const std::string& passname) :
             passname_ {passname} {
     }
@@ -18,22 +25,87 @@ namespace ldmx {
         try {
             int n_events_processed = 0;
 
+            // copies of the clone-safe head of the sequence for the worker threads
+            std::vector<std::unique_ptr<EventProcessor> > clones;
+            std::unique_ptr<WorkerPool> pool;
+
+            // number of leading processors which are run on the worker threads
+            size_t nParallel = 0;
+
+            if (numThreads_ > 1 && !inputFiles_.empty()) {
+                while (nParallel < sequence_.size() && recipes_[nParallel].valid_ && sequence_[nParallel]->isCloneSafe()) {
+                    nParallel++;
+                }
+
+                if (nParallel == 0) {
+                    std::cout << "[ Process ] : [WARNING] The first processor in the sequence is not clone-safe, running on a single thread." << std::endl;
+                } else {
+                    ROOT::EnableThreadSafety();
+
+                    // the first worker uses the configured processors, the others get fresh copies
+                    std::vector<std::vector<ProcessorDispatch> > workerProcessors;
+                    workerProcessors.emplace_back(dispatch_.begin(), dispatch_.begin() + nParallel);
+                    for (int ithread = 1; ithread < numThreads_; ithread++) {
+                        workerProcessors.emplace_back();
+                        for (size_t i = 0; i < nParallel; i++) {
+                            EventProcessor* clone = EventProcessorFactory::getInstance().createEventProcessor(recipes_[i].classname_, sequence_[i]->getName(), *this);
+                            if (clone == 0) {
+                                EXCEPTION_RAISE("UnableToCreate", "Unable to create copy of '" + sequence_[i]->getName() + "' of class '" + recipes_[i].classname_ + "'");
+                            }
+                            // the histograms of the copies are merged into the original ones at the end
+                            clone->getHistograms().copyEmpty(sequence_[i]->getHistograms());
+                            clone->configure(recipes_[i].parameters_);
+                            clones.emplace_back(clone);
+                            workerProcessors.back().emplace_back(clone, dispatch_[i].isEnabled(), dispatch_[i].getPrescale());
+                        }
+                    }
+                    pool.reset(new WorkerPool(*this, workerProcessors));
+
+                    std::cout << "[ Process ] : Running the first " << nParallel << " of " << sequence_.size()
+                              << " processors on " << numThreads_ << " threads" << std::endl;
+                }
+            } else if (numThreads_ > 1) {
+                std::cout << "[ Process ] : [WARNING] Multiple threads are only supported when reading input files, running on a single thread." << std::endl;
+            }
+
+            // match the skim rules against the hints registered by the processors
+            m_storageController.compileRules();
+
+            if (profile_) {
+                for (auto module : sequence_) {
+                    module->enableStatistics();
+                }
+                for (auto& clone : clones) {
+                    clone->enableStatistics();
+                }
+            }
+
             // first, notify everyone that we are starting
             for (auto module : sequence_) {
+                ProcessorStatistics::Scope scope(module->getStatistics(), ProcessorStatistics::PROCESS_START);
                 module->onProcessStart();
             }
+            for (auto& clone : clones) {
+                ProcessorStatistics::Scope scope(clone->getStatistics(), ProcessorStatistics::PROCESS_START);
+                clone->onProcessStart();
+            }
 
             // if we have no input files, but do have an event number, run for that number of events on an output file
             if (inputFiles_.empty() && eventLimit_ > 0) {
                 EventFile outFile(outputFiles_[0], true);
 
                 for (auto module : sequence_) {
+                    ProcessorStatistics::Scope scope(module->getStatistics(), ProcessorStatistics::FILE_OPEN);
                     module->onFileOpen(outputFiles_[0]);
                 }
 
                 EventImpl theEvent(passname_);
                 outFile.setupEvent(&theEvent);
 
+                RunHeader runHeader(runForGeneration_, "", "");
+                runHeader.setRandomSeedRoot(passname_, randomSeeds_.getSeedRoot());
+                outFile.writeRunHeader(&runHeader);
+
                 while (n_events_processed < eventLimit_) {
                     EventHeader& eh = theEvent.getEventHeaderMutable();
                     eh.setRun(runForGeneration_);
@@ -45,12 +117,12 @@ namespace ldmx {
                     // reset the storage controller state
                     m_storageController.resetEventState();
 
-                    for (auto module : sequence_) {
-                        if (dynamic_cast<Producer*>(module)) {
-                            (dynamic_cast<Producer*>(module))->produce(theEvent);
-                        } else if (dynamic_cast<Analyzer*>(module)) {
-                            (dynamic_cast<Analyzer*>(module))->analyze(theEvent);
-                        }
+                    for (const auto& entry : dispatch_) {
+                        if (!entry.isSelected(eh)) continue;
+                        EventProcessor* module = entry.getProcessor();
+                        module->startRandomStream(randomSeeds_, eh);
+                        ProcessorStatistics::Scope scope(module->getStatistics(), ProcessorStatistics::EVENT);
+                        entry.process(theEvent);
                     }
                     outFile.nextEvent(m_storageController.keepEvent());
                     theEvent.Clear();
@@ -58,6 +130,7 @@ namespace ldmx {
                 }
 
                 for (auto module : sequence_) {
+                    ProcessorStatistics::Scope scope(module->getStatistics(), ProcessorStatistics::FILE_CLOSE);
                     module->onFileClose(outputFiles_[0]);
                 }
                 outFile.close();
@@ -86,13 +159,20 @@ namespace ldmx {
                     EventFile inFile(infilename);
 
                     EventImpl theEvent(passname_);
+                    // the input products of each entry are borrowed from the worker which read it
+                    theEvent.setBorrowInput(pool != nullptr);
 
                     std::cout << "[ Process ] : Opening file " << infilename << std::endl;
 
                     for (auto module : sequence_) {
+                        ProcessorStatistics::Scope scope(module->getStatistics(), ProcessorStatistics::FILE_OPEN);
                         module->onFileOpen(infilename);
                     }
-                    
+                    for (auto& clone : clones) {
+                        ProcessorStatistics::Scope scope(clone->getStatistics(), ProcessorStatistics::FILE_OPEN);
+                        clone->onFileOpen(infilename);
+                    }
+
                     //configure event file that will be iterated over
                     EventFile* masterFile; 
                     if ( !outputFiles_.empty() ) {
@@ -105,10 +185,20 @@ namespace ldmx {
                             outFile = new EventFile(outputFiles_[ifile], &inFile, singleOutput );
                             ifile++;
 
+                            if (!inputCollections_.empty()) {
+                                inFile.selectInputCollections(inputCollections_);
+                            }
+
                             for ( auto rule : dropKeepRules_ ) {
                                 outFile->addDrop(rule);
                             }
 
+                            // record the seeds of this pass with the runs
+                            int seedRoot = randomSeeds_.getSeedRoot();
+                            outFile->updateRunHeaders([this, seedRoot](RunHeader& runHeader) {
+                                runHeader.setRandomSeedRoot(passname_, seedRoot);
+                            });
+
                             //setup theEvent we will iterate over
                             if (outFile) {
                                 outFile->setupEvent( &theEvent );
@@ -123,6 +213,9 @@ namespace ldmx {
                         } else {
 
                             //all other input files
+                            if (!inputCollections_.empty()) {
+                                inFile.selectInputCollections(inputCollections_);
+                            }
                             outFile->updateParent( &inFile );
                             masterFile = outFile;
 
@@ -130,14 +223,31 @@ namespace ldmx {
 
                     } else {
                         //empty output file list, use inputFile as master file
+                        if (!inputCollections_.empty()) {
+                            inFile.selectInputCollections(inputCollections_);
+                        }
                         inFile.setupEvent( &theEvent );
                         masterFile = &inFile;
                     }
 
+                    // the workers read the branches which are left active by the configuration above
+                    if (pool) {
+                        Long64_t maxEntries = inFile.getEntries();
+                        if (eventLimit_ >= 0) {
+                            maxEntries = std::min<Long64_t>(maxEntries, eventLimit_ - n_events_processed);
+                        }
+                        pool->startFile(inFile, maxEntries, !outputFiles_.empty());
+                    }
+
                     while (masterFile->nextEvent(m_storageController.keepEvent()) && 
                             (eventLimit_ < 0 || (n_events_processed) < eventLimit_)) {
                         // clean up for storage control calculation
                         m_storageController.resetEventState();
+
+                        // pick up the event of the worker threads in order, including its header
+                        if (pool) {
+                            pool->collect(theEvent, m_storageController);
+                        }
             
                         // notify for new run if necessary
                         if (theEvent.getEventHeader()->getRun() != wasRun) {
@@ -146,8 +256,10 @@ namespace ldmx {
                                 const RunHeader& runHeader = masterFile->getRunHeader(wasRun);
                                 std::cout << "[ Process ] : got new run header from '" << masterFile->getFileName() << "' ..." << std::endl;
                                 runHeader.Print();
-                                for (auto module : sequence_) {
-                                    module->onNewRun(runHeader);
+                                // processors on worker threads are notified by their worker
+                                for (size_t i = nParallel; i < sequence_.size(); i++) {
+                                    ProcessorStatistics::Scope scope(sequence_[i]->getStatistics(), ProcessorStatistics::NEW_RUN);
+                                    sequence_[i]->onNewRun(runHeader);
                                 }
                             } catch (const Exception&) {
                                 std::cout << "[ Process ] : [WARNING] Run header for run " << wasRun << " was not found!" << std::endl;
@@ -162,12 +274,14 @@ namespace ldmx {
                                       << "  (" << t.AsString("lc") << ")" << std::endl;
                         }
 
-                        for (auto module : sequence_) {
-                            if (dynamic_cast<Producer*>(module)) {
-                                (dynamic_cast<Producer*>(module))->produce(theEvent);
-                            } else if (dynamic_cast<Analyzer*>(module)) {
-                                (dynamic_cast<Analyzer*>(module))->analyze(theEvent);
-                            }
+                        const EventHeader& eh = *theEvent.getEventHeader();
+                        for (size_t i = (pool ? nParallel : 0); i < dispatch_.size(); i++) {
+                            const ProcessorDispatch& entry = dispatch_[i];
+                            if (!entry.isSelected(eh)) continue;
+                            EventProcessor* module = entry.getProcessor();
+                            module->startRandomStream(randomSeeds_, eh);
+                            ProcessorStatistics::Scope scope(module->getStatistics(), ProcessorStatistics::EVENT);
+                            entry.process(theEvent);
                         }
 
                         n_events_processed++;
@@ -187,13 +301,22 @@ namespace ldmx {
                         outFile = nullptr;
                     }
 
+                    if (pool) {
+                        pool->stopFile();
+                    }
+
                     inFile.close();
 
                     std::cout << "[ Process ] : Closing file " << infilename << std::endl;
 
                     for (auto module : sequence_) {
+                        ProcessorStatistics::Scope scope(module->getStatistics(), ProcessorStatistics::FILE_CLOSE);
                         module->onFileClose(infilename);
                     }
+                    for (auto& clone : clones) {
+                        ProcessorStatistics::Scope scope(clone->getStatistics(), ProcessorStatistics::FILE_CLOSE);
+                        clone->onFileClose(infilename);
+                    }
 
                 } //loop through input files
 
@@ -204,18 +327,46 @@ namespace ldmx {
                     delete outFile;
                     outFile = nullptr;
                 }
-
-                if (histoTFile_) {
-                    histoTFile_->Write();
-                    delete histoTFile_;
-                    histoTFile_ = 0;
-                }
             }
 
-            // finally, notify everyone that we are stopping
+            // finally, notify everyone that we are stopping, the copies first so
+            // that the original processors see the histograms of all threads
+            for (auto& clone : clones) {
+                ProcessorStatistics::Scope scope(clone->getStatistics(), ProcessorStatistics::PROCESS_END);
+                clone->onProcessEnd();
+            }
+            for (size_t i = 0; i < clones.size(); i++) {
+                sequence_[i % nParallel]->getHistograms().merge(clones[i]->getHistograms());
+            }
             for (auto module : sequence_) {
+                ProcessorStatistics::Scope scope(module->getStatistics(), ProcessorStatistics::PROCESS_END);
                 module->onProcessEnd();
             }
+
+            if (profile_) {
+                for (size_t i = 0; i < clones.size(); i++) {
+                    sequence_[i % nParallel]->getStatistics()->merge(*clones[i]->getStatistics());
+                }
+
+                std::vector<const ProcessorStatistics*> statistics;
+                for (auto module : sequence_) {
+                    statistics.push_back(module->getStatistics());
+                }
+                ProcessorStatistics::printSummary(std::cout, statistics);
+
+                if (!histoFilename_.empty()) {
+                    TDirectory* directory = makeHistoDirectory("processorStatistics");
+                    for (auto module : sequence_) {
+                        module->getStatistics()->writeEventTimes(directory);
+                    }
+                }
+            }
+
+            if (histoTFile_) {
+                histoTFile_->Write();
+                delete histoTFile_;
+                histoTFile_ = 0;
+            }
         } catch (Exception& e) {
             std::cerr << "Framework Error [" << e.name() << "] : " << e.message() << std::endl;
             std::cerr << "  at " << e.module() << ":" << e.line() << " in " << e.function() << std::endl;
@@ -223,7 +374,28 @@ namespace ldmx {
     }
 
     void Process::addToSequence(EventProcessor* mod) {
+        dispatch_.emplace_back(mod);
         sequence_.push_back(mod);
+        recipes_.push_back(ProcessorRecipe());
+    }
+
+    void Process::addToSequence(EventProcessor* mod, const std::string& classname, const ParameterSet& parameters,
+                                bool enabled, int prescale) {
+        dispatch_.emplace_back(mod, enabled, prescale);
+        sequence_.push_back(mod);
+        recipes_.push_back(ProcessorRecipe());
+        recipes_.back().classname_ = classname;
+        recipes_.back().parameters_ = parameters;
+        recipes_.back().valid_ = true;
+    }
+
+    StorageControl& Process::getStorageController() {
+        if (threadStorageController) return *threadStorageController;
+        return m_storageController;
+    }
+
+    void Process::setThreadStorageController(StorageControl* controller) {
+        threadStorageController = controller;
     }
 
     void Process::addFileToProcess(const std::string& filename) {
@@ -234,6 +406,10 @@ namespace ldmx {
         dropKeepRules_.push_back(rule);
     }
 
+    void Process::addInputCollection(const std::string& collection) {
+        inputCollections_.push_back(collection);
+    }
+
     void Process::setOutputFileName(const std::string& filenameOut) {
         outputFiles_.clear();
         outputFiles_.push_back(filenameOut);
@@ -257,7 +433,10 @@ namespace ldmx {
         } else
             owner = histoTFile_;
         owner->cd();
-        TDirectory* child = owner->mkdir((char*) dirName.c_str());
+        // copies of a processor on worker threads share the directory of the original
+        TDirectory* child = owner->GetDirectory(dirName.c_str());
+        if (!child)
+            child = owner->mkdir((char*) dirName.c_str());
         if (child)
             child->cd();
         return child;
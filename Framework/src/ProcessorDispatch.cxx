@@ -0,0 +1,18 @@
+#include "Framework/ProcessorDispatch.h"
+
+// LDMX
+#include "Framework/Exception.h"
+
+namespace ldmx {
+
+    ProcessorDispatch::ProcessorDispatch(EventProcessor* processor, bool enabled, int prescale) :
+            processor_ { processor }, producer_ { dynamic_cast<Producer*>(processor) }, analyzer_ { dynamic_cast<Analyzer*>(processor) },
+            prescale_ { prescale }, enabled_ { enabled } {
+        if (!producer_ && !analyzer_) {
+            EXCEPTION_RAISE("ProcessorType", "The processor '" + processor->getName() + "' is neither a Producer nor an Analyzer");
+        }
+        if (prescale_ < 1) {
+            EXCEPTION_RAISE("InvalidPrescale", "The prescale of '" + processor->getName() + "' must be at least 1, not " + std::to_string(prescale_));
+        }
+    }
+}
@@ -0,0 +1,106 @@
+#include "Framework/ProcessorStatistics.h"
+
+// ROOT
+#include "TDirectory.h"
+#include "TH1F.h"
+
+// STL
+#include <cmath>
+#include <iomanip>
+#include <time.h>
+
+namespace ldmx {
+
+    uint64_t (*ProcessorStatistics::allocationCounter_)() = nullptr;
+
+    /** Names of the callbacks in the summary table. */
+    static const char* CALLBACK_NAMES[ProcessorStatistics::NUM_CALLBACKS] = {
+        "event", "onNewRun", "onFileOpen", "onFileClose", "onProcessStart", "onProcessEnd"
+    };
+
+    ProcessorStatistics::ProcessorStatistics(const std::string& name) :
+            name_ { name } {
+
+        // 20 logarithmic bins per decade from 100 ns to 1000 s
+        const int nbins = 200;
+        std::vector<double> edges(nbins + 1);
+        for (int i = 0; i <= nbins; i++) {
+            edges[i] = std::pow(10., -7. + i/20.);
+        }
+        eventTimes_ = new TH1F((name_ + "_eventTime").c_str(), "", nbins, edges.data());
+        eventTimes_->SetDirectory(nullptr);
+        eventTimes_->GetXaxis()->SetTitle(("Wall time per event of " + name_ + " [s]").c_str());
+    }
+
+    ProcessorStatistics::~ProcessorStatistics() {
+        delete eventTimes_;
+    }
+
+    void ProcessorStatistics::start(Callback callback) {
+        current_ = callback;
+        if (allocationCounter_) allocationStart_ = allocationCounter_();
+        cpuStart_ = getCPUTime();
+        wallStart_ = std::chrono::steady_clock::now();
+    }
+
+    void ProcessorStatistics::stop() {
+        double wallTime = std::chrono::duration<double>(std::chrono::steady_clock::now() - wallStart_).count();
+        double cpuTime = getCPUTime() - cpuStart_;
+
+        Usage& usage = usage_[current_];
+        usage.calls_++;
+        usage.wallTime_ += wallTime;
+        usage.cpuTime_ += cpuTime;
+        if (allocationCounter_) usage.allocations_ += allocationCounter_() - allocationStart_;
+
+        if (current_ == EVENT && eventTimes_) eventTimes_->Fill(wallTime);
+    }
+
+    double ProcessorStatistics::getCPUTime() {
+        timespec ts;
+        clock_gettime(CLOCK_THREAD_CPUTIME_ID, &ts);
+        return ts.tv_sec + 1e-9*ts.tv_nsec;
+    }
+
+    void ProcessorStatistics::merge(const ProcessorStatistics& other) {
+        for (int i = 0; i < NUM_CALLBACKS; i++) {
+            usage_[i].calls_ += other.usage_[i].calls_;
+            usage_[i].wallTime_ += other.usage_[i].wallTime_;
+            usage_[i].cpuTime_ += other.usage_[i].cpuTime_;
+            usage_[i].allocations_ += other.usage_[i].allocations_;
+        }
+        if (eventTimes_ && other.eventTimes_) eventTimes_->Add(other.eventTimes_);
+    }
+
+    void ProcessorStatistics::writeEventTimes(TDirectory* directory) {
+        if (!eventTimes_ || !directory) return;
+        eventTimes_->SetDirectory(directory);
+        eventTimes_ = nullptr;
+    }
+
+    void ProcessorStatistics::printSummary(std::ostream& out, const std::vector<const ProcessorStatistics*>& statistics) {
+        out << "[ Process ] : Resource usage of the processors" << std::endl;
+        out << std::left << std::setw(24) << "  processor" << std::setw(16) << "call" << std::right
+            << std::setw(10) << "calls" << std::setw(14) << "wall [ms]" << std::setw(14) << "cpu [ms]"
+            << std::setw(14) << "allocations" << std::setw(16) << "wall/call [ms]" << std::endl;
+
+        out << std::fixed << std::setprecision(3);
+        for (auto stats : statistics) {
+            for (int i = 0; i < NUM_CALLBACKS; i++) {
+                const Usage& usage = stats->usage_[i];
+                if (usage.calls_ == 0) continue;
+                out << std::left << "  " << std::setw(22) << stats->name_ << std::setw(16) << CALLBACK_NAMES[i] << std::right
+                    << std::setw(10) << usage.calls_
+                    << std::setw(14) << 1e3*usage.wallTime_
+                    << std::setw(14) << 1e3*usage.cpuTime_;
+                if (allocationCounter_) {
+                    out << std::setw(14) << usage.allocations_;
+                } else {
+                    out << std::setw(14) << "-";
+                }
+                out << std::setw(16) << 1e3*usage.wallTime_/usage.calls_ << std::endl;
+            }
+        }
+        out << std::defaultfloat << std::setprecision(6);
+    }
+}
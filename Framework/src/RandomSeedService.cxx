@@ -0,0 +1,21 @@
+#include "Framework/RandomSeedService.h"
+
+// LDMX
+#include "Tools/RandomStream.h"
+
+namespace ldmx {
+
+    uint64_t RandomSeedService::getStreamKey(const std::string& name, int run, int event) const {
+        // FNV-1a hash of the name
+        uint64_t nameHash = 0xcbf29ce484222325ULL;
+        for (char c : name) {
+            nameHash = (nameHash ^ static_cast<unsigned char>(c))*0x100000001b3ULL;
+        }
+
+        // chain the inputs through the mixing function, so that no two of them cancel
+        uint64_t key = RandomStream::mix(static_cast<uint32_t>(seedRoot_));
+        key = RandomStream::mix(key ^ nameHash);
+        key = RandomStream::mix(key ^ static_cast<uint32_t>(run));
+        return RandomStream::mix(key ^ static_cast<uint32_t>(event));
+    }
+}
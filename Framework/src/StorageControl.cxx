@@ -1,69 +1,120 @@
 #include "Framework/StorageControl.h"
 #include "Framework/Exception.h"
+#include <map>
+#include <mutex>
+#include <utility>
 #include <sys/types.h>
 #include <regex.h>
 
 namespace ldmx {
 
+    /**
+     * Names of the processor and purpose behind each hint ID.
+     */
+    struct HintRegistry {
+        std::mutex mutex_;
+        std::map<std::pair<std::string, std::string>, int> ids_;
+        std::vector<std::pair<std::string, std::string> > names_;
+    };
+
+    static HintRegistry& hintRegistry() {
+        static HintRegistry registry;
+        return registry;
+    }
+
+    /**
+     * Compile a regex, which is freed together with the last copy of the rule.
+     */
+    static std::shared_ptr<void> compileRegex(const std::string& pattern) {
+        regex_t* preg=new regex_t;
+        int error=regcomp(preg,pattern.c_str(),REG_EXTENDED|REG_NOSUB);
+        if (error) {
+            char msg[1024];
+            regerror(error,preg,msg,1024);
+            delete preg;
+            EXCEPTION_RAISE("SkimRuleException",msg);
+        }
+        return std::shared_ptr<void>(preg, [](void* p) {
+            regfree((regex_t*) p);
+            delete (regex_t*) p;
+        });
+    }
+
+    int StorageControl::getHintID(const std::string& processor_name, const std::string& purposeString) {
+        HintRegistry& registry=hintRegistry();
+        std::lock_guard<std::mutex> lock(registry.mutex_);
+        auto key=std::make_pair(processor_name,purposeString);
+        auto it=registry.ids_.find(key);
+        if (it!=registry.ids_.end()) return it->second;
+        int id=registry.names_.size();
+        registry.ids_[key]=id;
+        registry.names_.push_back(key);
+        return id;
+    }
+
     void StorageControl::resetEventState() {
         hints_.clear();
     }
-    
+
     void StorageControl::addHint(const std::string& processor_name, ldmx::StorageControlHint hint, const std::string& purposeString) {
+        addHint(getHintID(processor_name,purposeString),hint);
+    }
+
+    void StorageControl::addHint(int hintID, ldmx::StorageControlHint hint) {
         hints_.push_back(Hint());
-        hints_.back().evpName_=processor_name;
+        hints_.back().id_=hintID;
         hints_.back().hint_=hint;
-        hints_.back().purpose_=purposeString;
     }
 
-    
+    void StorageControl::addHints(const StorageControl& other) {
+        hints_.insert(hints_.end(), other.hints_.begin(), other.hints_.end());
+    }
+
     void StorageControl::addRule(const std::string& processor_pat, const std::string& purpose_pat) {
         if (processor_pat.empty()) return;
 
-        regex_t* preg=new regex_t;
-        int error=regcomp(preg,processor_pat.c_str(),REG_EXTENDED|REG_NOSUB);
-        if (error) {        
-            char msg[1024];
-            regerror(error,preg,msg,1024);
-            delete preg;
-            EXCEPTION_RAISE("SkimRuleException",msg);
-        }
-        // ok, then keep it
-        rules_.push_back(Rule());
-        rules_.back().evpNameRegex_=preg;
-    
+        Rule rule;
+        rule.evpNameRegex_=compileRegex(processor_pat);
         if (!purpose_pat.empty()) {
-            preg=new regex_t;
-            int error=regcomp(preg,purpose_pat.c_str(),REG_EXTENDED|REG_NOSUB);
-            if (error) {        
-                char msg[1024];
-                regerror(error,preg,msg,1024);
-                delete preg;
-                EXCEPTION_RAISE("SkimRuleException",msg);
-            }
-            rules_.back().purposeRegex_=preg;
+            rule.purposeRegex_=compileRegex(purpose_pat);
         }
-    
-        rules_.back().evpNamePattern_=processor_pat;
-        rules_.back().purposePattern_=purpose_pat;
-    
+        rule.evpNamePattern_=processor_pat;
+        rule.purposePattern_=purpose_pat;
+        rules_.push_back(rule);
+
+        // the table has to be rebuilt with the new rule
+        ruleMatches_.clear();
     }
-    
-    bool StorageControl::Rule::matches(const StorageControl::Hint& h) {
-        if (regexec((const regex_t*)(evpNameRegex_),h.evpName_.c_str(),0,0,0)) return false;
-        if (purposeRegex_!=0 && regexec((const regex_t*)(purposeRegex_),h.purpose_.c_str(),0,0,0)) return false;
+
+    bool StorageControl::Rule::matches(const std::string& evpName, const std::string& purpose) const {
+        if (regexec((const regex_t*)(evpNameRegex_.get()),evpName.c_str(),0,0,0)) return false;
+        if (purposeRegex_ && regexec((const regex_t*)(purposeRegex_.get()),purpose.c_str(),0,0,0)) return false;
         return true;
     }
-    
+
+    void StorageControl::compileRules() {
+        updateMatches();
+    }
+
+    void StorageControl::updateMatches() const {
+        HintRegistry& registry=hintRegistry();
+        std::lock_guard<std::mutex> lock(registry.mutex_);
+        for (size_t id=ruleMatches_.size(); id<registry.names_.size(); id++) {
+            int nmatch=0;
+            for (const auto& rule : rules_) {
+                if (rule.matches(registry.names_[id].first,registry.names_[id].second)) nmatch++;
+            }
+            ruleMatches_.push_back(nmatch);
+        }
+    }
+
     bool StorageControl::keepEvent() const {
         int votesKeep(0), votesDrop(0);
-        // loop over all rules and then over all hints
-        for (auto rule: rules_) {
-            for (auto hint: hints_) {
-                if (!rule.matches(hint)) continue;
-                if (hint.hint_==hint_shouldKeep || hint.hint_==hint_mustKeep) votesKeep++;
-                else if (hint.hint_==hint_shouldDrop || hint.hint_==hint_mustDrop) votesDrop++;
-            }
+        // each hint gets one vote per rule which matches it
+        for (const auto& hint : hints_) {
+            if (hint.id_>=int(ruleMatches_.size())) updateMatches();
+            if (hint.hint_==hint_shouldKeep || hint.hint_==hint_mustKeep) votesKeep+=ruleMatches_[hint.id_];
+            else if (hint.hint_==hint_shouldDrop || hint.hint_==hint_mustDrop) votesDrop+=ruleMatches_[hint.id_];
         }
 
         // easy case
@@ -73,7 +124,7 @@ namespace ldmx {
         if (votesKeep>votesDrop) return true;
         if (votesDrop>votesKeep) return false;
 
-        // at the end, go with the default        
+        // at the end, go with the default
         return defaultIsKeep_;
     }
 }
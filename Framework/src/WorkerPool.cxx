@@ -0,0 +1,157 @@
+#include "Framework/WorkerPool.h"
+
+// LDMX
+#include "Framework/EventFile.h"
+#include "Framework/EventImpl.h"
+#include "Framework/EventProcessor.h"
+#include "Framework/Exception.h"
+#include "Framework/Process.h"
+#include "Event/RunHeader.h"
+
+// STL
+#include <algorithm>
+#include <iostream>
+
+namespace ldmx {
+
+    WorkerPool::WorkerPool(Process& process, const std::vector<std::vector<ProcessorDispatch> >& processors) :
+        process_(process) {
+        for (const auto& list : processors) {
+            workers_.emplace_back(new Worker);
+            workers_.back()->processors_ = list;
+        }
+    }
+
+    WorkerPool::~WorkerPool() {
+        stopFile();
+    }
+
+    void WorkerPool::startFile(EventFile& input, Long64_t maxEntries, bool readAllBranches) {
+
+        stopFile();
+
+        for (auto& worker : workers_) {
+            worker->file_.reset(new EventFile(input.getFileName()));
+            worker->file_->selectBranches(input);
+            worker->event_.reset(new EventImpl(process_.getPassName()));
+            worker->file_->setupEvent(worker->event_.get());
+            worker->wasRun_ = -1;
+        }
+
+        stop_ = false;
+        error_ = nullptr;
+        ready_.clear();
+        nextEntry_ = 0;
+        nextCollect_ = 0;
+        released_ = 0;
+        readAllBranches_ = readAllBranches;
+        maxEntries_ = std::min(maxEntries, workers_.front()->file_->getEntries());
+
+        for (auto& worker : workers_) {
+            Worker* w = worker.get();
+            w->thread_ = std::thread([this, w] { work(*w); });
+        }
+    }
+
+    void WorkerPool::collect(EventImpl& target, StorageControl& storage) {
+        Worker* worker{nullptr};
+        {
+            std::unique_lock<std::mutex> lock(mutex_);
+            if (nextCollect_ >= maxEntries_) {
+                EXCEPTION_RAISE("WorkerPool", "Requested entry " + std::to_string(nextCollect_) + " beyond the range given to the workers");
+            }
+            // the previous event has been written, so its worker can move on
+            released_ = nextCollect_;
+            cv_.notify_all();
+            cv_.wait(lock, [this] { return error_ || ready_.count(nextCollect_); });
+            if (error_) std::rethrow_exception(error_);
+            auto it = ready_.find(nextCollect_);
+            worker = it->second;
+            ready_.erase(it);
+            nextCollect_++;
+        }
+
+        // the worker waits until its event is released, so the event can be lent without the lock
+        target.borrowProducts(*worker->event_);
+        storage.addHints(worker->storage_);
+    }
+
+    void WorkerPool::stopFile() {
+        {
+            std::lock_guard<std::mutex> lock(mutex_);
+            stop_ = true;
+        }
+        cv_.notify_all();
+
+        for (auto& worker : workers_) {
+            if (worker->thread_.joinable()) worker->thread_.join();
+            worker->event_.reset();
+            if (worker->file_) {
+                worker->file_->close();
+                worker->file_.reset();
+            }
+        }
+    }
+
+    void WorkerPool::work(Worker& worker) {
+
+        process_.setThreadStorageController(&worker.storage_);
+
+        try {
+            while (true) {
+                Long64_t entry;
+                {
+                    std::lock_guard<std::mutex> lock(mutex_);
+                    if (stop_ || error_ || nextEntry_ >= maxEntries_) break;
+                    entry = nextEntry_++;
+                }
+
+                worker.storage_.resetEventState();
+                if (!worker.file_->readEntry(entry)) {
+                    EXCEPTION_RAISE("WorkerPool", "Unable to read entry " + std::to_string(entry) + " from '" + worker.file_->getFileName() + "'");
+                }
+
+                int run = worker.event_->getEventHeader()->getRun();
+                if (run != worker.wasRun_) {
+                    worker.wasRun_ = run;
+                    try {
+                        const RunHeader& runHeader = worker.file_->getRunHeader(run);
+                        for (const auto& entry : worker.processors_) {
+                            EventProcessor* module = entry.getProcessor();
+                            ProcessorStatistics::Scope scope(module->getStatistics(), ProcessorStatistics::NEW_RUN);
+                            module->onNewRun(runHeader);
+                        }
+                    } catch (const Exception&) {
+                        // missing run headers are reported by the main thread
+                    }
+                }
+
+                const EventHeader& eh = *worker.event_->getEventHeader();
+                for (const auto& entry : worker.processors_) {
+                    if (!entry.isSelected(eh)) continue;
+                    EventProcessor* module = entry.getProcessor();
+                    module->startRandomStream(process_.getRandomSeeds(), eh);
+                    ProcessorStatistics::Scope scope(module->getStatistics(), ProcessorStatistics::EVENT);
+                    entry.process(*worker.event_);
+                }
+
+                // the main thread writes the branches that no processor has read from our buffers
+                if (readAllBranches_) {
+                    worker.event_->readInputBranches();
+                }
+
+                // hand the event to the main thread and wait until it is no longer used
+                std::unique_lock<std::mutex> lock(mutex_);
+                ready_[entry] = &worker;
+                cv_.notify_all();
+                cv_.wait(lock, [this, entry] { return stop_ || released_ > entry; });
+            }
+        } catch (...) {
+            std::lock_guard<std::mutex> lock(mutex_);
+            if (!error_) error_ = std::current_exception();
+            cv_.notify_all();
+        }
+
+        process_.setThreadStorageController(nullptr);
+    }
+}
@@ -1,7 +1,10 @@
 //----------------//
 //   C++ StdLib   //
 //----------------//
+#include <cstdint>
+#include <cstdlib>
 #include <iostream>
+#include <new>
 #include <string.h>
 #include <stdio.h>
 #include <unistd.h>
@@ -13,6 +16,7 @@
 #include "Framework/Process.h"
 #include "Framework/EventProcessorFactory.h"
 #include "Framework/ConfigurePython.h"
+#include "Framework/ProcessorStatistics.h"
 
 /**
  * @namespace ldmx
@@ -31,6 +35,33 @@ if (p) p->requestFinish();
 }
 */
 
+#ifdef LDMX_COUNT_ALLOCATIONS
+
+/** Number of memory allocations made by the current thread, for the processor statistics. */
+static thread_local uint64_t allocationCount = 0;
+
+/**
+ * Replacement of the global allocation function which counts the allocations.
+ * It lives in the executable so that the counter is a plain thread-local
+ * variable, which costs a single increment per allocation.
+ */
+void* operator new(std::size_t size) {
+    ++allocationCount;
+    if (size == 0) size = 1;
+    while (true) {
+        void* p = std::malloc(size);
+        if (p) return p;
+        std::new_handler handler = std::get_new_handler();
+        if (!handler) throw std::bad_alloc();
+        handler();
+    }
+}
+
+void operator delete(void* p) noexcept {
+    std::free(p);
+}
+
+#endif
 
 /**
  * @mainpage
@@ -63,6 +94,10 @@ int main(int argc, char* argv[]) {
         return 0;
     }
 
+#ifdef LDMX_COUNT_ALLOCATIONS
+    ProcessorStatistics::setAllocationCounter([]() { return allocationCount; });
+#endif
+
     Process* p { 0 };
     try {
         std::cout << "---- LDMXSW: Loading configuration --------" << std::endl;
@@ -0,0 +1,160 @@
+// LDMX
+#include "Event/EventConstants.h"
+#include "Event/SimCalorimeterHit.h"
+#include "Event/SimParticle.h"
+#include "Framework/EventFile.h"
+#include "Framework/EventImpl.h"
+
+// ROOT
+#include "TClonesArray.h"
+#include "TROOT.h"
+
+// STL
+#include <iostream>
+#include <mutex>
+#include <stdexcept>
+#include <string>
+#include <thread>
+#include <vector>
+
+using namespace ldmx;
+
+/*
+ * Writes the events built by the worker threads, like the writer of a
+ * multithreaded ldmx-sim run.
+ */
+class TestWriter {
+
+    public:
+
+        TestWriter(const std::string& filename) : file_(filename, true), event_("sim") {
+            file_.setupEvent(&event_);
+        }
+
+        /*
+         * Build the SimParticles and hits of an event in the buffer of a worker,
+         * under the lock, and write them in place.
+         */
+        void writeEvent(EventImpl& worker, TClonesArray* particles, TClonesArray* hits, int eventNumber) {
+            std::lock_guard<std::mutex> lock(mutex_);
+
+            // each particle is a daughter of the particle at half of its index
+            int nParticles = 1 + eventNumber % 17;
+            for (int i = 0; i < nParticles; i++) {
+                SimParticle* particle = static_cast<SimParticle*>(particles->ConstructedAt(i));
+                particle->setTrackID(i + 1);
+                particle->setEnergy(eventNumber);
+                if (i > 0) {
+                    SimParticle* parent = static_cast<SimParticle*>(particles->At((i - 1)/2));
+                    particle->addParent(parent);
+                    parent->addDaughter(particle);
+                }
+            }
+            worker.add(EventConstants::SIM_PARTICLES, particles);
+
+            for (int i = 0; i < 2*nParticles; i++) {
+                SimCalorimeterHit* hit = static_cast<SimCalorimeterHit*>(hits->ConstructedAt(i));
+                hit->setID(i);
+                hit->addContrib(static_cast<SimParticle*>(particles->At(i % nParticles)), 11, 1., eventNumber);
+            }
+            worker.add(EventConstants::ECAL_SIM_HITS, hits);
+
+            event_.getEventHeaderMutable().setEventNumber(eventNumber);
+            event_.borrowProducts(worker);
+            file_.nextEvent();
+        }
+
+        void close() {
+            file_.close();
+        }
+
+    private:
+
+        EventFile file_;
+        EventImpl event_;
+        std::mutex mutex_;
+};
+
+/*
+ * Build the events with the given number modulo the number of workers.
+ */
+void runWorker(TestWriter& writer, int worker, int nWorkers, int nEvents) {
+    EventImpl event("sim");
+    TClonesArray particles(EventConstants::SIM_PARTICLE.c_str(), 50);
+    TClonesArray hits(EventConstants::SIM_CALORIMETER_HIT.c_str(), 50);
+    for (int eventNumber = worker + 1; eventNumber <= nEvents; eventNumber += nWorkers) {
+        particles.Clear("C");
+        hits.Clear("C");
+        writer.writeEvent(event, &particles, &hits, eventNumber);
+        event.Clear();
+    }
+}
+
+/*
+ * Check that the references between the SimParticles and from the hit
+ * contributions can be resolved in the output written from the buffers
+ * of several worker threads.
+ */
+int main(int, const char* argv[])  {
+
+    std::cout << "Hello BorrowedReferences test!" << std::endl;
+
+    ROOT::EnableThreadSafety();
+
+    const int nEvents = 400, nWorkers = 4;
+    TestWriter writer("borrowed_references_test.root");
+    std::vector<std::thread> workers;
+    for (int i = 0; i < nWorkers; i++) {
+        workers.emplace_back(runWorker, std::ref(writer), i, nWorkers, nEvents);
+    }
+    for (auto& worker : workers) worker.join();
+    writer.close();
+
+    EventFile file("borrowed_references_test.root");
+    EventImpl event("check");
+    file.setupEvent(&event);
+    if (file.getEntries() != nEvents) {
+        throw std::runtime_error("Expected " + std::to_string(nEvents) + " events, got " + std::to_string(file.getEntries()));
+    }
+
+    int nLinks = 0;
+    while (file.nextEvent()) {
+        int eventNumber = event.getEventHeader()->getEventNumber();
+        std::string name = "event " + std::to_string(eventNumber);
+        const TClonesArray* particles = event.getCollection(EventConstants::SIM_PARTICLES);
+        const TClonesArray* hits = event.getCollection(EventConstants::ECAL_SIM_HITS);
+        if (particles->GetEntriesFast() != 1 + eventNumber % 17 || hits->GetEntriesFast() != 2*particles->GetEntriesFast()) {
+            throw std::runtime_error("Wrong number of SimParticles or hits in " + name);
+        }
+
+        for (int i = 1; i < particles->GetEntriesFast(); i++) {
+            SimParticle* particle = static_cast<SimParticle*>(particles->At(i));
+            SimParticle* parent = particle->getParentCount() == 1 ? particle->getParent(0) : nullptr;
+            if (!parent || parent != particles->At((i - 1)/2)) {
+                throw std::runtime_error("Parent of SimParticle " + std::to_string(i) + " not resolved in " + name);
+            }
+            bool found = false;
+            for (int j = 0; j < parent->getDaughterCount(); j++) {
+                found = found || parent->getDaughter(j) == particle;
+            }
+            if (!found) {
+                throw std::runtime_error("SimParticle " + std::to_string(i) + " is not a daughter of its parent in " + name);
+            }
+            nLinks++;
+        }
+
+        for (int i = 0; i < hits->GetEntriesFast(); i++) {
+            SimCalorimeterHit* hit = static_cast<SimCalorimeterHit*>(hits->At(i));
+            SimParticle* particle = hit->getContrib(0).particle;
+            if (particle != particles->At(i % particles->GetEntriesFast()) || particle->getEnergy() != eventNumber) {
+                throw std::runtime_error("SimParticle of hit " + std::to_string(i) + " not resolved in " + name);
+            }
+            nLinks++;
+        }
+    }
+
+    std::cout << "Resolved " << nLinks << " references in " << nEvents << " events ... okay" << std::endl;
+
+    file.close();
+    return 0;
+}
@@ -0,0 +1,148 @@
+// LDMX
+#include "Event/EcalHit.h"
+#include "Event/RunHeader.h"
+#include "Framework/EventFile.h"
+#include "Framework/EventImpl.h"
+#include "Framework/EventProcessor.h"
+#include "Framework/ParameterSet.h"
+#include "Framework/Process.h"
+
+// ROOT
+#include "TClonesArray.h"
+#include "TFile.h"
+#include "TH1F.h"
+#include "TH2F.h"
+#include "TKey.h"
+
+// STL
+#include <iostream>
+#include <map>
+#include <random>
+#include <stdexcept>
+#include <string>
+
+using namespace ldmx;
+
+/*
+ * Clone-safe analyzer which creates its histograms in onProcessStart, like
+ * the DQM analyzers, so that its copies on the worker threads create
+ * histograms with the same names.
+ */
+class TestHistogramAnalyzer : public Analyzer {
+
+    public:
+
+        TestHistogramAnalyzer(const std::string& name, Process& process) :
+                Analyzer(name, process) {
+        }
+
+        virtual bool isCloneSafe() const {
+            return true;
+        }
+
+        virtual void onProcessStart() {
+            getHistoDirectory();
+            nHits_ = histograms_.create<TH1F>("nHits", "Hits", 60, 0, 60);
+            hitEnergy_ = histograms_.create<TH2F>("hitEnergy", "Hit", 60, 0, 60, "Energy", 10, 0, 10);
+        }
+
+        virtual void analyze(const Event& event) {
+            const TClonesArray* hits = event.getCollection("TestHits");
+            nHits_->Fill(hits->GetEntriesFast());
+            for (int i = 0; i < hits->GetEntriesFast(); i++) {
+                hitEnergy_->Fill(i, static_cast<EcalHit*>(hits->At(i))->getEnergy());
+            }
+        }
+
+    private:
+
+        TH1* nHits_{nullptr};
+        TH1* hitEnergy_{nullptr};
+};
+
+DECLARE_ANALYZER(TestHistogramAnalyzer);
+
+/*
+ * Write an input file with a varying number of hits per event.
+ * @return The total number of hits.
+ */
+int writeInput(const std::string& filename, int nEvents) {
+    EventFile file(filename, true);
+    EventImpl event("gen");
+    file.setupEvent(&event);
+
+    RunHeader runHeader(1, "", "");
+    file.writeRunHeader(&runHeader);
+
+    std::mt19937 generator(5);
+    std::uniform_int_distribution<int> nHits(0, 50);
+    std::uniform_real_distribution<float> energy(0., 10.);
+    int total = 0;
+    for (int ievent = 0; ievent < nEvents; ievent++) {
+        EventHeader& eh = event.getEventHeaderMutable();
+        eh.setRun(1);
+        eh.setEventNumber(ievent + 1);
+        int n = nHits(generator);
+        for (int i = 0; i < n; i++) {
+            EcalHit& hit = event.emplaceToCollection<EcalHit>("TestHits");
+            hit.setID(i);
+            hit.setEnergy(energy(generator));
+        }
+        total += n;
+        file.nextEvent();
+    }
+    file.close();
+    return total;
+}
+
+/*
+ * Check that the histograms created by the copies of an analyzer on the
+ * worker threads do not replace the histograms of the original, so that
+ * the histogram file holds each histogram once, with the merged contents.
+ */
+int main(int, const char* argv[])  {
+
+    std::cout << "Hello HistogramPool test!" << std::endl;
+
+    const int nEvents = 300;
+    int nHits = writeInput("histogrampool_test_input.root", nEvents);
+
+    {
+        Process process("test");
+        ParameterSet parameters;
+        process.addToSequence(new TestHistogramAnalyzer("histos", process), "TestHistogramAnalyzer", parameters);
+        process.addFileToProcess("histogrampool_test_input.root");
+        process.setHistogramFileName("histogrampool_test_histos.root");
+        process.setNumThreads(2);
+        process.run();
+    }
+
+    TFile file("histogrampool_test_histos.root");
+    TDirectory* directory = file.GetDirectory("histos");
+    if (!directory) {
+        throw std::runtime_error("No histogram directory in the histogram file");
+    }
+
+    std::map<std::string, int> keys;
+    TIter next(directory->GetListOfKeys());
+    while (TKey* key = static_cast<TKey*>(next())) keys[key->GetName()]++;
+    for (const std::string name : {"nHits", "hitEnergy"}) {
+        if (keys[name] != 1) {
+            throw std::runtime_error("Histogram " + name + " written " + std::to_string(keys[name]) + " times");
+        }
+    }
+
+    TH1* nHitsHisto = static_cast<TH1*>(directory->Get("nHits"));
+    TH1* hitEnergyHisto = static_cast<TH1*>(directory->Get("hitEnergy"));
+    if (nHitsHisto->GetEntries() != nEvents) {
+        throw std::runtime_error("nHits has " + std::to_string(nHitsHisto->GetEntries()) + " entries instead of " + std::to_string(nEvents));
+    }
+    if (hitEnergyHisto->GetEntries() != nHits) {
+        throw std::runtime_error("hitEnergy has " + std::to_string(hitEnergyHisto->GetEntries()) + " entries instead of " + std::to_string(nHits));
+    }
+
+    std::cout << "Histograms of 2 threads merged ... okay" << std::endl;
+
+    file.Close();
+    return 0;
+}
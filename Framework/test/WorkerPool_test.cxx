@@ -0,0 +1,234 @@
+// LDMX
+#include "Event/EcalHit.h"
+#include "Event/RunHeader.h"
+#include "Framework/EventFile.h"
+#include "Framework/EventImpl.h"
+#include "Framework/EventProcessor.h"
+#include "Framework/ParameterSet.h"
+#include "Framework/Process.h"
+
+// ROOT
+#include "TClonesArray.h"
+#include "TFile.h"
+#include "TH1F.h"
+
+// STL
+#include <iostream>
+#include <random>
+#include <stdexcept>
+#include <string>
+
+using namespace ldmx;
+
+/*
+ * Clone-safe producer run on the worker threads, which sums the input hits.
+ */
+class TestSumProducer : public Producer {
+
+    public:
+
+        TestSumProducer(const std::string& name, Process& process) :
+                Producer(name, process) {
+        }
+
+        virtual bool isCloneSafe() const {
+            return true;
+        }
+
+        virtual void onProcessStart() {
+            getHistoDirectory();
+            nHits_ = histograms_.create<TH1F>("nHits", "Hits", 60, 0, 60);
+            energy_ = histograms_.create<TH1F>("energy", "Energy", 50, 0, 500);
+        }
+
+        virtual void produce(Event& event) {
+            const TClonesArray* hits = event.getCollection("TestHits");
+            EcalHit& sum = event.emplaceToCollection<EcalHit>("TestSums");
+            sum.setID(hits->GetEntriesFast());
+            for (int i = 0; i < hits->GetEntriesFast(); i++) {
+                sum.setEnergy(sum.getEnergy() + static_cast<EcalHit*>(hits->At(i))->getEnergy());
+            }
+            nHits_->Fill(hits->GetEntriesFast());
+            energy_->Fill(sum.getEnergy());
+        }
+
+    private:
+
+        TH1* nHits_{nullptr};
+        TH1* energy_{nullptr};
+};
+
+DECLARE_PRODUCER(TestSumProducer);
+
+/*
+ * Producer run on the main thread, which uses an input collection and the
+ * collection made on the worker threads.
+ */
+class TestTotalProducer : public Producer {
+
+    public:
+
+        TestTotalProducer(const std::string& name, Process& process) :
+                Producer(name, process) {
+        }
+
+        virtual void produce(Event& event) {
+            const TClonesArray* hits = event.getCollection("TestHits");
+            const TClonesArray* sums = event.getCollection("TestSums");
+            EcalHit& total = event.emplaceToCollection<EcalHit>("TestTotals");
+            total.setID(event.getEventHeader()->getEventNumber());
+            total.setEnergy(static_cast<EcalHit*>(sums->At(0))->getEnergy() + hits->GetEntriesFast());
+        }
+};
+
+DECLARE_PRODUCER(TestTotalProducer);
+
+/*
+ * Write an input file with a varying number of hits per event.
+ */
+void writeInput(const std::string& filename, int nEvents) {
+    EventFile file(filename, true);
+    EventImpl event("gen");
+    file.setupEvent(&event);
+
+    RunHeader runHeader(1, "", "");
+    file.writeRunHeader(&runHeader);
+
+    std::mt19937 generator(42);
+    std::uniform_int_distribution<int> nHits(0, 50);
+    std::uniform_real_distribution<float> energy(0., 10.);
+    for (int ievent = 0; ievent < nEvents; ievent++) {
+        EventHeader& eh = event.getEventHeaderMutable();
+        eh.setRun(1);
+        eh.setEventNumber(ievent + 1);
+        int n = nHits(generator);
+        for (int i = 0; i < n; i++) {
+            EcalHit& hit = event.emplaceToCollection<EcalHit>("TestHits");
+            hit.setID(i);
+            hit.setEnergy(energy(generator));
+        }
+        file.nextEvent();
+        event.Clear();
+    }
+    file.close();
+}
+
+/*
+ * Process the input file with the given number of threads, writing the
+ * histograms and the event times of the processors.
+ */
+void runProcess(const std::string& input, const std::string& output, const std::string& histos, int nThreads) {
+    Process process("test");
+    ParameterSet parameters;
+    process.addToSequence(new TestSumProducer("sum", process), "TestSumProducer", parameters);
+    process.addToSequence(new TestTotalProducer("total", process), "TestTotalProducer", parameters);
+    process.addFileToProcess(input);
+    process.setOutputFileName(output);
+    process.setHistogramFileName(histos);
+    process.setProfiling(true);
+    process.setNumThreads(nThreads);
+    process.run();
+}
+
+void compareCollections(const TClonesArray* first, const TClonesArray* second, const std::string& name, int entry) {
+    if (first->GetEntriesFast() != second->GetEntriesFast()) {
+        throw std::runtime_error("Different number of " + name + " in entry " + std::to_string(entry));
+    }
+    for (int i = 0; i < first->GetEntriesFast(); i++) {
+        const EcalHit* a = static_cast<const EcalHit*>(first->At(i));
+        const EcalHit* b = static_cast<const EcalHit*>(second->At(i));
+        if (a->getID() != b->getID() || a->getEnergy() != b->getEnergy()) {
+            throw std::runtime_error("Different " + name + " " + std::to_string(i) + " in entry " + std::to_string(entry));
+        }
+    }
+}
+
+/*
+ * Compare the histograms of the sum producer in two histogram files, and
+ * check that the event times of each processor were recorded for all events.
+ */
+void compareHistograms(const std::string& first, const std::string& second, int nEvents) {
+    TFile firstFile(first.c_str());
+    TFile secondFile(second.c_str());
+    for (const std::string name : {"sum/nHits", "sum/energy"}) {
+        TH1* a = static_cast<TH1*>(firstFile.Get(name.c_str()));
+        TH1* b = static_cast<TH1*>(secondFile.Get(name.c_str()));
+        if (!a || !b) {
+            throw std::runtime_error("Histogram " + name + " missing in " + (a ? second : first));
+        }
+        if (a->GetEntries() != nEvents || b->GetEntries() != nEvents) {
+            throw std::runtime_error("Histogram " + name + " does not have " + std::to_string(nEvents) + " entries");
+        }
+        for (int bin = 0; bin <= a->GetNbinsX() + 1; bin++) {
+            if (a->GetBinContent(bin) != b->GetBinContent(bin)) {
+                throw std::runtime_error("Different bin " + std::to_string(bin) + " of " + name + " in " + first + " and " + second);
+            }
+        }
+    }
+    for (const std::string name : {"sum", "total"}) {
+        std::string path = "processorStatistics/" + name + "_eventTime";
+        for (TFile* file : {&firstFile, &secondFile}) {
+            TH1* times = static_cast<TH1*>(file->Get(path.c_str()));
+            if (!times || times->GetEntries() != nEvents) {
+                throw std::runtime_error("Event times of " + name + " not recorded for all events in " + file->GetName());
+            }
+        }
+    }
+    firstFile.Close();
+    secondFile.Close();
+}
+
+/*
+ * Check that the output of the threaded event loop is the same as the
+ * output of a single thread, including the input collections which are
+ * copied to the output file from the buffers of the workers.
+ */
+int main(int, const char* argv[])  {
+
+    std::cout << "Hello WorkerPool test!" << std::endl;
+
+    const int nEvents = 500;
+    writeInput("workerpool_test_input.root", nEvents);
+    runProcess("workerpool_test_input.root", "workerpool_test_1.root", "workerpool_test_histos_1.root", 1);
+    runProcess("workerpool_test_input.root", "workerpool_test_2.root", "workerpool_test_histos_2.root", 2);
+    runProcess("workerpool_test_input.root", "workerpool_test_4.root", "workerpool_test_histos_4.root", 4);
+
+    // the histograms and statistics of the copies on the worker threads are merged into the original ones
+    compareHistograms("workerpool_test_histos_1.root", "workerpool_test_histos_2.root", nEvents);
+    compareHistograms("workerpool_test_histos_1.root", "workerpool_test_histos_4.root", nEvents);
+    std::cout << "Histograms with 1, 2 and 4 threads are equal ... okay" << std::endl;
+
+    EventFile single("workerpool_test_1.root");
+    EventImpl singleEvent("check");
+    single.setupEvent(&singleEvent);
+
+    EventFile threaded("workerpool_test_4.root");
+    EventImpl threadedEvent("check");
+    threaded.setupEvent(&threadedEvent);
+
+    if (single.getEntries() != nEvents || threaded.getEntries() != nEvents) {
+        throw std::runtime_error("Expected " + std::to_string(nEvents) + " events, got " + std::to_string(single.getEntries())
+                                 + " and " + std::to_string(threaded.getEntries()));
+    }
+
+    for (int entry = 0; entry < nEvents; entry++) {
+        single.nextEvent();
+        threaded.nextEvent();
+        if (singleEvent.getEventHeader()->getEventNumber() != entry + 1 || threadedEvent.getEventHeader()->getEventNumber() != entry + 1) {
+            throw std::runtime_error("Events out of order in entry " + std::to_string(entry));
+        }
+        for (const std::string name : {"TestHits", "TestSums", "TestTotals"}) {
+            compareCollections(singleEvent.getCollection(name), threadedEvent.getCollection(name), name, entry);
+        }
+        const EcalHit* total = static_cast<const EcalHit*>(threadedEvent.getCollection("TestTotals")->At(0));
+        if (total->getID() != entry + 1) {
+            throw std::runtime_error("Main thread product of entry " + std::to_string(entry) + " made for event " + std::to_string(total->getID()));
+        }
+    }
+
+    std::cout << "Outputs with 1 and 4 threads are equal ... okay" << std::endl;
+
+    single.close();
+    threaded.close();
+    return 0;
+}
@@ -0,0 +1,71 @@
+// LDMX
+#include "Framework/Benchmark.h"
+#include "SimApplication/MagneticFieldMap3D.h"
+
+// STL
+#include <cstdio>
+#include <random>
+#include <vector>
+
+using ldmx::MagneticFieldMap3D;
+
+/*
+ * Microbenchmark of MagneticFieldMap3D::GetFieldValue on a synthetic map,
+ * for random points and for track-like sequences of short steps.
+ */
+int main(int, const char* argv[])  {
+
+    const int nx = 61, ny = 61, nz = 121;
+    const double first[3] = {-600., -600., -1200.}, step[3] = {20., 20., 20.};
+
+    std::string filename = "MagneticFieldMap3D_bench.dat";
+    FILE* file = std::fopen(filename.c_str(), "w");
+    std::fprintf(file, "\n %d %d %d\n 1 X [MILLIMETRE]\n 2 Y [MILLIMETRE]\n 3 Z [MILLIMETRE]\n 4 BX [TESLA]\n 5 BY [TESLA]\n 6 BZ [TESLA]\n 0 [DATA]\n", nx, ny, nz);
+    for (int ix = 0; ix < nx; ix++) {
+        for (int iy = 0; iy < ny; iy++) {
+            for (int iz = 0; iz < nz; iz++) {
+                std::fprintf(file, " %g %g %g %g %g %g\n", first[0] + step[0]*ix, first[1] + step[1]*iy, first[2] + step[2]*iz,
+                             1E-3*ix, 1E-3*iy, -1.5 + 1E-4*iz);
+            }
+        }
+    }
+    std::fclose(file);
+
+    MagneticFieldMap3D fieldMap(filename.c_str(), 0., 0., 0.);
+    std::remove(filename.c_str());
+
+    std::mt19937 generator(1);
+    std::uniform_real_distribution<double> uniform(-1., 1.);
+
+    const int nPoints = 1000000;
+    std::vector<double> points;
+    points.reserve(4*nPoints);
+    for (int i = 0; i < nPoints; i++) {
+        points.insert(points.end(), {590.*uniform(generator), 590.*uniform(generator), 1190.*uniform(generator), 0.});
+    }
+
+    // tracks of 1 mm steps, roughly along z
+    std::vector<double> steps;
+    steps.reserve(4*nPoints);
+    for (int iTrack = 0; iTrack < nPoints/1000; iTrack++) {
+        double x = 300.*uniform(generator), y = 300.*uniform(generator), z = -1150.;
+        double tx = 0.2*uniform(generator), ty = 0.2*uniform(generator);
+        for (int i = 0; i < 1000; i++) {
+            steps.insert(steps.end(), {x + tx*i, y + ty*i, z + i, 0.});
+        }
+    }
+
+    for (auto pattern : {std::make_pair("random", &points), std::make_pair("steps", &steps)}) {
+        const std::vector<double>& input = *pattern.second;
+        double seconds = ldmx::benchmark::measure([&]() {
+            double bfield[3];
+            for (size_t i = 0; i < input.size(); i += 4) {
+                fieldMap.GetFieldValue(&input[i], bfield);
+                ldmx::benchmark::keep(bfield);
+            }
+        });
+        ldmx::benchmark::report(std::string("MagneticFieldMap3D.GetFieldValue.") + pattern.first, (input.size()/4)/seconds, "lookups/s");
+    }
+
+    return 0;
+}
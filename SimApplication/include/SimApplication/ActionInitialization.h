@@ -0,0 +1,63 @@
+/**
+ * @file ActionInitialization.h
+ * @brief Class which builds the Geant4 user actions of each thread
+ */
+
+#ifndef SIMAPPLICATION_ACTIONINITIALIZATION_H_
+#define SIMAPPLICATION_ACTIONINITIALIZATION_H_
+
+// Geant4
+#include "G4VUserActionInitialization.hh"
+
+namespace ldmx {
+
+    class PluginManager;
+    class RootPersistencyManager;
+
+    /**
+     * @class ActionInitialization
+     * @brief Builds the user actions of the sequential run manager or of each worker thread
+     *
+     * @note
+     * In a sequential run, the actions share the plugin manager of the run
+     * manager.  In a multithreaded run, each worker thread gets its own
+     * plugin manager and RootPersistencyManager, with messengers so that
+     * the commands of the macro, which are replayed by Geant4 on every
+     * worker, configure them like the ones of the master thread.  The
+     * persistency manager of a worker only builds the output collections
+     * of its events and hands them to the one of the master thread, which
+     * writes the output file.
+     */
+    class ActionInitialization : public G4VUserActionInitialization {
+
+        public:
+
+            /**
+             * Class constructor.
+             * @param pluginManager The plugin manager of the run manager.
+             * @param writer The persistency manager writing the output file in a
+             * multithreaded run, or null in a sequential run.
+             */
+            ActionInitialization(PluginManager* pluginManager, RootPersistencyManager* writer = nullptr);
+
+            /**
+             * Build the user actions of the sequential run or of a worker thread.
+             */
+            void Build() const;
+
+            /**
+             * Build the user actions of the master thread of a multithreaded run.
+             */
+            void BuildForMaster() const;
+
+        private:
+
+            /** The plugin manager of the run manager. */
+            PluginManager* pluginManager_;
+
+            /** The persistency manager writing the output file in a multithreaded run. */
+            RootPersistencyManager* writer_;
+    };
+}
+
+#endif
@@ -13,6 +13,8 @@
 // LDMX
 #include "DetDescr/DetectorHeader.h"
 
+class G4MagneticField;
+
 namespace ldmx {
 
     /**
@@ -47,10 +49,22 @@ namespace ldmx {
             void readGlobalAuxInfo();
 
             /**
-             * Assign auxiliary info to volumes such as sensitive detectors.
+             * Assign auxiliary info to volumes such as regions and visualization attributes.
              */
             void assignAuxInfoToVolumes();
 
+            /**
+             * Create the sensitive detectors defined in the auxinfo block.
+             * @note These are created by each thread, after the global auxiliary information is read.
+             */
+            void createSensitiveDetectors();
+
+            /**
+             * Assign the sensitive detectors and magnetic fields to volumes, and the global field map.
+             * @note These are assigned by each thread, after its sensitive detectors are created.
+             */
+            void assignSensitiveDetectorsAndFields();
+
             /**
              * Get the detector header that was created from the userinfo block.
              * @return The detector header.
@@ -119,6 +133,11 @@ namespace ldmx {
              * Detector header with name and version.
              */
             ldmx::DetectorHeader* detectorHeader_ {nullptr};
+
+            /**
+             * The field map to assign as the global field, if any.
+             */
+            G4MagneticField* globalField_ {nullptr};
     };
 
 }
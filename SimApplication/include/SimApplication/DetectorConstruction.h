@@ -57,6 +57,8 @@ namespace ldmx {
             G4VPhysicalVolume *Construct();
 
             /**
+             * Construct the sensitive detectors, magnetic fields and biasing
+             * operators, which is done by each worker thread in a multithreaded run.
              */
             void ConstructSDandField();
 
@@ -64,7 +66,7 @@ namespace ldmx {
              * Get the detector header.
              * @return The detector header.
              */
-            ldmx::DetectorHeader* getDetectorHeader() {
+            ldmx::DetectorHeader* getDetectorHeader() const {
                 return auxInfoReader_->getDetectorHeader();
             }
 
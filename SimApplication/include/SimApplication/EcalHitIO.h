@@ -19,6 +19,8 @@
 #include "TClonesArray.h"
 
 // STL
+#include <functional>
+#include <unordered_map>
 #include <utility>
 
 namespace ldmx {
@@ -40,6 +42,15 @@ namespace ldmx {
      * <li>Full hit contributions with one record per step (when compressHitContribs_ is false)
      * <li>No hit contribution information where energy is combined but vectors are not filled (when enableHitContribs_ is false)
      * </ul>
+     *
+     * @par
+     * The SimParticles of the contributions are stored as references, or as indices in the
+     * SimParticle collection when indexHitContribs_ is true.
+     *
+     * @par
+     * When compressing, the existing contribution for a cell, SimParticle and PDG code is
+     * found through a hash map of the contributions of the event, so that the time per
+     * step does not grow with the number of contributions to the cell.
      */
     class EcalHitIO {
 
@@ -88,17 +99,63 @@ namespace ldmx {
                 compressHitContribs_ = compressHitContribs;
             }
 
+            /**
+             * Set whether hit contributions should store the indices of the SimParticles
+             * in their collection instead of references.
+             * @param indexHitContribs True to store indices of SimParticles.
+             */
+            void setIndexHitContribs(bool indexHitContribs) {
+                indexHitContribs_ = indexHitContribs;
+            }
+
         private:
 
+            /**
+             * Key of a hit contribution: the cell ID, the SimParticle index and the PDG code.
+             */
+            struct ContribKey {
+
+                    int hitID;
+                    int particleIndex;
+                    int pdgCode;
+
+                    bool operator==(const ContribKey& other) const {
+                        return hitID == other.hitID && particleIndex == other.particleIndex && pdgCode == other.pdgCode;
+                    }
+            };
+
+            /**
+             * Hash of a hit contribution key.
+             */
+            struct ContribKeyHash {
+
+                    size_t operator()(const ContribKey& key) const {
+                        size_t hash = std::hash<int>()(key.particleIndex);
+                        hash ^= std::hash<int>()(key.hitID) + 0x9e3779b9 + (hash << 6) + (hash >> 2);
+                        hash ^= std::hash<int>()(key.pdgCode) + 0x9e3779b9 + (hash << 6) + (hash >> 2);
+                        return hash;
+                    }
+            };
+
+            /**
+             * Output hits of the event by cell ID.
+             */
+            std::unordered_map<int, SimCalorimeterHit*> hitMap_;
+
+            /**
+             * Index of each contribution of the event in its output hit.
+             */
+            std::unordered_map<ContribKey, int, ContribKeyHash> contribMap_;
+
             /**
              * Access to SimParticle list.
              */
             SimParticleBuilder* simParticleBuilder_;
 
             /**
-             * Hex cell readout.
+             * Hex cell readout, shared by the process.
              */
-            EcalHexReadout hexReadout_;
+            const EcalHexReadout& hexReadout_;
 
             /**
              * ECal detector ID.
@@ -114,6 +171,11 @@ namespace ldmx {
              * Enable compression of hit contributions by SimParticle and PDG code.
              */
             bool compressHitContribs_ {true};
+
+            /**
+             * Store the indices of the SimParticles of the hit contributions instead of references.
+             */
+            bool indexHitContribs_ {false};
     };
 
 } // namespace sim
@@ -65,9 +65,9 @@ namespace ldmx {
         private:
 
             /**
-             * The hex readout defining the cell grid.
+             * The hex readout defining the cell grid, shared by the process.
              */
-            EcalHexReadout* hitMap_;
+            const EcalHexReadout& hitMap_;
 
             /**
              * Map of polygonal layers for getting Z positions.
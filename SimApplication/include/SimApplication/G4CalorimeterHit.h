@@ -10,11 +10,11 @@
 // Geant4
 #include "G4VHit.hh"
 #include "G4THitsCollection.hh"
-#include "G4Allocator.hh"
 #include "G4ThreeVector.hh"
 
 // LDMX
 #include "Event/SimCalorimeterHit.h"
+#include "SimApplication/HitArena.h"
 
 namespace ldmx {
 
@@ -209,24 +209,24 @@ namespace ldmx {
     typedef G4THitsCollection<G4CalorimeterHit> G4CalorimeterHitsCollection;
 
     /**
-     * Memory allocator for objects of this class.
+     * Memory pool for objects of this class in each thread, rewound once all hits of an event are deleted.
+     * Hits are created and deleted by the thread processing the event.
      */
-    extern G4Allocator<G4CalorimeterHit> G4CalorimeterHitAllocator;
+    extern G4ThreadLocal HitArena<G4CalorimeterHit>* G4CalorimeterHitArena;
 
     /**
      * Implementation of custom new operator.
      */
     inline void* G4CalorimeterHit::operator new(size_t) {
-        void* aHit;
-        aHit = (void*) G4CalorimeterHitAllocator.MallocSingle();
-        return aHit;
+        if (!G4CalorimeterHitArena) G4CalorimeterHitArena = new HitArena<G4CalorimeterHit>;
+        return G4CalorimeterHitArena->allocate();
     }
 
     /**
      * Implementation of custom delete operator.
      */
     inline void G4CalorimeterHit::operator delete(void *aHit) {
-        G4CalorimeterHitAllocator.FreeSingle((G4CalorimeterHit*) aHit);
+        G4CalorimeterHitArena->release(aHit);
     }
 
 }
@@ -10,11 +10,11 @@
 // Geant4
 #include "G4VHit.hh"
 #include "G4THitsCollection.hh"
-#include "G4Allocator.hh"
 #include "G4ThreeVector.hh"
 
 // LDMX
 #include "Event/SimTrackerHit.h"
+#include "SimApplication/HitArena.h"
 
 // STL
 #include <ostream>
@@ -320,24 +320,24 @@ namespace ldmx {
     typedef G4THitsCollection<G4TrackerHit> G4TrackerHitsCollection;
 
     /**
-     * Memory allocator for objects of this class.
+     * Memory pool for objects of this class in each thread, rewound once all hits of an event are deleted.
+     * Hits are created and deleted by the thread processing the event.
      */
-    extern G4Allocator<G4TrackerHit> G4TrackerHitAllocator;
+    extern G4ThreadLocal HitArena<G4TrackerHit>* G4TrackerHitArena;
 
     /**
      * Implementation of custom new operator.
      */
     inline void* G4TrackerHit::operator new(size_t) {
-        void* aHit;
-        aHit = (void*) G4TrackerHitAllocator.MallocSingle();
-        return aHit;
+        if (!G4TrackerHitArena) G4TrackerHitArena = new HitArena<G4TrackerHit>;
+        return G4TrackerHitArena->allocate();
     }
 
     /**
      * Implementation of custom delete operator.
      */
     inline void G4TrackerHit::operator delete(void *aHit) {
-        G4TrackerHitAllocator.FreeSingle((G4TrackerHit*) aHit);
+        G4TrackerHitArena->release(aHit);
     }
 
 }
@@ -0,0 +1,99 @@
+/**
+ * @file HitArena.h
+ * @brief Class providing event-scoped pooled memory for Geant4 hit objects
+ */
+
+#ifndef SIMAPPLICATION_HITARENA_H_
+#define SIMAPPLICATION_HITARENA_H_
+
+// STL
+#include <cstddef>
+#include <memory>
+#include <type_traits>
+#include <vector>
+
+namespace ldmx {
+
+    /**
+     * @class HitArena
+     * @brief Pooled memory for hits which are created and destroyed once per event
+     *
+     * @note
+     * Objects are handed out sequentially from fixed-size chunks, so the hits
+     * of one event sit next to each other in memory. Releasing a hit only
+     * decrements the count of live objects; once all of them have been
+     * released, i.e. when the hits collections of the event are deleted, the
+     * whole arena is rewound at once and the chunks are reused for the next
+     * event. The chunks are only freed when the arena is destroyed.
+     *
+     * While any hit is still alive (e.g. an event kept by the visualization),
+     * released memory is not reused and the arena grows instead.
+     */
+    template <class T, std::size_t ChunkSize = 4096>
+    class HitArena {
+
+        public:
+
+            /**
+             * Get memory for one object.
+             * @return Uninitialized memory for an object of type T.
+             */
+            void* allocate() {
+                if (next_ == ChunkSize) {
+                    chunk_++;
+                    next_ = 0;
+                }
+                if (chunk_ == chunks_.size()) {
+                    chunks_.emplace_back(new Slot[ChunkSize]);
+                }
+                live_++;
+                return &chunks_[chunk_][next_++];
+            }
+
+            /**
+             * Give back the memory of one object, rewinding the arena when it was the last one alive.
+             */
+            void release(void*) {
+                if (--live_ == 0) {
+                    chunk_ = 0;
+                    next_ = 0;
+                }
+            }
+
+            /**
+             * Get the number of objects which have not been released.
+             * @return The number of live objects.
+             */
+            std::size_t getLiveCount() const {
+                return live_;
+            }
+
+            /**
+             * Get the number of objects that fit in the chunks allocated so far.
+             * @return The capacity of the arena.
+             */
+            std::size_t getCapacity() const {
+                return chunks_.size() * ChunkSize;
+            }
+
+        private:
+
+            /** Storage for one object. */
+            typedef typename std::aligned_storage<sizeof(T), alignof(T)>::type Slot;
+
+            /** The chunks of storage. */
+            std::vector<std::unique_ptr<Slot[]> > chunks_;
+
+            /** Index of the chunk objects are currently taken from. */
+            std::size_t chunk_{0};
+
+            /** Index of the next free slot in the current chunk. */
+            std::size_t next_{0};
+
+            /** Number of objects handed out and not yet released. */
+            std::size_t live_{0};
+    };
+
+}
+
+#endif
@@ -0,0 +1,87 @@
+/**
+ * @file MTRunManager.h
+ * @brief Class providing a multithreaded Geant4 run manager implementation.
+ */
+
+#ifndef _SIMAPPLICATION_MTRUNMANAGER_H_
+#define _SIMAPPLICATION_MTRUNMANAGER_H_
+
+//------------//
+//   Geant4   //
+//------------//
+#include "G4MTRunManager.hh"
+
+//-------------//
+//   ldmx-sw   //
+//-------------//
+#include "Biasing/BiasingMessenger.h"
+
+class G4PhysListFactory; 
+
+namespace ldmx {
+
+    class ParallelWorldMessenger; 
+    class PluginManager; 
+    class PluginMessenger; 
+
+    /**
+     * @class MTRunManager
+     * @brief Multithreaded counterpart of the RunManager
+     *
+     * @note
+     * The master thread builds the geometry and the physics tables, which
+     * are shared by the worker threads, while each worker builds its own
+     * sensitive detectors, field managers and user actions (see
+     * DetectorConstruction::ConstructSDandField and ActionInitialization).
+     * The output file is written by the RootPersistencyManager of the master
+     * thread.
+     *
+     * The random numbers of each event are seeded by the master from its
+     * engine in event order, so every event is simulated the same way with
+     * any number of threads.
+     */
+    class MTRunManager : public G4MTRunManager {
+
+        public:
+
+            /**
+             * Class constructor.
+             * @param nThreads The number of worker threads.
+             */
+            MTRunManager(int nThreads);
+
+            /**
+             * Class destructor.
+             */
+            virtual ~MTRunManager();
+
+            /**
+             * Perform application initialization.
+             */
+            void Initialize();
+
+        private:
+
+            /** Plugin messenger. */
+            PluginMessenger* pluginMessenger_;
+
+            /** Biasing messenger. */
+            BiasingMessenger* biasingMessenger_ {new BiasingMessenger()};
+
+            /** Parallel world messenger. */
+            ParallelWorldMessenger* pwMessenger_{nullptr};
+
+            /**
+             * Manager of sim plugins, which receives the commands of the master thread.
+             */
+            PluginManager* pluginManager_{nullptr};
+
+            /**
+             * Factory class for instantiating the physics list.
+             */
+            G4PhysListFactory* physicsListFactory_{nullptr};
+
+    }; // MTRunManager
+} // ldmx
+
+#endif // _SIMAPPLICATION_MTRUNMANAGER_H_
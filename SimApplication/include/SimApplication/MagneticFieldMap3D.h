@@ -12,6 +12,8 @@
 #include "G4MagneticField.hh"
 
 // STL
+#include <cstdint>
+#include <string>
 #include <vector>
 using std::vector;
 
@@ -54,6 +56,18 @@ namespace ldmx {
      *
      * x y z B_x B_y B_z
      *
+     * A map can also be converted once with <tt>fieldmap-convert.py</tt> into a binary
+     * file which is memory mapped read-only, so that all the jobs on a node share
+     * a single copy of it in the page cache. The binary file is used if it is
+     * given directly or if it sits next to the ASCII map with a ".bin" suffix.
+     * A binary file next to the ASCII map is only used if the size and modification
+     * time of the ASCII map recorded in its header are still current.
+     * It contains a BinaryHeader, zero padding up to <tt>dataOffset</tt> and then
+     * the (B_x, B_y, B_z) doubles of each grid point, in the order of the ASCII file.
+     * All numbers are little-endian.  The checksum of the values is not verified
+     * when a job maps the file, as reading all of it would defeat the sharing of
+     * the pages; a copied map can be verified once with <tt>fieldmap-convert.py --check</tt>.
+     *
      * Original PurgMagTabulatedField3D code developed by: S.Larsson and J. Generowicz.
      */
 
@@ -68,6 +82,14 @@ namespace ldmx {
              */
             MagneticFieldMap3D(const char* filename, double xOffset, double yOffset, double zOffset);
 
+            /**
+             * Class destructor, unmaps the binary field map if one was used.
+             */
+            virtual ~MagneticFieldMap3D();
+
+            MagneticFieldMap3D(const MagneticFieldMap3D&) = delete;
+            MagneticFieldMap3D& operator=(const MagneticFieldMap3D&) = delete;
+
             /**
              * Implementation of primary virtual method from G4MagneticField interface.
              * @param[in]  point  The point in 3D space.
@@ -75,14 +97,62 @@ namespace ldmx {
              */
             void GetFieldValue(const double point[4], double* bfield) const;
 
+            /**
+             * @struct BinaryHeader
+             * @brief Header of the binary field map format
+             */
+            struct BinaryHeader {
+                char magic[8];          ///< "LDMXBMAP"
+                uint32_t version;       ///< Format version, currently 2
+                uint32_t valueSize;     ///< Bytes per field value, 8 (double)
+                int32_t nx, ny, nz;     ///< Number of grid points along each axis
+                int32_t reserved0;
+                double first[3];        ///< Coordinates of the first grid point in the file [mm]
+                double last[3];         ///< Coordinates of the last grid point in the file [mm]
+                uint32_t checksum;      ///< CRC-32 (as in zlib) of the field values, checked by <tt>fieldmap-convert.py --check</tt>
+                uint32_t reserved1;
+                uint64_t dataOffset;    ///< Position of the field values in the file
+                uint64_t sourceSize;    ///< Size of the ASCII map the file was converted from [bytes] (version 2)
+                int64_t sourceTime;     ///< Modification time of the ASCII map [s since the epoch] (version 2)
+            };
+
         private:
 
+            /**
+             * Read the field values from an ASCII map.
+             * @param[in] filename The name of the ASCII file.
+             * @param[out] first, last The coordinates of the first and last grid points.
+             */
+            void readAscii(const std::string& filename, double first[3], double last[3]);
+
+            /**
+             * Map the field values of a binary map into memory.
+             * @param[in] filename The name of the binary file.
+             * @param[out] first, last The coordinates of the first and last grid points.
+             * @param[in] source The ASCII map the binary file must have been converted
+             * from, or empty if it is not checked.
+             * @return False if the file is not a binary field map.
+             * @throw std::runtime_error if the file looks like a binary map but is invalid,
+             * or if it was not converted from the current version of the source.
+             */
+            bool mapBinary(const std::string& filename, double first[3], double last[3], const std::string& source = "");
+
             /*
-             * Storage space for the table.
+             * The field values (Bx, By, Bz) of each grid point, with z running fastest.
+             * They point either into ownedField_ or into the mapped binary file.
              */
-            vector<vector<vector<double>>> xField_;
-            vector<vector<vector<double>>> yField_;
-            vector<vector<vector<double>>> zField_;
+            const double* field_{nullptr};
+
+            /*
+             * Storage space for a table read from an ASCII file.
+             */
+            vector<double> ownedField_;
+
+            /*
+             * The memory mapped binary file, if any.
+             */
+            void* mapped_{nullptr};
+            size_t mappedSize_{0};
 
             /*
              * The dimensions of the table.
@@ -99,6 +169,21 @@ namespace ldmx {
              */
             double dx_, dy_, dz_;
 
+            /*
+             * Number of grid spacings per mm along each axis.
+             */
+            double invx_{0}, invy_{0}, invz_{0};
+
+            /*
+             * Distance in field_ between neighboring grid points along x and y.
+             */
+            size_t strideX_{0}, strideY_{0};
+
+            /*
+             * Unique ID of this map, used to validate the per-thread cell cache.
+             */
+            unsigned long id_{0};
+
             /*
              * Offsets if field map is not in global coordinates
              */
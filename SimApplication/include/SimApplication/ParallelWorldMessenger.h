@@ -14,22 +14,21 @@
 #include "G4UIcmdWithAString.hh"
 #include "G4UImessenger.hh"
 
-//-------------//
-//   ldmx-sw   //
-//-------------//
-#include "SimApplication/RunManager.h"
+// STL
+#include <string>
 
 namespace ldmx { 
 
-    // Forward declare to avoid circular depedency in headers
-    class RunManager;
-
+    /**
+     * @class ParallelWorldMessenger
+     * @brief Holds the parallel world settings, which are read by the run manager when it is initialized.
+     */
     class ParallelWorldMessenger : public G4UImessenger { 
         
         public: 
 
             /** Constructor */
-            ParallelWorldMessenger(RunManager* runManager);
+            ParallelWorldMessenger();
 
             /** Destructor */
             ~ParallelWorldMessenger(); 
@@ -37,10 +36,22 @@ namespace ldmx {
             /** */
             void SetNewValue(G4UIcommand* command, G4String newValues);
 
+            /** @return True if a parallel world should be registered. */
+            bool isParallelWorldEnabled() const { return isPWEnabled_; }
+
+            /** @return The path to the GDML description of the parallel world. */
+            const std::string& getParallelWorldPath() const { return parallelWorldPath_; }
+
         private: 
 
-            /** Run manager */
-            RunManager* runManager_{nullptr};
+            /** 
+             * Flag indicating whether a parallel world should be 
+             * registered 
+             */
+            bool isPWEnabled_{false};
+
+            /** Path to GDML description of parallel world. */
+            std::string parallelWorldPath_{""};
 
             /** Directory containing all of the parallel world commands. */
             G4UIdirectory* pwDir_{new G4UIdirectory{"/ldmx/pw/"}};
@@ -22,6 +22,11 @@
 #include "SimApplication/G4TrackerHit.h"
 #include "SimApplication/SimParticleBuilder.h"
 
+//----------------//
+//   C++ StdLib   //
+//----------------//
+#include <mutex>
+
 // Forward declarations
 class G4Run; 
 
@@ -31,6 +36,7 @@ namespace ldmx {
     class EcalHitIO; 
     class Event;
     class EventFile;
+    class EventImpl;
     class RunHeader;
     
     /**
@@ -47,6 +53,14 @@ namespace ldmx {
      * individual steps into cell energy depositions.  The tracker hit
      * collections of G4TrackerHit objects are translated directly into 
      * output SimTrackerHit collections.
+     *
+     * In a multithreaded run, each worker thread has its own persistency
+     * manager, which builds the collections of its events in its own event
+     * buffer.  This is done under the lock of the persistency manager of the
+     * master thread, the writer, which owns the output file and writes the
+     * collections of the worker in place by borrowing them, so that the
+     * references between SimParticles and hits are not copied.  Events are
+     * written in the order in which they finish.
      */
     class RootPersistencyManager : public G4PersistencyManager {
 
@@ -56,9 +70,11 @@ namespace ldmx {
 
             /**
              * Class constructor.
-             * Installs the object as the global persistency manager.
+             * Installs the object as the persistency manager of the current thread.
+             * @param writer The persistency manager writing the output file, when
+             * this one belongs to a worker thread, or null if it writes its own events.
              */
-            RootPersistencyManager();
+            RootPersistencyManager(RootPersistencyManager* writer = nullptr);
 
             virtual ~RootPersistencyManager() {
                 for (auto entry : outputHitsCollections_) {
@@ -130,6 +146,18 @@ namespace ldmx {
                 ecalHitIO_->setCompressHitContribs(compressHitContribs);
             }
 
+            /**
+             * Enable or disable storing the hit contributions of SimCalorimeterHits as
+             * indices in the SimParticle collection instead of references.
+             * This is disabled by default.
+             * @param indexHitContribs True to store indices of SimParticles.
+             */
+            void setIndexHitContribs(bool indexHitContribs) {
+                indexHitContribs_ = indexHitContribs;
+                // Pass this flag to the ECal IO helper.
+                ecalHitIO_->setIndexHitContribs(indexHitContribs);
+            }
+
             void setCompressionLevel(int compressionLevel) {
                 compressionLevel_ = compressionLevel;
             }
@@ -160,6 +188,13 @@ namespace ldmx {
 
         private:
 
+            /**
+             * Build the products of an event of a worker thread and write them into the output file.
+             * @param anEvent The Geant4 event of the worker.
+             * @param worker The persistency manager of the worker, which builds the products in its event buffer.
+             */
+            void writeEvent(const G4Event* anEvent, RootPersistencyManager& worker);
+
             /**
              * Build an output event from the current Geant4 event.
              * @param anEvent The Geant4 event.
@@ -174,12 +209,6 @@ namespace ldmx {
              */
             void writeHeader(const G4Event* anEvent, Event* outputEvent);
 
-            /**
-             * Write header info into the output event from Geant4.
-             * @param fileName The filename that stores temporary seeds.
-             */
-            std::string getEventSeeds(std::string fileName = "currentEvent.rndm");
-
             /**
              * Write hits collections from Geant4 into a ROOT event.
              * @param anEvent The Geant4 event.
@@ -252,6 +281,11 @@ namespace ldmx {
              */
             int compressionLevel_ {6};
 
+            /**
+             * Store the hit contributions of SimCalorimeterHits as SimParticle indices.
+             */
+            bool indexHitContribs_ {false};
+
             /**
              * The event container used to manage the tree/branches/collections.
              */
@@ -277,6 +311,16 @@ namespace ldmx {
              */
             HitsCollectionMap outputHitsCollections_;
 
+            /**
+             * The persistency manager writing the output file, or null if this one writes its own events.
+             */
+            RootPersistencyManager* writer_{nullptr};
+
+            /**
+             * Lock for writing the events of the worker threads.
+             */
+            std::mutex writerMutex_;
+
     };
 
 }
@@ -75,6 +75,9 @@ namespace ldmx {
             /** Command used to compress the Ecal hit contributions. */
             G4UIcommand* compressContribsCmd_{nullptr};
 
+            /** Command used to store the hit contributions with SimParticle indices. */
+            G4UIcommand* indexContribsCmd_{nullptr};
+
             /** Command allowing a user to specify a collection name to drop. */
             G4UIcommand* dropCmd_{nullptr}; 
 
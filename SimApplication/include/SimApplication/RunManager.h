@@ -31,6 +31,8 @@ namespace ldmx {
     /**
      * @class RunManager
      * @brief Extension of Geant4 run manager
+     *
+     * @see MTRunManager for the multithreaded run manager.
      */
     class RunManager : public G4RunManager {
 
@@ -47,9 +49,13 @@ namespace ldmx {
             virtual ~RunManager();
 
             /**
-             * Initialize physics.
+             * Initialize physics and register the parallel world, if it is enabled.
+             * This is shared by the sequential and the multithreaded run manager.
+             * @param runManager The run manager to set up.
+             * @param physicsListFactory Factory for the reference physics list.
+             * @param pwMessenger Messenger with the parallel world settings.
              */
-            void setupPhysics();
+            static void setupPhysics(G4RunManager* runManager, G4PhysListFactory* physicsListFactory, const ParallelWorldMessenger* pwMessenger);
 
             /**
              * Perform application initialization.
@@ -62,14 +68,6 @@ namespace ldmx {
              */
             DetectorConstruction* getDetectorConstruction(); 
 
-            /** Enable a parallel world. */
-            void enableParallelWorld(bool isPWEnabled) { isPWEnabled_ = isPWEnabled; }
-
-            /** Set the path to the GDML description of the parallel world. */
-            void setParallelWorldPath(std::string parallelWorldPath) { 
-                parallelWorldPath_ = parallelWorldPath; 
-            }
-
         private:
 
             /** Plugin messenger. */
@@ -91,15 +89,6 @@ namespace ldmx {
              */
             G4PhysListFactory* physicsListFactory_{nullptr};
 
-            /** 
-             * Flag indicating whether a parallel world should be 
-             * registered 
-             */
-            bool isPWEnabled_{false};
-
-            /** Path to GDML description of parallel world. */
-            std::string parallelWorldPath_{""};
-
     }; // RunManager
 } // ldmx
 
@@ -36,6 +36,9 @@ namespace ldmx {
 
             /**
              * Run the application with arguments passed from <i>main()</i>.
+             * The arguments are an optional <i>-t &lt;threads&gt;</i>, which runs the
+             * multithreaded run manager with that many worker threads, and the
+             * macro to execute.  Without a macro, an interactive session is started.
              * @param argc The command line argument count.
              * @param argv The command line arguments.
              */
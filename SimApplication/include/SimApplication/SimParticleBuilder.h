@@ -13,13 +13,12 @@
 #include "Event/SimParticle.h"
 #include "SimApplication/TrackMap.h"
 #include "SimApplication/Trajectory.h"
-#include "SimApplication/TrajectoryContainer.h"
 
 // Geant4
 #include "G4Event.hh"
 
 // STL
-#include <map>
+#include <unordered_map>
 
 namespace ldmx {
 
@@ -32,9 +31,9 @@ namespace ldmx {
         public:
 
             /**
-             * Map of track ID to SimParticles.
+             * Map of track ID to the index of the SimParticle in the output collection.
              */
-            typedef std::map<G4int, SimParticle*> SimParticleMap;
+            typedef std::unordered_map<G4int, int> SimParticleMap;
 
             /**
              * Class constructor.
@@ -57,6 +56,11 @@ namespace ldmx {
             /**
              * Build SimParticle collection into an output event.
              * @param outputEvent The output event.
+             * @note The particles are filled and linked to their parents in one
+             * pass over the trajectories, with the parents found through the
+             * TrackMap.  A particle is made when it is first needed, which is
+             * when its trajectory is reached, unless it is the parent of an earlier
+             * trajectory, as for a track which was suspended after making secondaries.
              */
             void buildSimParticles(Event* outputEvent);
 
@@ -66,6 +70,13 @@ namespace ldmx {
              */
             SimParticle* findSimParticle(G4int trackID);
 
+            /**
+             * Find the index of a SimParticle in the output collection by track ID.
+             * @param trackID The trackID of the particle.
+             * @return The index of the particle or -1 if it was not found.
+             */
+            int findSimParticleIndex(G4int trackID);
+
         private:
 
             /**
@@ -75,16 +86,15 @@ namespace ldmx {
             void buildSimParticle(Trajectory* info);
 
             /**
-             * Build the SimParticle map from the trajectory container.
-             * This will create SimParticles without their information filled.
-             * @param trajectories The input trajectory container.
-             * @param simParticleColl The output SimParticle collection.
+             * Get the SimParticle of a track ID, making an empty one if it does not exist yet.
+             * @param trackID The trackID of the particle.
+             * @return The particle.
              */
-            void buildParticleMap(TrajectoryContainer* trajectories, TClonesArray* simParticleColl);
+            SimParticle* getSimParticle(G4int trackID);
 
         private:
 
-            /** The map of track IDs to SimParticles. */
+            /** The map of track IDs to SimParticle indices, which is a hash index of the particles of the event. */
             SimParticleMap particleMap_;
 
             /** The map of tracks to their parent IDs and Trajectory objects. */
@@ -13,6 +13,9 @@
 
 #include "SimApplication/Trajectory.h"
 
+// STL
+#include <vector>
+
 namespace ldmx {
 
     /**
@@ -23,33 +26,46 @@ namespace ldmx {
      * This class provides a record of track ancestry which is used
      * to connect track IDs to their parents.  It also maps track IDs
      * to Trajectory objects.
+     *
+     * @note
+     * The records are kept in a vector indexed by track ID, as Geant4
+     * numbers the tracks of an event consecutively from 1.  When a track
+     * finishes, the ID of its nearest ancestor with a Trajectory (or its
+     * own ID, if it has one) is resolved from the record of its parent,
+     * which has always finished before, so that finding the Trajectory
+     * of a track does not walk its parentage.  If a track that was
+     * suspended gets a Trajectory after its secondaries were tracked,
+     * the resolved ancestors may be out of date, and the parentage is
+     * walked instead for the rest of the event.
      */
     class TrackMap {
 
         public:
 
-            /**
-             * Map of track ID to parent ID.
-             */
-            typedef std::map<G4int, G4int> TrackIDMap;
-
             /**
              * Add a record in the map connecting a track ID to its parent ID.
              * @param trackID The track ID.
              * @param parentID The parent track ID.
              */
             inline void addSecondary(G4int trackID, G4int parentID) {
-                trackIDMap_[trackID] = parentID;
+                getRecord(trackID).parentID_ = parentID;
             }
 
+            /**
+             * Resolve the nearest ancestor with a Trajectory of a track which
+             * finished tracking.
+             * @param trackID The track ID.
+             */
+            void finishTrack(G4int trackID);
+
             /**
              * Find a trajectory by its track ID.
              * If this track ID does not have a trajectory, then the
              * first trajectory found in its parentage is returned.
-             * @param anEvent The Geant4 event.
-             * @param trackkID The track ID of the trajectory to find.
+             * @param trackID The track ID of the trajectory to find.
+             * @return The trajectory or <i>nullptr</i> if there is none in the parentage.
              */
-            G4VTrajectory* findTrajectory(G4int trackID);
+            G4VTrajectory* findTrajectory(G4int trackID) const;
 
             /**
              * Return true if the given track ID has an explicitly assigned trajectory.
@@ -58,24 +74,22 @@ namespace ldmx {
              * @note This method does <b>not</b> search through the track parentage for
              * the first available Trajectory.
              */
-            inline bool hasTrajectory(G4int trackID) {
-                return trajectoryMap_.find(trackID) != trajectoryMap_.end();
+            inline bool hasTrajectory(G4int trackID) const {
+                return getTrajectory(trackID) != nullptr;
             }
 
             /**
              * Add a Trajectory which will be associated with its track ID in the map.
              * @param traj The Trajectory to add.
              */
-            inline void addTrajectory(Trajectory* traj) {
-                trajectoryMap_[traj->GetTrackID()] = traj;
-            }
+            void addTrajectory(Trajectory* traj);
 
             /**
              * Return true if the track ID is in the map.
              * @return True if the track ID is in the map.
              */
-            bool contains(G4int trackID) {
-                return trackIDMap_.find(trackID) != trackIDMap_.end();
+            bool contains(G4int trackID) const {
+                return isIndexed(trackID) && records_[trackID].parentID_ >= 0;
             }
 
             /**
@@ -84,12 +98,8 @@ namespace ldmx {
              * @note Does not search for a parent Trajectory if this
              * track ID is not assigned to a Trajectory.
              */
-            inline Trajectory* getTrajectory(G4int trackID) {
-                if (hasTrajectory(trackID)) {
-                    return trajectoryMap_[trackID];
-                } else {
-                    return nullptr;
-                }
+            inline Trajectory* getTrajectory(G4int trackID) const {
+                return isIndexed(trackID) ? records_[trackID].trajectory_ : nullptr;
             }
 
             /**
@@ -99,11 +109,43 @@ namespace ldmx {
 
         private:
 
-            /** Map of track IDs to parent IDs. */
-            TrackIDMap trackIDMap_;
+            /**
+             * Ancestry record of one track.
+             */
+            struct Record {
+
+                    /** The parent track ID, or -1 if the track was not processed. */
+                    G4int parentID_{-1};
+
+                    /** The track ID of the nearest ancestor with a Trajectory, or 0 if there is none. */
+                    G4int ancestorID_{0};
+
+                    /** True once the track finished tracking at least once. */
+                    bool finished_{false};
+
+                    /** The Trajectory of the track, if it has one. */
+                    Trajectory* trajectory_{nullptr};
+            };
+
+            /**
+             * @return True if the track ID has a record slot.
+             */
+            bool isIndexed(G4int trackID) const {
+                return trackID > 0 && static_cast<size_t>(trackID) < records_.size();
+            }
+
+            /**
+             * Get the record of a track, making room for it if needed.
+             * @param trackID The track ID.
+             * @return The record of the track.
+             */
+            Record& getRecord(G4int trackID);
+
+            /** Records of the tracks of the event, indexed by track ID. */
+            std::vector<Record> records_;
 
-            /** Map of track IDs to Trajectory objects. */
-            Trajectory::TrajectoryMap trajectoryMap_;
+            /** True if the resolved ancestors can not be used for this event. */
+            bool walkParentage_{false};
     };
 
 }
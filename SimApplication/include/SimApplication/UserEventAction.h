@@ -16,6 +16,9 @@
 #include "G4UserEventAction.hh"
 #include "G4Event.hh"
 
+// STL
+#include <string>
+
 namespace ldmx {
 
     /**
@@ -50,6 +53,14 @@ namespace ldmx {
              */
             void EndOfEventAction(const G4Event* anEvent);
 
+        private:
+
+            /**
+             * Restore the random engine from a state stored in the event header.
+             * @param eventSeed The engine state.
+             */
+            void restoreEngineState(const std::string& eventSeed);
+
     };
 
 }
@@ -0,0 +1,72 @@
+/**
+ * @file UserEventInformation.h
+ * @brief Class that provides extra information for a Geant4 event
+ */
+
+#ifndef SIMAPPLICATION_USEREVENTINFORMATION_H_
+#define SIMAPPLICATION_USEREVENTINFORMATION_H_
+
+// Geant4
+#include "G4VUserEventInformation.hh"
+
+// STL
+#include <string>
+
+namespace ldmx {
+
+    /**
+     * @class UserEventInformation
+     * @brief Defines extra information attached to a Geant4 event
+     *
+     * @note
+     * This is used to hand the random engine state read from an input file by
+     * the RootPrimaryGenerator to the UserEventAction, which restores it before
+     * the event is tracked.
+     */
+    class UserEventInformation : public G4VUserEventInformation {
+
+        public:
+
+            /**
+             * Class Constructor.
+             */
+            UserEventInformation() {;}
+
+            /**
+             * Class destructor.
+             */
+            virtual ~UserEventInformation() {;}
+
+            /**
+             * Set the serialized random engine state to restore for this event.
+             * @param eventSeed The engine state.
+             */
+            void setEventSeed(const std::string& eventSeed) {
+                eventSeed_ = eventSeed;
+            }
+
+            /**
+             * Get the serialized random engine state to restore for this event.
+             * @return The engine state or an empty string if none was set.
+             */
+            const std::string& getEventSeed() const {
+                return eventSeed_;
+            }
+
+            /**
+             * Implement virtual method (no-op).
+             */
+            void Print() const {
+            }
+
+        private:
+
+            /**
+             * The serialized random engine state.
+             */
+            std::string eventSeed_;
+    };
+
+}
+
+#endif
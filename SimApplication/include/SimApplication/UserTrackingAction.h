@@ -49,6 +49,8 @@ namespace ldmx {
             /**
              * Implementation of post-tracking action.
              * @param aTrack The Geant4 track.
+             * @note Resolves the nearest ancestor of the track with a Trajectory
+             * in the TrackMap, after its Trajectory was possibly saved.
              */
             void PostUserTrackingAction(const G4Track* aTrack);
 
@@ -0,0 +1,66 @@
+#include "SimApplication/ActionInitialization.h"
+
+// LDMX
+#include "SimApplication/PrimaryGeneratorAction.h"
+#include "SimApplication/PrimaryGeneratorMessenger.h"
+#include "SimApplication/RootPersistencyManager.h"
+#include "SimApplication/RootPersistencyMessenger.h"
+#include "SimApplication/SteppingAction.h"
+#include "SimApplication/UserEventAction.h"
+#include "SimApplication/UserRunAction.h"
+#include "SimApplication/UserStackingAction.h"
+#include "SimApplication/UserTrackingAction.h"
+#include "SimPlugins/PluginManager.h"
+#include "SimPlugins/PluginMessenger.h"
+
+namespace ldmx {
+
+    ActionInitialization::ActionInitialization(PluginManager* pluginManager, RootPersistencyManager* writer) :
+            pluginManager_(pluginManager), writer_(writer) {
+    }
+
+    void ActionInitialization::Build() const {
+
+        PluginManager* pluginManager = pluginManager_;
+        if (writer_) {
+            // Worker thread: plugins keep per-event state, so each thread loads its own.
+            pluginManager = new PluginManager();
+            new PluginMessenger(pluginManager);
+
+            // Output collections are built by each thread and written by the master.
+            RootPersistencyManager* rootIO = new RootPersistencyManager(writer_);
+            new RootPersistencyMessenger(rootIO);
+        }
+
+        PrimaryGeneratorAction* primaryGeneratorAction = new PrimaryGeneratorAction;
+        SetUserAction(primaryGeneratorAction);
+        new PrimaryGeneratorMessenger(primaryGeneratorAction);
+
+        UserRunAction* runAction = new UserRunAction;
+        UserEventAction* eventAction = new UserEventAction;
+        UserTrackingAction* trackingAction = new UserTrackingAction;
+        SteppingAction* steppingAction = new SteppingAction;
+        UserStackingAction* stackingAction = new UserStackingAction;
+
+        runAction->setPluginManager(pluginManager);
+        eventAction->setPluginManager(pluginManager);
+        trackingAction->setPluginManager(pluginManager);
+        steppingAction->setPluginManager(pluginManager);
+        stackingAction->setPluginManager(pluginManager);
+        primaryGeneratorAction->setPluginManager(pluginManager);
+
+        SetUserAction(runAction);
+        SetUserAction(eventAction);
+        SetUserAction(trackingAction);
+        SetUserAction(steppingAction);
+        SetUserAction(stackingAction);
+    }
+
+    void ActionInitialization::BuildForMaster() const {
+
+        // The master thread only opens and closes the output file, plugins run on the workers.
+        UserRunAction* runAction = new UserRunAction;
+        runAction->setPluginManager(nullptr);
+        SetUserAction(runAction);
+    }
+}
@@ -50,9 +50,7 @@ namespace ldmx {
             G4String auxVal = iaux->value;
             G4String auxUnit = iaux->unit;
 
-            if (auxType == "SensDet") {
-                createSensitiveDetector(auxVal, iaux->auxList);
-            } else if (auxType == "DetectorID") {
+            if (auxType == "DetectorID") {
                 createDetectorID(auxVal, iaux->auxList);
             } else if (auxType == "MagneticField") {
                 createMagneticField(auxVal, iaux->auxList);
@@ -67,6 +65,15 @@ namespace ldmx {
         return;
     }
 
+    void AuxInfoReader::createSensitiveDetectors() {
+        const G4GDMLAuxListType* auxInfoList = parser_->GetAuxList();
+        for (std::vector<G4GDMLAuxStructType>::const_iterator iaux = auxInfoList->begin(); iaux != auxInfoList->end(); iaux++) {
+            if (iaux->type == "SensDet") {
+                createSensitiveDetector(iaux->value, iaux->auxList);
+            }
+        }
+    }
+
     void AuxInfoReader::createSensitiveDetector(G4String theSensDetName, const G4GDMLAuxListType* auxInfoList) {
 
         std::cout << "Creating SensitiveDetector " << theSensDetName << std::endl;
@@ -115,10 +122,13 @@ namespace ldmx {
 
         /*
          * Use the default detector ID or create one from information supplied in the userinfo block, if present.
+         * Each sensitive detector owns its ID, as the sensitive detectors of every thread fill it with field values.
          */
-        DetectorID* detID = new DefaultDetectorID();
-        if (idName != "") {
-            detID = DetectorIDStore::getInstance()->getID(idName);
+        DetectorID* detID = nullptr;
+        if (idName == "") {
+            detID = new DefaultDetectorID();
+        } else {
+            detID = DetectorIDStore::getInstance()->createID(idName);
             if (!detID) {
                 std::cerr << "The Detector ID" << idName << " does not exist.  Is it defined before the SensDet in userinfo?" << std::endl;
                 G4Exception("", "", FatalException, "The referenced Detector ID was not found.");
@@ -132,9 +142,11 @@ namespace ldmx {
         if (sdType == "TrackerSD") {
             sd = new TrackerSD(theSensDetName, hcName, subdetID, detID);
         } else if (sdType == "EcalSD") {
+            delete detID;
             detID = new EcalDetectorID();
             sd = new EcalSD(theSensDetName, hcName, subdetID, detID);
         } else if (sdType == "HcalSD") {
+            delete detID;
             detID = new HcalID();
             sd = new HcalSD(theSensDetName, hcName, subdetID, detID);
         } else if (sdType == "CalorimeterSD") {
@@ -159,6 +171,47 @@ namespace ldmx {
     }
 
     void AuxInfoReader::assignAuxInfoToVolumes() {
+        const G4LogicalVolumeStore* lvs = G4LogicalVolumeStore::GetInstance();
+        std::vector<G4LogicalVolume*>::const_iterator lvciter;
+        for (lvciter = lvs->begin(); lvciter != lvs->end(); lvciter++) {
+            G4GDMLAuxListType auxInfo = parser_->GetVolumeAuxiliaryInformation(*lvciter);
+            if (auxInfo.size() > 0) {
+
+                for (std::vector<G4GDMLAuxStructType>::const_iterator iaux = auxInfo.begin(); iaux != auxInfo.end(); iaux++) {
+
+                    G4String auxType = iaux->type;
+                    G4String auxVal = iaux->value;
+                    G4String auxUnit = iaux->unit;
+
+                    G4LogicalVolume* lv = (*lvciter);
+
+                    if (auxType == "Region") {
+                        G4String regionName = auxVal;
+                        G4Region* region = G4RegionStore::GetInstance()->GetRegion(regionName);
+                        if (region != NULL) {
+                            region->AddRootLogicalVolume(lv);
+                            std::cout << "Added volume " << lv->GetName() << " to region " << regionName << std::endl;
+                        } else {
+                            std::cerr << "Referenced region " << regionName << " was not found!" << std::endl;
+                            G4Exception("", "", FatalException, "The region was not found.  Is it defined in userinfo?");
+                        }
+                    } else if (auxType == "VisAttributes") {
+                        G4String visName = auxVal;
+                        G4VisAttributes* visAttributes = VisAttributesStore::getInstance()->getVisAttributes(visName);
+                        if (visAttributes != NULL) {
+                            lv->SetVisAttributes(visAttributes);
+                            std::cout << "Assigned VisAttributes " << visName << " to volume " << lv->GetName() << std::endl;
+                        } else {
+                            std::cerr << "Referenced VisAttributes " << visName << " was not found!" << std::endl;
+                            G4Exception("", "", FatalException, "The VisAttributes was not found.  Is it defined in userinfo?");
+                        }
+                    }
+                }
+            }
+        }
+    }
+
+    void AuxInfoReader::assignSensitiveDetectorsAndFields() {
         const G4LogicalVolumeStore* lvs = G4LogicalVolumeStore::GetInstance();
         std::vector<G4LogicalVolume*>::const_iterator lvciter;
         for (lvciter = lvs->begin(); lvciter != lvs->end(); lvciter++) {
@@ -194,30 +247,17 @@ namespace ldmx {
                             std::cout << "Unknown MagneticField ref in volume's auxiliary info: " << magFieldName << std::endl;
                             G4Exception("", "", FatalException, "The MagneticField was not found.  Is it defined in userinfo?");
                         }
-                    } else if (auxType == "Region") {
-                        G4String regionName = auxVal;
-                        G4Region* region = G4RegionStore::GetInstance()->GetRegion(regionName);
-                        if (region != NULL) {
-                            region->AddRootLogicalVolume(lv);
-                            std::cout << "Added volume " << lv->GetName() << " to region " << regionName << std::endl;
-                        } else {
-                            std::cerr << "Referenced region " << regionName << " was not found!" << std::endl;
-                            G4Exception("", "", FatalException, "The region was not found.  Is it defined in userinfo?");
-                        }
-                    } else if (auxType == "VisAttributes") {
-                        G4String visName = auxVal;
-                        G4VisAttributes* visAttributes = VisAttributesStore::getInstance()->getVisAttributes(visName);
-                        if (visAttributes != NULL) {
-                            lv->SetVisAttributes(visAttributes);
-                            std::cout << "Assigned VisAttributes " << visName << " to volume " << lv->GetName() << std::endl;
-                        } else {
-                            std::cerr << "Referenced VisAttributes " << visName << " was not found!" << std::endl;
-                            G4Exception("", "", FatalException, "The VisAttributes was not found.  Is it defined in userinfo?");
-                        }
                     }
                 }
             }
         }
+
+        // Assign the field map as the global field.
+        if (globalField_) {
+            G4FieldManager* fieldMgr = G4TransportationManager::GetTransportationManager()->GetFieldManager();
+            fieldMgr->SetDetectorField(globalField_);
+            fieldMgr->CreateChordFinder(globalField_);
+        }
     }
 
     void AuxInfoReader::createDetectorID(G4String idName, const G4GDMLAuxListType* auxInfoList) {
@@ -355,13 +395,11 @@ namespace ldmx {
             // Create new 3D field map.
             G4MagneticField* fieldMap = new MagneticFieldMap3D(fileName.c_str(), offsetX, offsetY, offsetZ);
 
-            // Assign field map as global field.
-            G4FieldManager* fieldMgr = G4TransportationManager::GetTransportationManager()->GetFieldManager();
-            if (fieldMgr->GetDetectorField() != nullptr) {
+            // The field map is assigned as the global field with the sensitive detectors.
+            if (globalField_ != nullptr) {
                 G4Exception("", "", FatalException, "Global mag field was already assigned.");
             }
-            fieldMgr->SetDetectorField(fieldMap);
-            fieldMgr->CreateChordFinder(fieldMap);
+            globalField_ = fieldMap;
 
         } else {
             std::cerr << "Unknown MagFieldType in auxiliary info: " << magFieldType << std::endl;
@@ -18,6 +18,11 @@ namespace ldmx {
 
     void DetectorConstruction::ConstructSDandField() {
 
+        // Sensitive detectors and field managers belong to the thread, so in a
+        // multithreaded run they are made by each worker.
+        auxInfoReader_->createSensitiveDetectors();
+        auxInfoReader_->assignSensitiveDetectorsAndFields();
+
         if (BiasingMessenger::isBiasingEnabled()) {
 
             // Instantiate the biasing operator
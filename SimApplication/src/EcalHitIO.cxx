@@ -1,8 +1,5 @@
 #include "SimApplication/EcalHitIO.h"
 
-// STL
-#include <map>
-
 // LDMX
 #include "Event/SimCalorimeterHit.h"
 #include "Event/SimParticle.h"
@@ -10,13 +7,16 @@
 namespace ldmx {
 
     EcalHitIO::EcalHitIO(SimParticleBuilder* simParticleBuilder) :
-            simParticleBuilder_(simParticleBuilder) {
+            simParticleBuilder_(simParticleBuilder), hexReadout_(EcalHexReadout::getInstance()) {
     }
 
     void EcalHitIO::writeHitsCollection(G4CalorimeterHitsCollection* hc, TClonesArray* outputColl) {
 
         int nHits = hc->GetSize();
-        std::map<int, SimCalorimeterHit*> hitMap;
+
+        // The maps keep their buckets from the previous events.
+        hitMap_.clear();
+        contribMap_.clear();
 
         // Loop over input hits from Geant4.
         for (int iHit = 0; iHit < nHits; iHit++) {
@@ -26,14 +26,14 @@ namespace ldmx {
             int hitID = g4hit->getID();
 
             // See if hit exists in map already.
-            std::map<int, SimCalorimeterHit*>::iterator it = hitMap.find(hitID);
+            auto it = hitMap_.find(hitID);
             SimCalorimeterHit* simHit;
 
             // Is it a new hit?
-            if (it == hitMap.end()) {
+            if (it == hitMap_.end()) {
 
                 // Create sim hit and assign the ID.
-                simHit = (SimCalorimeterHit*) outputColl->ConstructedAt(outputColl->GetEntries());
+                simHit = (SimCalorimeterHit*) outputColl->ConstructedAt(outputColl->GetEntriesFast());
                 simHit->setID(hitID);
 
                 /**
@@ -45,14 +45,14 @@ namespace ldmx {
                 int cellID = detID_.getFieldValue("cell");
                 int moduleID = detID_.getFieldValue("module_position");
                 int cellModuleID = hexReadout_.combineID(cellID,moduleID);
-                std::pair<double,double> XYPair = hexReadout_.getCellCenterAbsolute(cellModuleID);
+                const XYCoords& XYPair = hexReadout_.getCellCenterAbsolute(cellModuleID);
                 simHit->setPosition(XYPair.first, XYPair.second, g4hit->getPosition().z());
 
-                hitMap[hitID] = simHit;
+                hitMap_[hitID] = simHit;
 
             } else {
                 // Get existing hit from map.
-                simHit = hitMap[hitID];
+                simHit = it->second;
             }
 
             // Get info from the G4 hit.
@@ -63,14 +63,20 @@ namespace ldmx {
             // Is hit contrib output enabled?
             if (enableHitContribs_) {
 
-                // Find the SimParticle associated with this hit.
-                SimParticle* simParticle = simParticleBuilder_->findSimParticle(g4hit->getTrackID());
+                // Find the index of the SimParticle associated with this hit.
+                int simParticleIndex = simParticleBuilder_->findSimParticleIndex(g4hit->getTrackID());
 
-                // Find if there is an existing hit contrib.
-                int contribIndex = simHit->findContribIndex(simParticle, pdgCode);
+                // Find if there is an existing hit contrib, or reserve the index of a new one.
+                int contribIndex = -1;
+                if (compressHitContribs_) {
+                    auto inserted = contribMap_.emplace(ContribKey{hitID, simParticleIndex, pdgCode}, simHit->getNumberOfContribs());
+                    if (!inserted.second) {
+                        contribIndex = inserted.first->second;
+                    }
+                }
 
                 // Is contrib output being compressed and a record exists for this SimParticle and PDG code?
-                if (compressHitContribs_ && contribIndex != -1) {
+                if (contribIndex != -1) {
 
                     // Update an existing hit contrib.
                     simHit->updateContrib(contribIndex, edep, time);
@@ -81,7 +87,11 @@ namespace ldmx {
                 } else {
 
                     // Add a hit contrib because all steps are being saved or there is not an existing record.
-                    simHit->addContrib(simParticle, pdgCode, edep, time);
+                    if (indexHitContribs_) {
+                        simHit->addIndexedContrib(simParticleIndex, pdgCode, edep, time);
+                    } else {
+                        simHit->addContrib(simParticleBuilder_->findSimParticle(g4hit->getTrackID()), pdgCode, edep, time);
+                    }
 
                     //std::cout << "added new contrib for hit with ID " << hitID << " with PDGID = "
                     //        << pdgCode << ", edep = " << edep << ", time = " << time << std::endl;
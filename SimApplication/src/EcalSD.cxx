@@ -14,7 +14,7 @@
 namespace ldmx {
 
     EcalSD::EcalSD(G4String name, G4String theCollectionName, int subdetID, DetectorID* detID) :
-            CalorimeterSD(name, theCollectionName, subdetID, detID), hitMap_(new EcalHexReadout) {
+            CalorimeterSD(name, theCollectionName, subdetID, detID), hitMap_(EcalHexReadout::getInstance()) {
     }
 
     EcalSD::~EcalSD() {
@@ -59,8 +59,8 @@ namespace ldmx {
 	layerNumber = int(cpynum/7);
 	int module_position = cpynum%7;
 
-        int cellModuleID = hitMap_->getCellModuleID(hitPosition[0], hitPosition[1]);
-	int cellID = (hitMap_->separateID(cellModuleID)).first;
+        int cellModuleID = hitMap_.getCellModuleID(hitPosition[0], hitPosition[1]);
+	int cellID = (hitMap_.separateID(cellModuleID)).first;
         detID_->setFieldValue(1, layerNumber);
         detID_->setFieldValue(2, module_position);
 	detID_->setFieldValue(3, cellID);
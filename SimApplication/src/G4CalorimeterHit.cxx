@@ -8,7 +8,7 @@
 
 namespace ldmx {
 
-    G4Allocator<G4CalorimeterHit> G4CalorimeterHitAllocator;
+    G4ThreadLocal HitArena<G4CalorimeterHit>* G4CalorimeterHitArena = nullptr;
 
     void G4CalorimeterHit::Draw() {
 
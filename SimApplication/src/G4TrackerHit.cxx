@@ -8,7 +8,7 @@
 
 namespace ldmx {
 
-    G4Allocator<G4TrackerHit> G4TrackerHitAllocator;
+    G4ThreadLocal HitArena<G4TrackerHit>* G4TrackerHitArena = nullptr;
 
     void G4TrackerHit::Draw() {
 
@@ -0,0 +1,55 @@
+#include "SimApplication/MTRunManager.h"
+
+//-------------//
+//   ldmx-sw   //
+//-------------//
+#include "SimApplication/ActionInitialization.h"
+#include "SimApplication/ParallelWorldMessenger.h"
+#include "SimApplication/RootPersistencyManager.h" 
+#include "SimApplication/RootPersistencyMessenger.h"
+#include "SimApplication/RunManager.h"
+#include "SimPlugins/PluginManager.h"
+#include "SimPlugins/PluginMessenger.h"
+
+//------------//
+//   Geant4   //
+//------------//
+#include "G4PhysListFactory.hh"
+
+namespace ldmx {
+
+    MTRunManager::MTRunManager(int nThreads) {
+        pluginManager_ = new PluginManager();
+        pluginMessenger_ = new PluginMessenger(pluginManager_);
+        pwMessenger_ = new ParallelWorldMessenger();
+        
+        // Setup messenger for physics list.
+        physicsListFactory_ = new G4PhysListFactory;
+
+        SetNumberOfThreads(nThreads);
+
+        // Draw new seeds for every event rather than once per worker, so that
+        // the random numbers of an event do not depend on the thread it ran on.
+        SetSeedOncePerCommunication(0);
+    }
+
+    MTRunManager::~MTRunManager() {
+        delete pluginManager_;
+        delete pluginMessenger_;
+        delete physicsListFactory_; 
+    }
+
+    void MTRunManager::Initialize() {
+
+        RunManager::setupPhysics(this, physicsListFactory_, pwMessenger_);
+
+        // The workers build their actions when they are started by the
+        // initialization, so these have to be set before it.
+        RootPersistencyManager* rootIO = new RootPersistencyManager();
+        new RootPersistencyMessenger(rootIO);
+        SetUserInitialization(new ActionInitialization(pluginManager_, rootIO));
+
+        G4MTRunManager::Initialize();
+    }
+
+} // ldmx 
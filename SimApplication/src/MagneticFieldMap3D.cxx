@@ -3,9 +3,18 @@
 // STL
 #include <fstream>
 #include <iostream>
+#include <algorithm>
+#include <atomic>
 #include <cmath>
+#include <cstring>
 #include <stdexcept>
 
+// POSIX
+#include <fcntl.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
+#include <unistd.h>
+
 // Geant4
 #include "globals.hh"
 #include "G4SystemOfUnits.hh"
@@ -14,9 +23,105 @@ using namespace std;
 
 namespace ldmx {
 
+    namespace {
+
+        /**
+         * The grid cell of the last lookup on this thread.  It is zero initialized,
+         * with the ID of no map, as G4ThreadLocal may not allow constructors.
+         */
+        struct LastCell {
+            unsigned long id;
+            int ix, iy, iz;
+            const double* corner;
+        };
+
+        G4ThreadLocal LastCell lastCell;
+
+        /** Counter used to give every map a unique ID. */
+        std::atomic<unsigned long> mapCount{0};
+    }
+
+    static_assert(sizeof(MagneticFieldMap3D::BinaryHeader) == 112, "The binary field map header must not be padded.");
+
     MagneticFieldMap3D::MagneticFieldMap3D(const char* filename, double xOffset, double yOffset, double zOffset) :
             nx_(0), ny_(0), nz_(0), xOffset_(xOffset), yOffset_(yOffset), zOffset_(zOffset), invertX_(false), invertY_(false), invertZ_(false) {
 
+        G4cout << "-----------------------------------------------------------" << G4endl;
+        G4cout << "    Magnetic Field Map 3D" << G4endl;
+        G4cout << "-----------------------------------------------------------" << G4endl<< G4endl;
+
+        G4cout << "Reading the field grid from " << filename << " ... " << endl;
+        G4cout << "  Offsets: " << xOffset << " " << yOffset << " " << zOffset << G4endl;
+
+        // Use a binary map if one was given or if it was converted next to the ASCII one.
+        double first[3], last[3];
+        std::string binaryName = std::string(filename) + ".bin";
+        bool isBinary = mapBinary(filename, first, last);
+        if (!isBinary) {
+            try {
+                isBinary = mapBinary(binaryName, first, last, filename);
+                if (isBinary) G4cout << "  Using binary map " << binaryName << G4endl;
+            } catch (const std::runtime_error& e) {
+                G4cerr << "WARNING: " << e.what() << " Falling back to the ASCII map." << std::endl;
+            }
+        }
+        if (!isBinary) readAscii(filename, first, last);
+
+        minx_ = first[0];
+        miny_ = first[1];
+        minz_ = first[2];
+        maxx_ = last[0];
+        maxy_ = last[1];
+        maxz_ = last[2];
+
+        G4cout << "  Number of values: " << nx_ << " " << ny_ << " " << nz_ << G4endl;
+        G4cout << "  ... done reading " << G4endl<< G4endl;
+        G4cout << "Read values of field from file " << filename << G4endl;
+        G4cout << "  Assumed the order: x, y, z, Bx, By, Bz" << G4endl;
+        G4cout << "  Min values: " << minx_ << " " << miny_ << " " << minz_ << " mm " << G4endl;
+        G4cout << "  Max values: " << maxx_ << " " << maxy_ << " " << maxz_ << " mm " << G4endl;
+        G4cout << "  Field offsets: " << xOffset_ << " " << yOffset_ << " " << zOffset_ << " mm " << G4endl<< G4endl;
+
+        // Should really check that the limits are not the wrong way around.
+        if (maxx_ < minx_) {
+            swap(maxx_, minx_);
+            invertX_ = true;
+        }
+        if (maxy_ < miny_) {
+            swap(maxy_, miny_);
+            invertY_ = true;
+        }
+        if (maxz_ < minz_) {
+            swap(maxz_, minz_);
+            invertZ_ = true;
+        }
+
+        G4cout << "After reordering if necessary" << G4endl;
+        G4cout << "  Min values: " << minx_ << " " << miny_ << " " << minz_ << " mm " << G4endl;
+        G4cout << "  Max values: " << maxx_ << " " << maxy_ << " " << maxz_ << " mm " << G4endl;;
+
+        dx_ = maxx_ - minx_;
+        dy_ = maxy_ - miny_;
+        dz_ = maxz_ - minz_;
+
+        invx_ = (nx_ - 1) / dx_;
+        invy_ = (ny_ - 1) / dy_;
+        invz_ = (nz_ - 1) / dz_;
+        strideY_ = 3 * nz_;
+        strideX_ = strideY_ * ny_;
+        id_ = ++mapCount;
+
+        G4cout << "  Range of values: " << dx_ << " " << dy_ << " " << dz_ << " mm" << G4endl<< G4endl;
+        G4cout << "Done loading field map" << G4endl<< G4endl;
+        G4cout << "-----------------------------------------------------------" << G4endl<< G4endl;
+    }
+
+    MagneticFieldMap3D::~MagneticFieldMap3D() {
+        if (mapped_) munmap(mapped_, mappedSize_);
+    }
+
+    void MagneticFieldMap3D::readAscii(const std::string& filename, double first[3], double last[3]) {
+
         ifstream file(filename); // Open the file for reading.
 
         // Throw an error if file does not exist.
@@ -25,13 +130,6 @@ namespace ldmx {
             throw std::runtime_error("The field map file does not exist.");
         }
 
-        G4cout << "-----------------------------------------------------------" << G4endl;
-        G4cout << "    Magnetic Field Map 3D" << G4endl;
-        G4cout << "-----------------------------------------------------------" << G4endl<< G4endl;
-
-        G4cout << "Reading the field grid from " << filename << " ... " << endl;
-        G4cout << "  Offsets: " << xOffset << " " << yOffset << " " << zOffset << G4endl;
-
         // Ignore first blank line
         char buffer[256];
         file.getline(buffer, 256);
@@ -39,23 +137,8 @@ namespace ldmx {
         // Read table dimensions 
         file >> nx_ >> ny_ >> nz_; // Note dodgy order
 
-        G4cout << "  Number of values: " << nx_ << " " << ny_ << " " << nz_ << G4endl;
-
         // Set up storage space for table
-        xField_.resize(nx_);
-        yField_.resize(nx_);
-        zField_.resize(nx_);
-        int ix, iy, iz;
-        for (ix = 0; ix < nx_; ix++) {
-            xField_[ix].resize(ny_);
-            yField_[ix].resize(ny_);
-            zField_[ix].resize(ny_);
-            for (iy = 0; iy < ny_; iy++) {
-                xField_[ix][iy].resize(nz_);
-                yField_[ix][iy].resize(nz_);
-                zField_[ix][iy].resize(nz_);
-            }
-        }
+        ownedField_.resize(3*nx_*ny_*nz_);
 
         // Ignore other header information    
         // The first line whose second character is '0' is considered to
@@ -66,59 +149,93 @@ namespace ldmx {
 
         // Read in the data
         double xval, yval, zval, bx, by, bz;
+        int ix, iy, iz;
         for (ix = 0; ix < nx_; ix++) {
             for (iy = 0; iy < ny_; iy++) {
                 for (iz = 0; iz < nz_; iz++) {
                     file >> xval >> yval >> zval >> bx >> by >> bz;
                     if (ix == 0 && iy == 0 && iz == 0) {
-                        minx_ = xval;
-                        miny_ = yval;
-                        minz_ = zval;
+                        first[0] = xval;
+                        first[1] = yval;
+                        first[2] = zval;
                     }
-                    xField_[ix][iy][iz] = bx;
-                    yField_[ix][iy][iz] = by;
-                    zField_[ix][iy][iz] = bz;
+                    size_t index = 3*((ix*ny_ + iy)*nz_ + iz);
+                    ownedField_[index] = bx;
+                    ownedField_[index + 1] = by;
+                    ownedField_[index + 2] = bz;
                 }
             }
         }
         file.close();
 
-        maxx_ = xval;
-        maxy_ = yval;
-        maxz_ = zval;
+        last[0] = xval;
+        last[1] = yval;
+        last[2] = zval;
 
-        G4cout << "  ... done reading " << G4endl<< G4endl;
-        G4cout << "Read values of field from file " << filename << G4endl;
-        G4cout << "  Assumed the order: x, y, z, Bx, By, Bz" << G4endl;
-        G4cout << "  Min values: " << minx_ << " " << miny_ << " " << minz_ << " mm " << G4endl;
-        G4cout << "  Max values: " << maxx_ << " " << maxy_ << " " << maxz_ << " mm " << G4endl;
-        G4cout << "  Field offsets: " << xOffset_ << " " << yOffset_ << " " << zOffset_ << " mm " << G4endl<< G4endl;
+        field_ = ownedField_.data();
+    }
 
-        // Should really check that the limits are not the wrong way around.
-        if (maxx_ < minx_) {
-            swap(maxx_, minx_);
-            invertX_ = true;
+    bool MagneticFieldMap3D::mapBinary(const std::string& filename, double first[3], double last[3], const std::string& source) {
+
+        int fd = open(filename.c_str(), O_RDONLY);
+        if (fd < 0) return false;
+
+        struct stat st;
+        BinaryHeader header;
+        if (fstat(fd, &st) != 0 || st.st_size < static_cast<off_t>(sizeof(header))
+                || pread(fd, &header, sizeof(header), 0) != static_cast<ssize_t>(sizeof(header))
+                || std::memcmp(header.magic, "LDMXBMAP", 8) != 0) {
+            close(fd);
+            return false;
         }
-        if (maxy_ < miny_) {
-            swap(maxy_, miny_);
-            invertY_ = true;
+
+        // version 1 files end before the source size and time
+        if (header.version < 2) {
+            header.sourceSize = 0;
+            header.sourceTime = 0;
         }
-        if (maxz_ < minz_) {
-            swap(maxz_, minz_);
-            invertZ_ = true;
+
+        size_t nValues = 3*static_cast<size_t>(header.nx)*header.ny*header.nz;
+        // without the ASCII map next to it, the binary map is the only copy of the field
+        struct stat sourceStat;
+        bool checkSource = !source.empty() && stat(source.c_str(), &sourceStat) == 0;
+
+        std::string error;
+        if (header.version < 1 || header.version > 2 || header.valueSize != sizeof(double)) {
+            error = "unsupported format version " + std::to_string(header.version);
+        } else if (checkSource && header.version < 2) {
+            error = "it does not record which version of " + source + " it was converted from";
+        } else if (checkSource && (static_cast<uint64_t>(sourceStat.st_size) != header.sourceSize
+                    || static_cast<int64_t>(sourceStat.st_mtime) != header.sourceTime)) {
+            error = "it is out of date with " + source;
+        } else if (header.nx < 2 || header.ny < 2 || header.nz < 2 || header.dataOffset % sizeof(double) != 0) {
+            error = "invalid header";
+        } else if (header.dataOffset + nValues*sizeof(double) > static_cast<uint64_t>(st.st_size)) {
+            error = "file is truncated";
         }
 
-        G4cout << "After reordering if necessary" << G4endl;
-        G4cout << "  Min values: " << minx_ << " " << miny_ << " " << minz_ << " mm " << G4endl;
-        G4cout << "  Max values: " << maxx_ << " " << maxy_ << " " << maxz_ << " mm " << G4endl;;
+        void* addr = MAP_FAILED;
+        if (error.empty()) {
+            addr = mmap(nullptr, st.st_size, PROT_READ, MAP_SHARED, fd, 0);
+            if (addr == MAP_FAILED) error = "unable to map the file";
+        }
+        close(fd);
 
-        dx_ = maxx_ - minx_;
-        dy_ = maxy_ - miny_;
-        dz_ = maxz_ - minz_;
+        if (!error.empty()) {
+            throw std::runtime_error("Binary field map " + filename + " is not usable: " + error + ".");
+        }
 
-        G4cout << "  Range of values: " << dx_ << " " << dy_ << " " << dz_ << " mm" << G4endl<< G4endl;
-        G4cout << "Done loading field map" << G4endl<< G4endl;
-        G4cout << "-----------------------------------------------------------" << G4endl<< G4endl;
+        mapped_ = addr;
+        mappedSize_ = st.st_size;
+        field_ = reinterpret_cast<const double*>(static_cast<const char*>(addr) + header.dataOffset);
+        nx_ = header.nx;
+        ny_ = header.ny;
+        nz_ = header.nz;
+        for (int i = 0; i < 3; i++) {
+            first[i] = header.first[i];
+            last[i] = header.last[i];
+        }
+        return true;
     }
 
     void MagneticFieldMap3D::GetFieldValue(const double point[4], double *bfield) const {
@@ -131,53 +248,46 @@ namespace ldmx {
         // Check that the point is within the defined region 
         if (x >= minx_ && x < maxx_-eps && y >= miny_ && y < maxy_-eps && z >= minz_ && z < maxz_-eps) {
 
-            // Position of given point within region, normalized to the range
-            // [0,1]
-            double xfraction = (x - minx_) / dx_;
-            double yfraction = (y - miny_) / dy_;
-            double zfraction = (z - minz_) / dz_;
-
-            if (invertX_) {
-                xfraction = 1 - xfraction;
-            }
-            if (invertY_) {
-                yfraction = 1 - yfraction;
-            }
-            if (invertZ_) {
-                zfraction = 1 - zfraction;
+            // Position of the point in units of the grid spacing, counted
+            // from the first grid point of the table
+            double u = invertX_ ? (maxx_ - x) * invx_ : (x - minx_) * invx_;
+            double v = invertY_ ? (maxy_ - y) * invy_ : (y - miny_) * invy_;
+            double w = invertZ_ ? (maxz_ - z) * invz_ : (z - minz_) * invz_;
+
+            // The indices of the cuboid defined by the nearest surrounding tabulated
+            // points only need to be found when the point leaves the previous cuboid.
+            LastCell& cell = lastCell;
+            if (cell.id != id_ || u < cell.ix || u >= cell.ix + 1 || v < cell.iy || v >= cell.iy + 1 || w < cell.iz || w >= cell.iz + 1) {
+                cell.id = id_;
+                cell.ix = std::min(static_cast<int>(u), nx_ - 2);
+                cell.iy = std::min(static_cast<int>(v), ny_ - 2);
+                cell.iz = std::min(static_cast<int>(w), nz_ - 2);
+                cell.corner = field_ + cell.ix * strideX_ + cell.iy * strideY_ + 3 * cell.iz;
             }
 
-            // Need addresses of these to pass to modf below.
-            // modf uses its second argument as an OUTPUT argument.
-            double xdindex, ydindex, zdindex;
-
-            // Position of the point within the cuboid defined by the
-            // nearest surrounding tabulated points
-            double xlocal = (std::modf(xfraction * (nx_ - 1), &xdindex));
-            double ylocal = (std::modf(yfraction * (ny_ - 1), &ydindex));
-            double zlocal = (std::modf(zfraction * (nz_ - 1), &zdindex));
-
-            // The indices of the nearest tabulated point whose coordinates
-            // are all less than those of the given point
-            int xindex = static_cast<int>(xdindex);
-            int yindex = static_cast<int>(ydindex);
-            int zindex = static_cast<int>(zdindex);
-
-#ifdef DEBUG_INTERPOLATING_FIELD
-            G4cout << "Local x,y,z: " << xlocal << " " << ylocal << " " << zlocal << G4endl;
-            G4cout << "Index x,y,z: " << xindex << " " << yindex << " " << zindex << G4endl;
-            double valx0z0, mulx0z0, valx1z0, mulx1z0;
-            double valx0z1, mulx0z1, valx1z1, mulx1z1;
-            valx0z0= table[xindex ][0][zindex]; mulx0z0= (1-xlocal) * (1-zlocal);
-            valx1z0= table[xindex+1][0][zindex]; mulx1z0= xlocal * (1-zlocal);
-            valx0z1= table[xindex ][0][zindex+1]; mulx0z1= (1-xlocal) * zlocal;
-            valx1z1= table[xindex+1][0][zindex+1]; mulx1z1= xlocal * zlocal;
-#endif
-
-            // Full 3-dimensional version
-            bfield[0] = xField_[xindex][yindex][zindex] * (1 - xlocal) * (1 - ylocal) * (1 - zlocal) + xField_[xindex][yindex][zindex + 1] * (1 - xlocal) * (1 - ylocal) * zlocal + xField_[xindex][yindex + 1][zindex] * (1 - xlocal) * ylocal * (1 - zlocal) + xField_[xindex][yindex + 1][zindex + 1] * (1 - xlocal) * ylocal * zlocal + xField_[xindex + 1][yindex][zindex] * xlocal * (1 - ylocal) * (1 - zlocal) + xField_[xindex + 1][yindex][zindex + 1] * xlocal * (1 - ylocal) * zlocal + xField_[xindex + 1][yindex + 1][zindex] * xlocal * ylocal * (1 - zlocal) + xField_[xindex + 1][yindex + 1][zindex + 1] * xlocal * ylocal * zlocal;
-            bfield[1] = yField_[xindex][yindex][zindex] * (1 - xlocal) * (1 - ylocal) * (1 - zlocal) + yField_[xindex][yindex][zindex + 1] * (1 - xlocal) * (1 - ylocal) * zlocal + yField_[xindex][yindex + 1][zindex] * (1 - xlocal) * ylocal * (1 - zlocal) + yField_[xindex][yindex + 1][zindex + 1] * (1 - xlocal) * ylocal * zlocal + yField_[xindex + 1][yindex][zindex] * xlocal * (1 - ylocal) * (1 - zlocal) + yField_[xindex + 1][yindex][zindex + 1] * xlocal * (1 - ylocal) * zlocal + yField_[xindex + 1][yindex + 1][zindex] * xlocal * ylocal * (1 - zlocal) + yField_[xindex + 1][yindex + 1][zindex + 1] * xlocal * ylocal * zlocal;
-            bfield[2] = zField_[xindex][yindex][zindex] * (1 - xlocal) * (1 - ylocal) * (1 - zlocal) + zField_[xindex][yindex][zindex + 1] * (1 - xlocal) * (1 - ylocal) * zlocal + zField_[xindex][yindex + 1][zindex] * (1 - xlocal) * ylocal * (1 - zlocal) + zField_[xindex][yindex + 1][zindex + 1] * (1 - xlocal) * ylocal * zlocal + zField_[xindex + 1][yindex][zindex] * xlocal * (1 - ylocal) * (1 - zlocal) + zField_[xindex + 1][yindex][zindex + 1] * xlocal * (1 - ylocal) * zlocal + zField_[xindex + 1][yindex + 1][zindex] * xlocal * ylocal * (1 - zlocal) + zField_[xindex + 1][yindex + 1][zindex + 1] * xlocal * ylocal * zlocal;
+            // Position of the point within the cuboid
+            double xlocal = u - cell.ix;
+            double ylocal = v - cell.iy;
+            double zlocal = w - cell.iz;
+
+            // Trilinear weights of the corners
+            double w000 = (1 - xlocal) * (1 - ylocal) * (1 - zlocal);
+            double w001 = (1 - xlocal) * (1 - ylocal) * zlocal;
+            double w010 = (1 - xlocal) * ylocal * (1 - zlocal);
+            double w011 = (1 - xlocal) * ylocal * zlocal;
+            double w100 = xlocal * (1 - ylocal) * (1 - zlocal);
+            double w101 = xlocal * (1 - ylocal) * zlocal;
+            double w110 = xlocal * ylocal * (1 - zlocal);
+            double w111 = xlocal * ylocal * zlocal;
+
+            const double* c000 = cell.corner;
+            const double* c010 = c000 + strideY_;
+            const double* c100 = c000 + strideX_;
+            const double* c110 = c100 + strideY_;
+            for (int i = 0; i < 3; i++) {
+                bfield[i] = c000[i] * w000 + c000[i + 3] * w001 + c010[i] * w010 + c010[i + 3] * w011
+                          + c100[i] * w100 + c100[i + 3] * w101 + c110[i] * w110 + c110[i + 3] * w111;
+            }
 
         } else {
             bfield[0] = 0.0;
@@ -8,8 +8,7 @@
 
 namespace ldmx { 
    
-    ParallelWorldMessenger::ParallelWorldMessenger(RunManager* runManager) :
-   runManager_(runManager) {
+    ParallelWorldMessenger::ParallelWorldMessenger() {
         
         pwDir_->SetGuidance("UI commands specific to parallel worlds.");
         
@@ -18,6 +17,10 @@ namespace ldmx {
         
         readCmd_->SetGuidance("The GDML file containing the description of the parallel world.");
         readCmd_->AvailableForStates(G4ApplicationState::G4State_PreInit); 
+
+        // Only used by the master run manager to build the geometry.
+        enablePWCmd_->SetToBeBroadcasted(false);
+        readCmd_->SetToBeBroadcasted(false);
     }
 
     ParallelWorldMessenger::~ParallelWorldMessenger() { 
@@ -28,7 +31,7 @@ namespace ldmx {
 
     void ParallelWorldMessenger::SetNewValue(G4UIcommand* command, G4String newValues) { 
         
-        if (command == enablePWCmd_) runManager_->enableParallelWorld(true);
-        else if (command == readCmd_) runManager_->setParallelWorldPath(newValues); 
+        if (command == enablePWCmd_) isPWEnabled_ = true;
+        else if (command == readCmd_) parallelWorldPath_ = newValues; 
     }
 }
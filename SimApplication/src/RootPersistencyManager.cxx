@@ -28,7 +28,6 @@
 #include "Event/EventConstants.h"
 #include "SimApplication/CalorimeterSD.h"
 #include "SimApplication/DetectorConstruction.h"
-#include "SimApplication/RunManager.h"
 #include "SimApplication/TrackerSD.h"
 #include "SimApplication/ScoringPlaneSD.h"
 
@@ -42,9 +41,9 @@
 
 namespace ldmx {
 
-    RootPersistencyManager::RootPersistencyManager() :
+    RootPersistencyManager::RootPersistencyManager(RootPersistencyManager* writer) :
         G4PersistencyManager(G4PersistencyCenter::GetPersistencyCenter(), "RootPersistencyManager"), 
-        ecalHitIO_(new EcalHitIO(&simParticleBuilder_)) 
+        ecalHitIO_(new EcalHitIO(&simParticleBuilder_)), writer_(writer)
     {
         G4PersistencyCenter::GetPersistencyCenter()->RegisterPersistencyManager(this);
         G4PersistencyCenter::GetPersistencyCenter()->SetPersistencyManager(this, "RootPersistencyManager");
@@ -64,6 +63,13 @@ namespace ldmx {
             return false;
         }
 
+        if (writer_) {
+            // The writer builds and writes the collections of this worker thread, then the buffer is reused.
+            writer_->writeEvent(anEvent, *this);
+            static_cast<EventImpl*>(event_)->Clear();
+            return true;
+        }
+
         // Build the output collections.
         buildEvent(anEvent, event_);
 
@@ -75,6 +81,22 @@ namespace ldmx {
         return true;
     }
 
+    void RootPersistencyManager::writeEvent(const G4Event* anEvent, RootPersistencyManager& worker) {
+        std::lock_guard<std::mutex> lock(writerMutex_);
+
+        // The references between SimParticles and hits take their IDs from one
+        // counter of the process, so only one event at a time is built.
+        worker.buildEvent(anEvent, worker.event_);
+        worker.printEvent(worker.event_);
+
+        // The collections of the worker are written in place, as the references
+        // only resolve to the objects which were referenced.
+        EventImpl* outputEvent = static_cast<EventImpl*>(event_);
+        writeHeader(anEvent, outputEvent);
+        outputEvent->borrowProducts(*static_cast<EventImpl*>(worker.event_));
+        outputFile_->nextEvent();
+    }
+
     void RootPersistencyManager::writeRunHeader(const G4Run* aRun) {
         RunHeader* runHeader = createRunHeader(aRun);
         outputFile_->writeRunHeader(runHeader);
@@ -82,6 +104,10 @@ namespace ldmx {
     }
 
     G4bool RootPersistencyManager::Store(const G4Run* aRun) {
+
+        // The run of a worker thread is written by the writer with the merged run.
+        if (writer_) return true;
+
         if (m_verbose > 1) {
             std::cout << "[ RootPersistencyManager ] : Storing run " << aRun->GetRunID() << std::endl;
         }
@@ -99,13 +125,16 @@ namespace ldmx {
 
     void RootPersistencyManager::Initialize() {
 
-        if (m_verbose > 1) {
-            std::cout << "[ RootPersistencyManager ] : Opening output file " << fileName_ << std::endl;
-        }
+        // Only the writer opens the output file.
+        if (!writer_) {
+            if (m_verbose > 1) {
+                std::cout << "[ RootPersistencyManager ] : Opening output file " << fileName_ << std::endl;
+            }
 
-        // Create and setup the output file for writing the events.
-        outputFile_ = new EventFile(fileName_.c_str(), true, compressionLevel_);
-        outputFile_->setupEvent((EventImpl*) event_);
+            // Create and setup the output file for writing the events.
+            outputFile_ = new EventFile(fileName_.c_str(), true, compressionLevel_);
+            outputFile_->setupEvent((EventImpl*) event_);
+        }
 
         // Create map with output hits collections.
         setupHitsCollectionMap();
@@ -113,8 +142,8 @@ namespace ldmx {
 
     void RootPersistencyManager::buildEvent(const G4Event* anEvent, Event* outputEvent) {
 
-        // Set basic event information.
-        writeHeader(anEvent, outputEvent);
+        // Set basic event information, which the writer does for the events of worker threads.
+        if (!writer_) writeHeader(anEvent, outputEvent);
 
         // Set pointer to current G4Event.
         simParticleBuilder_.setCurrentEvent(anEvent);
@@ -174,8 +203,8 @@ namespace ldmx {
             eventHeader.setWeight(anEvent->GetPrimaryVertex(0)->GetWeight());
         }
 
-        std::string seedString = getEventSeeds();
-        eventHeader.setStringParameter("eventSeed", seedString);
+        // engine state from before the primaries were generated, stored in the event by the run manager
+        eventHeader.setStringParameter("eventSeed", anEvent->GetRandomNumberStatus());
 
         if (m_verbose > 1) {
             std::cout << "[ RootPersistencyManager ] : Wrote event header for event ID " << anEvent->GetEventID() << std::endl;
@@ -184,15 +213,6 @@ namespace ldmx {
         }
     }
 
-    std::string RootPersistencyManager::getEventSeeds(std::string fileName) {
-        std::ifstream t(fileName);
-        std::stringstream buffer;
-        buffer << t.rdbuf();
-        t.close();
-
-        return buffer.str();
-    }
-
     void RootPersistencyManager::writeHitsCollections(const G4Event* anEvent, Event* outputEvent) {
 
         // Clear the hits from last event.
@@ -282,15 +302,20 @@ namespace ldmx {
             simHit->setID(g4hit->getID());
             const G4ThreeVector& pos = g4hit->getPosition();
             simHit->setPosition(pos.x(), pos.y(), pos.z());
-            SimParticle* particle = simParticleBuilder_.findSimParticle(g4hit->getTrackID());
-            simHit->addContrib(particle, g4hit->getPdgCode(), g4hit->getEdep(), g4hit->getTime());
+            if (indexHitContribs_) {
+                int particleIndex = simParticleBuilder_.findSimParticleIndex(g4hit->getTrackID());
+                simHit->addIndexedContrib(particleIndex, g4hit->getPdgCode(), g4hit->getEdep(), g4hit->getTime());
+            } else {
+                SimParticle* particle = simParticleBuilder_.findSimParticle(g4hit->getTrackID());
+                simHit->addContrib(particle, g4hit->getPdgCode(), g4hit->getEdep(), g4hit->getTime());
+            }
         }
     }
 
     RunHeader* RootPersistencyManager::createRunHeader(const G4Run* aRun) {
 
         // Get detector header from the user detector construction.
-        DetectorConstruction* detector = ((RunManager*) RunManager::GetRunManager())->getDetectorConstruction();
+        auto detector = static_cast<const DetectorConstruction*>(G4RunManager::GetRunManager()->GetUserDetectorConstruction());
         DetectorHeader* detectorHeader = detector->getDetectorHeader();
 
         // Create the run header.
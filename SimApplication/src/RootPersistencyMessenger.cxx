@@ -64,6 +64,12 @@ namespace ldmx {
         compressContribsCmd_->SetParameter(compress);
         compressContribsCmd_->AvailableForStates(G4ApplicationState::G4State_Idle);
         compressContribsCmd_->SetGuidance("Compress hit contributions by matching SimParticle and PDG code");
+
+        indexContribsCmd_ = new G4UIcmdWithABool("/ldmx/persistency/root/indexHitContribs", this);
+        G4UIparameter* index = new G4UIparameter("enable", 'b', true);
+        indexContribsCmd_->SetParameter(index);
+        indexContribsCmd_->AvailableForStates(G4ApplicationState::G4State_Idle);
+        indexContribsCmd_->SetGuidance("Store the SimParticles of hit contributions as indices in their collection instead of references (off by default)");
     
         dropCmd_ = new G4UIcmdWithAString{"/ldmx/persistency/root/dropCol", this}; 
         dropCmd_->AvailableForStates(G4ApplicationState::G4State_Idle);
@@ -83,6 +89,7 @@ namespace ldmx {
         delete enableCmd_;
         delete disableCmd_;
         delete comprCmd_;
+        delete indexContribsCmd_;
         delete rootDir_;
         delete dropCmd_;
         delete descriptionCmd_; 
@@ -115,6 +122,9 @@ namespace ldmx {
             } else if (command == compressContribsCmd_) {
                 rootIO_->setCompressHitContribs(
                         static_cast<G4UIcmdWithABool*>(compressContribsCmd_)->GetNewBoolValue(newValues.c_str()));
+            } else if (command == indexContribsCmd_) {
+                rootIO_->setIndexHitContribs(
+                        static_cast<G4UIcmdWithABool*>(indexContribsCmd_)->GetNewBoolValue(newValues.c_str()));
             } else if (command == dropCmd_) { 
                 rootIO_->dropCollection(newValues); 
             } else if (command == descriptionCmd_) {
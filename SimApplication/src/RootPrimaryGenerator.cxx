@@ -27,6 +27,7 @@
 #include "Event/EventConstants.h"
 #include "Event/SimParticle.h"
 #include "Event/SimTrackerHit.h"
+#include "SimApplication/UserEventInformation.h"
 #include "SimApplication/UserPrimaryParticleInformation.h"
 
 namespace ldmx {
@@ -177,10 +178,10 @@ namespace ldmx {
             std::cerr << "Mode value is invalid!" << std::endl;
         }
 
-        std::ofstream tmpout("tmpEvent.rndm");
-        std::string eventSeed = eventHeader_->getStringParameter("eventSeed");
-        tmpout << eventSeed;
-        tmpout.close();
+        // hand the engine state of the input event to the event action, which restores it
+        UserEventInformation* eventInfo = new UserEventInformation;
+        eventInfo->setEventSeed(eventHeader_->getStringParameter("eventSeed"));
+        anEvent->SetUserInformation(eventInfo);
 
         // move to the next event
         evtCtr_++;
@@ -10,20 +10,14 @@
 //-------------//
 //   ldmx-sw   //
 //-------------//
+#include "SimApplication/ActionInitialization.h"
 #include "SimApplication/APrimePhysics.h"
 #include "SimApplication/DetectorConstruction.h"
 #include "SimApplication/GammaPhysics.h"
 #include "SimApplication/ParallelWorld.h"
 #include "SimApplication/ParallelWorldMessenger.h"
-#include "SimApplication/PrimaryGeneratorAction.h"
-#include "SimApplication/PrimaryGeneratorMessenger.h"
 #include "SimApplication/RootPersistencyMessenger.h"
 #include "SimApplication/RootPersistencyManager.h" 
-#include "SimApplication/SteppingAction.h"
-#include "SimApplication/UserEventAction.h"
-#include "SimApplication/UserRunAction.h"
-#include "SimApplication/UserStackingAction.h"
-#include "SimApplication/UserTrackingAction.h"
 #include "SimPlugins/PluginManager.h"
 #include "SimPlugins/PluginMessenger.h"
 
@@ -42,7 +36,7 @@ namespace ldmx {
     RunManager::RunManager() {
         pluginManager_ = new PluginManager();
         pluginMessenger_ = new PluginMessenger(pluginManager_);
-        pwMessenger_ = new ParallelWorldMessenger(this);
+        pwMessenger_ = new ParallelWorldMessenger();
         
         // Setup messenger for physics list.
         physicsListFactory_ = new G4PhysListFactory;
@@ -54,11 +48,11 @@ namespace ldmx {
         delete physicsListFactory_; 
     }
 
-    void RunManager::setupPhysics() {
+    void RunManager::setupPhysics(G4RunManager* runManager, G4PhysListFactory* physicsListFactory, const ParallelWorldMessenger* pwMessenger) {
 
-        G4VModularPhysicsList* pList = physicsListFactory_->GetReferencePhysList("FTFP_BERT");
+        G4VModularPhysicsList* pList = physicsListFactory->GetReferencePhysList("FTFP_BERT");
         
-        if (isPWEnabled_) {
+        if (pwMessenger->isParallelWorldEnabled()) {
             std::cout << "[ RunManager ]: Parallel worlds physics list has been registered." << std::endl;
             pList->RegisterPhysics(new G4ParallelWorldPhysics("ldmxParallelWorld"));
         }
@@ -80,47 +74,28 @@ namespace ldmx {
             pList->RegisterPhysics(biasingPhysics);
         }
 
-        this->SetUserInitialization(pList);
-    }
-
-    void RunManager::Initialize() {
-        
-        setupPhysics();
+        runManager->SetUserInitialization(pList);
 
         // The parallel world needs to be registered before the mass world is
         // constructed i.e. before G4RunManager::Initialize() is called. 
-        if (isPWEnabled_) {
+        if (pwMessenger->isParallelWorldEnabled()) {
             std::cout << "[ RunManager ]: Parallel worlds have been enabled." << std::endl;
 
             G4GDMLParser* pwParser = new G4GDMLParser();
-            pwParser->Read(parallelWorldPath_);
-            this->getDetectorConstruction()->RegisterParallelWorld(new ParallelWorld(pwParser, "ldmxParallelWorld"));
+            pwParser->Read(pwMessenger->getParallelWorldPath());
+            auto detector = static_cast<DetectorConstruction*>(const_cast<G4VUserDetectorConstruction*>(runManager->GetUserDetectorConstruction()));
+            detector->RegisterParallelWorld(new ParallelWorld(pwParser, "ldmxParallelWorld"));
         }
+    }
+
+    void RunManager::Initialize() {
+        
+        setupPhysics(this, physicsListFactory_, pwMessenger_);
 
         G4RunManager::Initialize();
 
-        PrimaryGeneratorAction* primaryGeneratorAction = new PrimaryGeneratorAction;
-        SetUserAction(primaryGeneratorAction);
-        new PrimaryGeneratorMessenger(primaryGeneratorAction);
-
-        UserRunAction* runAction = new UserRunAction;
-        UserEventAction* eventAction = new UserEventAction;
-        UserTrackingAction* trackingAction = new UserTrackingAction;
-        SteppingAction* steppingAction = new SteppingAction;
-        UserStackingAction* stackingAction = new UserStackingAction;
-
-        runAction->setPluginManager(pluginManager_);
-        eventAction->setPluginManager(pluginManager_);
-        trackingAction->setPluginManager(pluginManager_);
-        steppingAction->setPluginManager(pluginManager_);
-        stackingAction->setPluginManager(pluginManager_);
-        primaryGeneratorAction->setPluginManager(pluginManager_);
-
-        SetUserAction(runAction);
-        SetUserAction(eventAction);
-        SetUserAction(trackingAction);
-        SetUserAction(steppingAction);
-        SetUserAction(stackingAction);
+        // Builds the user actions right away in a sequential run.
+        SetUserInitialization(new ActionInitialization(pluginManager_));
 
         RootPersistencyManager* rootIO = new RootPersistencyManager();
         new RootPersistencyMessenger(rootIO);
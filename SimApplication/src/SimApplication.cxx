@@ -2,12 +2,17 @@
 
 // LDMX
 #include "SimApplication/DetectorConstruction.h"
+#include "SimApplication/MTRunManager.h"
 #include "SimApplication/RunManager.h"
 #include "SimApplication/SimApplicationMessenger.h"
 
 // STL
 #include <vector>
 #include <iostream>
+#include <string>
+
+// ROOT
+#include "TROOT.h"
 
 // Geant4
 #include "G4RunManager.hh"
@@ -31,14 +36,34 @@ namespace ldmx {
 
         std::cout << "[ SimApplication ] : starting" << std::endl;
 
-        // If no arguments then start an interactive session.
+        // An optional "-t <threads>" before the macro selects the multithreaded run manager.
+        int nThreads = 0;
+        int macroArg = 1;
+        if (argc > 2 && std::string(argv[1]) == "-t") {
+            nThreads = std::stoi(argv[2]);
+            macroArg = 3;
+        }
+
+        // If no macro then start an interactive session.
         G4UIExecutive* ui = 0;
-        if (argc == 1) {
+        if (argc == macroArg) {
             ui = new G4UIExecutive(argc, argv);
         }
 
         // Create run manager.
-        G4RunManager* runManager = new RunManager;
+        G4RunManager* runManager = nullptr;
+        if (nThreads > 0) {
+#ifdef G4MULTITHREADED
+            std::cout << "[ SimApplication ] : running with " << nThreads << " worker threads" << std::endl;
+            ROOT::EnableThreadSafety();
+            runManager = new MTRunManager(nThreads);
+#else
+            std::cerr << "[ SimApplication ] : Geant4 was built without multithreading, running sequentially" << std::endl;
+#endif
+        }
+        if (!runManager) {
+            runManager = new RunManager;
+        }
 
         // Setup GDML parser and messenger.
         G4GDMLParser* parser = new G4GDMLParser();
@@ -52,7 +77,8 @@ namespace ldmx {
 
         // Supply default user initializations and actions.
         runManager->SetUserInitialization(new DetectorConstruction(parser));
-        runManager->SetRandomNumberStore(true);
+        // Keep the engine state of each event in memory so it can be written to the event header.
+        runManager->StoreRandomNumberStatusToG4Event(1);
 
         // Initialize G4 visualization framework.
         G4VisManager* visManager = new G4VisExecutive;
@@ -64,7 +90,7 @@ namespace ldmx {
         if (ui == 0) {
             // execute macro provided on command line
             G4String command = "/control/execute ";
-            G4String fileName = argv[1];
+            G4String fileName = argv[macroArg];
             std::cout << "Executing macro " << fileName << " ..." << std::endl;
             UImanager->ApplyCommand(command + fileName);
         } else {
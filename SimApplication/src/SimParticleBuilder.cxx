@@ -32,28 +32,28 @@ namespace ldmx {
         outputParticleColl_->Clear("C");
 
         // Get the trajectory container for the event.
-        TrajectoryContainer* trajectories = (TrajectoryContainer*) (const_cast<G4Event*>(currentEvent_))->GetTrajectoryContainer();
+        G4TrajectoryContainer* trajectories = currentEvent_->GetTrajectoryContainer();
 
-        // Create empty SimParticle objects and create the map of track ID to particles.
-        buildParticleMap(trajectories, outputParticleColl_);
-
-        // Fill information into the particles.
+        // Fill information into the particles and link them to their parents.
+        particleMap_.clear();
+        particleMap_.reserve(trajectories->GetVector()->size());
         for (auto trajectory : *trajectories->GetVector()) {
             buildSimParticle(static_cast<Trajectory*>(trajectory));
         }
 
+        // A parent made for a trajectory which is not in the container is never filled.
+        if (outputParticleColl_->GetEntriesFast() != (int) trajectories->GetVector()->size()) {
+            std::cerr << "[ SimParticleBuilder ] : ERROR - Made " << outputParticleColl_->GetEntriesFast() << " SimParticles for " << trajectories->GetVector()->size() << " trajectories" << std::endl;
+            G4Exception("SimParticleBuilder::buildSimParticles", "", FatalException, "Parent SimParticle has no trajectory.");
+        }
+
         // Add the collection data to the output event.
         outputEvent->add("SimParticles", outputParticleColl_);
     }
 
     void SimParticleBuilder::buildSimParticle(Trajectory* traj) {
 
-        SimParticle* simParticle = particleMap_[traj->GetTrackID()];
-
-        if (!simParticle) {
-            std::cerr << "[ SimParticleBuilder ] : SimParticle not found for Trajectory with track ID " << traj->GetTrackID() << std::endl;
-            G4Exception("SimParticleBuilder::buildSimParticle", "", FatalException, "SimParticle not found for Trajectory.");
-        }
+        SimParticle* simParticle = getSimParticle(traj->GetTrackID());
 
         simParticle->setGenStatus(traj->getGenStatus());
         simParticle->setTrackID(traj->GetTrackID());
@@ -77,8 +77,9 @@ namespace ldmx {
         simParticle->setEndPoint(endpoint[0], endpoint[1], endpoint[2]);
 
         if (traj->GetParentID() > 0) {
-            SimParticle* parent = findSimParticle(traj->GetParentID());
-            if (parent != nullptr) {
+            G4VTrajectory* parentTraj = trackMap_->findTrajectory(traj->GetParentID());
+            if (parentTraj != nullptr) {
+                SimParticle* parent = getSimParticle(parentTraj->GetTrackID());
                 simParticle->addParent(parent);
                 parent->addDaughter(simParticle);
             } else {
@@ -89,19 +90,26 @@ namespace ldmx {
         }
     }
 
-    void SimParticleBuilder::buildParticleMap(TrajectoryContainer* trajectories, TClonesArray* simParticleColl) {
-        particleMap_.clear();
-        for (auto trajectory : *trajectories->GetVector()) {
-            particleMap_[trajectory->GetTrackID()] = (SimParticle*) simParticleColl->ConstructedAt(simParticleColl->GetEntries());
-        }
+    SimParticle* SimParticleBuilder::getSimParticle(G4int trackID) {
+        auto it = particleMap_.find(trackID);
+        if (it != particleMap_.end()) return (SimParticle*) outputParticleColl_->At(it->second);
+        int index = outputParticleColl_->GetEntriesFast();
+        particleMap_[trackID] = index;
+        return (SimParticle*) outputParticleColl_->ConstructedAt(index);
     }
 
     SimParticle* SimParticleBuilder::findSimParticle(G4int trackID) {
+        int index = findSimParticleIndex(trackID);
+        return index >= 0 ? (SimParticle*) outputParticleColl_->At(index) : nullptr;
+    }
+
+    int SimParticleBuilder::findSimParticleIndex(G4int trackID) {
         G4VTrajectory* traj = trackMap_->findTrajectory(trackID);
         if (traj != nullptr) {
-            return particleMap_[traj->GetTrackID()];
+            auto it = particleMap_.find(traj->GetTrackID());
+            return it != particleMap_.end() ? it->second : -1;
         } else {
-            return nullptr;
+            return -1;
         }
     }
 
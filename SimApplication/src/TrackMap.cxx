@@ -3,32 +3,63 @@
 // Geant4
 #include "G4EventManager.hh"
 #include "G4Event.hh"
+#include "G4Exception.hh"
 
 // LDMX
 #include "SimApplication/Trajectory.h"
 
+// STL
+#include <algorithm>
+
 namespace ldmx {
 
-    G4VTrajectory* TrackMap::findTrajectory(G4int trackID) {
-        G4int currTrackID = trackID;
-        G4VTrajectory* traj = nullptr;
-        for (;;) {
-            traj = trajectoryMap_[currTrackID];
-            if (traj) {
-                break;
-            } else {
-                if (trackIDMap_.find(currTrackID) != trackIDMap_.end()) {
-                    currTrackID = trackIDMap_[currTrackID];
-                } else {
-                    break;
-                }
+    void TrackMap::finishTrack(G4int trackID) {
+        Record& record = getRecord(trackID);
+        if (record.trajectory_) {
+            record.ancestorID_ = trackID;
+        } else if (isIndexed(record.parentID_)) {
+            record.ancestorID_ = records_[record.parentID_].ancestorID_;
+        } else {
+            record.ancestorID_ = 0;
+        }
+        record.finished_ = true;
+    }
+
+    G4VTrajectory* TrackMap::findTrajectory(G4int trackID) const {
+        if (!walkParentage_ && isIndexed(trackID) && records_[trackID].finished_) {
+            G4int ancestorID = records_[trackID].ancestorID_;
+            return ancestorID > 0 ? records_[ancestorID].trajectory_ : nullptr;
+        }
+        for (G4int currTrackID = trackID; isIndexed(currTrackID); currTrackID = records_[currTrackID].parentID_) {
+            if (records_[currTrackID].trajectory_) {
+                return records_[currTrackID].trajectory_;
             }
         }
-        return traj;
+        return nullptr;
+    }
+
+    void TrackMap::addTrajectory(Trajectory* traj) {
+        Record& record = getRecord(traj->GetTrackID());
+        record.trajectory_ = traj;
+        if (record.finished_) {
+            // The secondaries of this track may have resolved an older ancestor.
+            walkParentage_ = true;
+        }
+    }
+
+    TrackMap::Record& TrackMap::getRecord(G4int trackID) {
+        if (trackID <= 0) {
+            G4Exception("TrackMap::getRecord", "", FatalException, "Track IDs must be positive.");
+        }
+        if (static_cast<size_t>(trackID) >= records_.size()) {
+            records_.resize(std::max(static_cast<size_t>(trackID) + 1, 2*records_.size()));
+        }
+        return records_[trackID];
     }
 
     void TrackMap::clear() {
-        trackIDMap_.clear();
-        trajectoryMap_.clear();
+        // the capacity is kept for the next event
+        records_.clear();
+        walkParentage_ = false;
     }
 }
@@ -4,6 +4,7 @@
 #include "SimApplication/RootPersistencyManager.h"
 #include "SimApplication/TrackMap.h"
 #include "SimApplication/TrajectoryContainer.h"
+#include "SimApplication/UserEventInformation.h"
 #include "SimApplication/UserTrackingAction.h"
 #include "SimPlugins/PluginManager.h"
 
@@ -13,7 +14,9 @@
 
 // STL
 #include <iostream>
+#include <sstream>
 #include <stdio.h>
+#include <stdlib.h>
 #include <time.h>
 
 namespace ldmx {
@@ -26,13 +29,15 @@ namespace ldmx {
         // Install custom trajectory container for the event.
         //G4EventManager::GetEventManager()->GetNonconstCurrentEvent()->SetTrajectoryContainer(new TrajectoryContainer);
 
-        // G4Random::showEngineStatus();
-        // G4Random::saveEngineStatus();
-        // G4Random::getTheEngine();
-        if (PrimaryGeneratorMessenger::useRootSeed())
-            G4Random::restoreEngineStatus("tmpEvent.rndm"); // this line will be needed to read in a set of seeds
+        // Restore the engine state of the input event when regenerating it.
+        if (PrimaryGeneratorMessenger::useRootSeed()) {
+            auto eventInfo = dynamic_cast<UserEventInformation*>(anEvent->GetUserInformation());
+            if (eventInfo && !eventInfo->getEventSeed().empty()) {
+                restoreEngineState(eventInfo->getEventSeed());
+            }
+        }
 
-            // Activate user plugins.
+        // Activate user plugins.
         pluginManager_->beginEvent(anEvent);
     }
 
@@ -40,4 +45,32 @@ namespace ldmx {
         pluginManager_->endEvent(anEvent);
     }
 
+    void UserEventAction::restoreEngineState(const std::string& eventSeed) {
+
+        // States saved with the engine's put() start with its begin marker
+        // and are read back directly from memory.
+        std::istringstream is(eventSeed);
+        std::string marker;
+        is >> marker;
+        if (marker.size() > 6 && marker.compare(marker.size() - 6, 6, "-begin") == 0) {
+            is.seekg(0);
+            G4Random::restoreFullState(is);
+            return;
+        }
+
+        // Files written before the state was kept in memory hold the engine's
+        // saveStatus() format, which can only be read back from a file.
+        char path[] = "/tmp/ldmxEventSeedXXXXXX";
+        int fd = mkstemp(path);
+        if (fd < 0) {
+            std::cerr << "[ UserEventAction ] : Failed to create a file to restore the event seed from." << std::endl;
+            return;
+        }
+        FILE* file = fdopen(fd, "w");
+        fputs(eventSeed.c_str(), file);
+        fclose(file);
+        G4Random::restoreEngineStatus(path);
+        remove(path);
+    }
+
 }
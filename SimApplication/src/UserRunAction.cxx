@@ -19,13 +19,14 @@ namespace ldmx {
             RootPersistencyManager::getInstance()->Initialize();
         }
 
-        pluginManager_->beginRun(aRun);
+        // The master thread of a multithreaded run has no plugins.
+        if (pluginManager_) pluginManager_->beginRun(aRun);
 
     }
 
     void UserRunAction::EndOfRunAction(const G4Run* aRun) {
 
-        pluginManager_->endRun(aRun);
+        if (pluginManager_) pluginManager_->endRun(aRun);
     }
 
 }
@@ -59,6 +59,9 @@ namespace ldmx {
                 }
             }
         }
+
+        // Resolve the nearest saved ancestor while the parent records are final.
+        trackMap_.finishTrack(aTrack->GetTrackID());
     }
 
     void UserTrackingAction::storeTrajectory(const G4Track* aTrack) {
@@ -0,0 +1,166 @@
+// LDMX
+#include "SimApplication/MagneticFieldMap3D.h"
+
+// STL
+#include <cmath>
+#include <cstdio>
+#include <cstring>
+#include <iostream>
+#include <random>
+#include <stdexcept>
+#include <vector>
+
+using ldmx::MagneticFieldMap3D;
+using std::vector;
+
+/*
+ * The original interpolation with one nested vector per field component,
+ * used as the reference for MagneticFieldMap3D::GetFieldValue.
+ */
+class ReferenceFieldMap {
+
+    public:
+
+        ReferenceFieldMap(int nx, int ny, int nz, const double first[3], const double last[3], const vector<double>& values) :
+                nx_(nx), ny_(ny), nz_(nz) {
+            xField_.assign(nx, vector<vector<double>>(ny, vector<double>(nz)));
+            yField_ = xField_;
+            zField_ = xField_;
+            for (int ix = 0; ix < nx; ix++) {
+                for (int iy = 0; iy < ny; iy++) {
+                    for (int iz = 0; iz < nz; iz++) {
+                        size_t index = 3*((ix*ny + iy)*nz + iz);
+                        xField_[ix][iy][iz] = values[index];
+                        yField_[ix][iy][iz] = values[index + 1];
+                        zField_[ix][iy][iz] = values[index + 2];
+                    }
+                }
+            }
+            min_[0] = std::min(first[0], last[0]); max_[0] = std::max(first[0], last[0]); invert_[0] = last[0] < first[0];
+            min_[1] = std::min(first[1], last[1]); max_[1] = std::max(first[1], last[1]); invert_[1] = last[1] < first[1];
+            min_[2] = std::min(first[2], last[2]); max_[2] = std::max(first[2], last[2]); invert_[2] = last[2] < first[2];
+        }
+
+        void GetFieldValue(const double point[3], double* bfield) const {
+            double eps = 1E-6;
+            if (!(point[0] >= min_[0] && point[0] < max_[0]-eps && point[1] >= min_[1] && point[1] < max_[1]-eps
+                        && point[2] >= min_[2] && point[2] < max_[2]-eps)) {
+                bfield[0] = bfield[1] = bfield[2] = 0;
+                return;
+            }
+            double fraction[3];
+            for (int i = 0; i < 3; i++) {
+                fraction[i] = (point[i] - min_[i]) / (max_[i] - min_[i]);
+                if (invert_[i]) fraction[i] = 1 - fraction[i];
+            }
+            double xdindex, ydindex, zdindex;
+            double xlocal = (std::modf(fraction[0] * (nx_ - 1), &xdindex));
+            double ylocal = (std::modf(fraction[1] * (ny_ - 1), &ydindex));
+            double zlocal = (std::modf(fraction[2] * (nz_ - 1), &zdindex));
+            int xindex = static_cast<int>(xdindex);
+            int yindex = static_cast<int>(ydindex);
+            int zindex = static_cast<int>(zdindex);
+            const vector<vector<vector<double>>>* fields[3] = {&xField_, &yField_, &zField_};
+            for (int i = 0; i < 3; i++) {
+                const vector<vector<vector<double>>>& f = *fields[i];
+                bfield[i] = f[xindex][yindex][zindex] * (1 - xlocal) * (1 - ylocal) * (1 - zlocal) + f[xindex][yindex][zindex + 1] * (1 - xlocal) * (1 - ylocal) * zlocal
+                    + f[xindex][yindex + 1][zindex] * (1 - xlocal) * ylocal * (1 - zlocal) + f[xindex][yindex + 1][zindex + 1] * (1 - xlocal) * ylocal * zlocal
+                    + f[xindex + 1][yindex][zindex] * xlocal * (1 - ylocal) * (1 - zlocal) + f[xindex + 1][yindex][zindex + 1] * xlocal * (1 - ylocal) * zlocal
+                    + f[xindex + 1][yindex + 1][zindex] * xlocal * ylocal * (1 - zlocal) + f[xindex + 1][yindex + 1][zindex + 1] * xlocal * ylocal * zlocal;
+            }
+        }
+
+    private:
+
+        int nx_, ny_, nz_;
+        double min_[3], max_[3];
+        bool invert_[3];
+        vector<vector<vector<double>>> xField_, yField_, zField_;
+};
+
+int main(int, const char* argv[])  {
+
+    std::cout << "Hello MagneticFieldMap3D test!" << std::endl;
+
+    // small synthetic map, with y running backwards like in some of the real maps
+    const int nx = 21, ny = 17, nz = 31;
+    const double first[3] = {-500., 320., -1000.}, step[3] = {50., -40., 66.5};
+    double last[3];
+    for (int i = 0; i < 3; i++) last[i] = first[i] + step[i]*((i == 0 ? nx : i == 1 ? ny : nz) - 1);
+
+    std::mt19937 generator(12345);
+    std::normal_distribution<double> gauss(0., 1.);
+    vector<double> values;
+    std::string filename = "MagneticFieldMap3D_test.dat";
+    FILE* file = std::fopen(filename.c_str(), "w");
+    std::fprintf(file, "\n %d %d %d\n 1 X [MILLIMETRE]\n 2 Y [MILLIMETRE]\n 3 Z [MILLIMETRE]\n 4 BX [TESLA]\n 5 BY [TESLA]\n 6 BZ [TESLA]\n 0 [DATA]\n", nx, ny, nz);
+    for (int ix = 0; ix < nx; ix++) {
+        for (int iy = 0; iy < ny; iy++) {
+            for (int iz = 0; iz < nz; iz++) {
+                double b[3] = {gauss(generator), gauss(generator), -1.5 + 0.1*gauss(generator)};
+                std::fprintf(file, " %.17g %.17g %.17g %.17g %.17g %.17g\n", first[0] + step[0]*ix, first[1] + step[1]*iy, first[2] + step[2]*iz, b[0], b[1], b[2]);
+                values.insert(values.end(), b, b + 3);
+            }
+        }
+    }
+    std::fclose(file);
+
+    // a binary map converted from another version of the ASCII map must be ignored
+    MagneticFieldMap3D::BinaryHeader header;
+    std::memset(&header, 0, sizeof(header));
+    std::memcpy(header.magic, "LDMXBMAP", 8);
+    header.version = 2;
+    header.valueSize = sizeof(double);
+    header.nx = nx;
+    header.ny = ny;
+    header.nz = nz;
+    header.dataOffset = sizeof(header);
+    header.sourceSize = 1;
+    std::string staleName = filename + ".bin";
+    vector<double> zeros(values.size());
+    file = std::fopen(staleName.c_str(), "wb");
+    std::fwrite(&header, sizeof(header), 1, file);
+    std::fwrite(zeros.data(), sizeof(double), zeros.size(), file);
+    std::fclose(file);
+
+    double offset[3] = {10., -5., 250.};
+    MagneticFieldMap3D fieldMap(filename.c_str(), offset[0], offset[1], offset[2]);
+    ReferenceFieldMap reference(nx, ny, nz, first, last, values);
+    std::remove(filename.c_str());
+    std::remove(staleName.c_str());
+
+    // random points in and around the map, and short random walks which mostly stay in the same cell
+    std::uniform_real_distribution<double> ux(-530., 530.), uy(-350., 340.), uz(-1020., 1030.), ustep(-5., 5.);
+    int nFailed = 0, nChecked = 0;
+    double maxDiff = 0;
+    for (int iPoint = 0; iPoint < 20000; iPoint++) {
+        double local[3] = {ux(generator), uy(generator), uz(generator)};
+        for (int iStep = 0; iStep < 10; iStep++) {
+            double point[4] = {local[0] + offset[0], local[1] + offset[1], local[2] + offset[2], 0.};
+            double bfield[3], expected[3];
+            fieldMap.GetFieldValue(point, bfield);
+            reference.GetFieldValue(local, expected);
+            for (int i = 0; i < 3; i++) {
+                double diff = std::fabs(bfield[i] - expected[i]);
+                maxDiff = std::max(maxDiff, diff);
+                if (diff > 1E-9) {
+                    if (nFailed < 10) {
+                        std::cout << "Mismatch at (" << local[0] << ", " << local[1] << ", " << local[2] << ") component " << i
+                                  << ": " << bfield[i] << " instead of " << expected[i] << std::endl;
+                    }
+                    nFailed++;
+                }
+            }
+            nChecked++;
+            for (int i = 0; i < 3; i++) local[i] += ustep(generator);
+        }
+    }
+
+    std::cout << "Checked " << nChecked << " points, largest difference " << maxDiff << std::endl;
+    if (nFailed > 0) {
+        throw std::runtime_error("MagneticFieldMap3D differs from the reference interpolation for " + std::to_string(nFailed) + " values");
+    }
+    std::cout << "MagneticFieldMap3D interpolation okay" << std::endl;
+
+    return 0;
+}
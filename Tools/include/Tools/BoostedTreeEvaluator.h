@@ -0,0 +1,96 @@
+/**
+ * @file BoostedTreeEvaluator.h
+ * @brief Native evaluator for gradient boosted decision tree ensembles.
+ */
+
+#ifndef TOOLS_BOOSTEDTREEEVALUATOR_H
+#define TOOLS_BOOSTEDTREEEVALUATOR_H
+
+//----------------//
+//   C++ StdLib   //
+//----------------//
+#include <string>
+#include <vector>
+
+namespace ldmx {
+
+    /**
+     * @class BoostedTreeEvaluator
+     * @brief Scores feature vectors with a tree ensemble trained by xgboost.
+     *
+     * The model is read once from the text dump written by
+     * <tt>Booster.dump_model(fname)</tt> and stored as flat node arrays, so
+     * evaluating an event is a walk down each tree without any allocation.
+     * Features are referred to by index, as for a DMatrix built from a plain
+     * array (f0, f1, ...).
+     */
+    class BoostedTreeEvaluator {
+
+        public:
+
+            /**
+             * Constructor
+             *
+             * @param modelFile Text dump of the xgboost model.
+             * @param baseScore The global bias (base_score) used when training.
+             * @param logistic Apply the logistic transformation to the summed
+             *                 margin, as for the binary:logistic objective.
+             * @throw std::runtime_error if the model file can't be parsed.
+             */
+            BoostedTreeEvaluator(const std::string& modelFile, float baseScore = 0.5, bool logistic = true);
+
+            /** Destructor */
+            ~BoostedTreeEvaluator() { }
+
+            /**
+             * Score a single feature vector.
+             *
+             * @param features The features, in the order used for training.
+             *                 NaN values follow the default ("missing") branch.
+             * @return The prediction for the given features.
+             */
+            float predict(const std::vector<float>& features) const;
+
+            /** @return The number of trees in the ensemble. */
+            unsigned int getNTrees() const { return roots_.size(); }
+
+            /** @return The largest feature index used by the ensemble plus one. */
+            unsigned int getNFeatures() const { return nFeatures_; }
+
+        private:
+
+            /** Index of the root node of each tree. */
+            std::vector<int> roots_;
+
+            /** Feature index tested by each node, -1 for leaves. */
+            std::vector<int> feature_;
+
+            /** Split threshold of each node, features below it go to 'yes'. */
+            std::vector<float> threshold_;
+
+            /** Node to go to if the feature is below the threshold. */
+            std::vector<int> yes_;
+
+            /** Node to go to if the feature is above the threshold. */
+            std::vector<int> no_;
+
+            /** Node to go to if the feature is missing. */
+            std::vector<int> missing_;
+
+            /** Leaf values. */
+            std::vector<float> value_;
+
+            /** Margin corresponding to the base score. */
+            float baseMargin_{0};
+
+            /** Logistic transformation flag. */
+            bool logistic_{true};
+
+            /** Number of features used by the model. */
+            unsigned int nFeatures_{0};
+
+    }; // BoostedTreeEvaluator
+
+} // ldmx
+
+#endif // TOOLS_BOOSTEDTREEEVALUATOR_H
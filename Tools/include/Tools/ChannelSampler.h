@@ -0,0 +1,93 @@
+/**
+ * @file ChannelSampler.h
+ * @brief Utility used to draw distinct empty channels for noise hits.
+ */
+
+#ifndef TOOLS_CHANNELSAMPLER_H
+#define TOOLS_CHANNELSAMPLER_H
+
+//----------------//
+//   C++ StdLib   //
+//----------------//
+#include <vector>
+
+// Forward declarations
+class TRandom;
+
+namespace ldmx {
+
+    /**
+     * @class ChannelSampler
+     * @brief Draws channels without replacement from the channels which are empty in an event.
+     *
+     * @note
+     * The channels are numbered from 0 to the channel count.  They are kept
+     * in a permutation whose first entries are the channels which are no
+     * longer available in the current event, so marking a channel as
+     * occupied, drawing a channel and starting a new event each take
+     * constant time, independent of the total number of channels.
+     */
+    class ChannelSampler {
+
+        public:
+
+            /**
+             * Constructor
+             *
+             * @param channelCount The total number of channels.
+             */
+            ChannelSampler(int channelCount = 0);
+
+            /**
+             * Set the total number of channels.  This makes all channels
+             * available again.
+             *
+             * @param channelCount The total number of channels.
+             */
+            void setChannelCount(int channelCount);
+
+            /** @return The total number of channels. */
+            int getChannelCount() const { return channels_.size(); }
+
+            /** @return The number of channels which can still be drawn in this event. */
+            int getEmptyCount() const { return channels_.size() - used_; }
+
+            /** Make all channels available again, e.g. for the next event. */
+            void reset() { used_ = 0; }
+
+            /**
+             * Exclude a channel, e.g. one with a real hit, from the channels
+             * drawn in this event.  Excluding a channel twice has no effect.
+             *
+             * @param channel The channel to exclude.
+             */
+            void markOccupied(int channel);
+
+            /**
+             * Draw one of the channels which were neither marked as occupied
+             * nor drawn before in this event, with equal probabilities.
+             *
+             * @param random The random number generator to use.
+             * @return The channel, or -1 if no channel is left.
+             */
+            int draw(TRandom& random);
+
+        private:
+
+            /** Move the channel at the given position to the end of the unavailable channels. */
+            void take(int position);
+
+            /** Permutation of the channels, unavailable channels first. */
+            std::vector<int> channels_;
+
+            /** Position of each channel in the permutation. */
+            std::vector<int> positions_;
+
+            /** Number of channels which are unavailable in this event. */
+            int used_{0};
+
+    }; // ChannelSampler
+
+} // ldmx
+
+#endif // TOOLS_CHANNELSAMPLER_H
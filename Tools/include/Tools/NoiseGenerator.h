@@ -11,7 +11,8 @@
 //   C++ StdLib   //
 //----------------//
 #include <iostream>
-#include <time.h>
+#include <memory>
+#include <utility>
 #include <vector>
 
 //--------------//
@@ -23,7 +24,13 @@
 //   ROOT   //
 //----------//
 #include "Math/DistFunc.h"
-#include "TRandom3.h"
+#include "TRandom.h"
+
+//----------//
+//   LDMX   //
+//----------//
+#include "Tools/ChannelSampler.h"
+#include "Tools/RandomStream.h"
 
 namespace ldmx { 
 
@@ -46,19 +53,81 @@ namespace ldmx {
              */
             std::vector<double> generateNoiseHits(int emptyChannels); 
 
+            /**
+             * Generate noise hits in distinct channels without a hit.
+             *
+             * @param sampler The channels of the detector, with the channels 
+             *                which have a hit marked as occupied.  The 
+             *                channels of the noise hits are marked as well.
+             * @return A vector containing the channel and amplitude of each
+             *         noise hit.
+             */
+            std::vector<std::pair<int, double> > generateNoiseHits(ChannelSampler& sampler); 
+
+            /**
+             * Generate noise hits in distinct channels without a hit.
+             *
+             * @param channelCount The total number of channels.
+             * @param occupiedChannels The channels which have a hit.
+             * @return A vector containing the channel and amplitude of each
+             *         noise hit.
+             */
+            std::vector<std::pair<int, double> > generateNoiseHits(int channelCount, 
+                    const std::vector<int>& occupiedChannels); 
+
+            /**
+             * Draw the noise hits from an external random number generator
+             * instead of the own one.
+             *
+             * @param random The random number generator, which must outlive
+             *               this noise generator.
+             */
+            void setRandom(TRandom& random) { random_ = &random; }
+
             /** Set the noise threshold. */
-            void setNoiseThreshold(double noiseThreshold) { noiseThreshold_ = noiseThreshold; }
+            void setNoiseThreshold(double noiseThreshold) { noiseThreshold_ = noiseThreshold; tablesValid_ = false; }
 
             /** Set the mean noise. */
-            void setNoise(double noise) { noise_ = noise; };
+            void setNoise(double noise) { noise_ = noise; tablesValid_ = false; };
 
             /** Set the pedestal. */
-            void setPedestal(double pedestal) { pedestal_ = pedestal; }; 
+            void setPedestal(double pedestal) { pedestal_ = pedestal; tablesValid_ = false; }; 
         
         private:
 
+            /** Compute the probability of a noise hit and the tables of noise amplitudes. */
+            void updateTables(); 
+
+            /** @return The amplitude of a noise hit above threshold. */
+            double drawAmplitude(); 
+
+            /** @return The exact amplitude at a cumulative probability. */
+            double quantile(double cumulativeProb) const; 
+
+            /** Number of intervals of the table of Gaussian noise amplitudes. */
+            static const int TABLE_SIZE{1024};
+
+            /** Probability for a channel to have a noise hit. */
+            double integral_{0};
+
+            /** 
+             * Gaussian noise amplitudes at equidistant fractions of the 
+             * probability above threshold, or the cumulative probabilities of 
+             * the Poisson noise values above threshold. 
+             */
+            std::vector<double> table_; 
+
+            /** True if the tables are up to date with the settings. */
+            bool tablesValid_{false}; 
+
+            /** Channel sampler for the channel count and occupancy version of generateNoiseHits. */
+            ChannelSampler sampler_;
+
+            /** Own random number generator, used unless another one is set. */
+            std::unique_ptr<TRandom> ownRandom_;
+
             /** Random number generator. */
-            std::unique_ptr<TRandom3> random_;
+            TRandom* random_{nullptr};
 
             /** The noise threshold. */
             double noiseThreshold_{4}; 
@@ -0,0 +1,99 @@
+/**
+ * @file RandomStream.h
+ * @brief Counter-based random number generator.
+ */
+
+#ifndef TOOLS_RANDOMSTREAM_H
+#define TOOLS_RANDOMSTREAM_H
+
+//----------------//
+//   C++ StdLib   //
+//----------------//
+#include <cstdint>
+
+//----------//
+//   ROOT   //
+//----------//
+#include "TRandom.h"
+
+namespace ldmx {
+
+    /**
+     * @class RandomStream
+     * @brief Random number generator whose n-th number is a function of a
+     *        key and of n only.
+     *
+     * @note
+     * Each number is computed by mixing the key with a counter, as in the
+     * SplitMix64 generator, so starting a stream for a new key takes constant
+     * time and the streams of different keys are independent.  The TRandom
+     * interface provides the usual distributions (Gaus, Poisson, Binomial,
+     * Integer, ...) on top of it.
+     */
+    class RandomStream : public TRandom {
+
+        public:
+
+            /**
+             * Constructor
+             *
+             * @param key The key of the stream.
+             */
+            RandomStream(uint64_t key = 0) { setKey(key); }
+
+            /** Destructor */
+            virtual ~RandomStream() {}
+
+            /**
+             * Start the stream of a key from its first number.
+             *
+             * @param key The key of the stream.
+             */
+            void setKey(uint64_t key) {
+                key_ = key;
+                counter_ = 0;
+            }
+
+            /** @return The key of the stream. */
+            uint64_t getKey() const { return key_; }
+
+            /** @return A uniform random number in the interval ]0, 1[. */
+            virtual Double_t Rndm();
+
+            /** @return A uniform random number in the interval ]0, 1[. */
+            virtual Double_t Rndm(Int_t) { return Rndm(); }
+
+            /** Fill an array with uniform random numbers in the interval ]0, 1[. */
+            virtual void RndmArray(Int_t n, Float_t* array);
+
+            /** Fill an array with uniform random numbers in the interval ]0, 1[. */
+            virtual void RndmArray(Int_t n, Double_t* array);
+
+            /**
+             * Scramble the bits of a 64-bit word.  This is the finalizer
+             * of SplitMix64, which maps each input to a distinct output.
+             */
+            static uint64_t mix(uint64_t value) {
+                value = (value ^ (value >> 30))*0xbf58476d1ce4e5b9ULL;
+                value = (value ^ (value >> 27))*0x94d049bb133111ebULL;
+                return value ^ (value >> 31);
+            }
+
+        private:
+
+            /** @return The next 64 random bits of the stream. */
+            uint64_t next() {
+                return mix(key_ + (++counter_)*0x9e3779b97f4a7c15ULL);
+            }
+
+            /** The key of the stream. */
+            uint64_t key_{0};
+
+            /** The number of words drawn from the stream. */
+            uint64_t counter_{0};
+
+    }; // RandomStream
+
+} // ldmx
+
+#endif // TOOLS_RANDOMSTREAM_H
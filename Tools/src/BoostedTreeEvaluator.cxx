@@ -0,0 +1,134 @@
+/**
+ * @file BoostedTreeEvaluator.cxx
+ * @brief Native evaluator for gradient boosted decision tree ensembles.
+ */
+
+#include "Tools/BoostedTreeEvaluator.h"
+
+//----------------//
+//   C++ StdLib   //
+//----------------//
+#include <cmath>
+#include <cstdio>
+#include <fstream>
+#include <stdexcept>
+
+namespace ldmx {
+
+    namespace {
+
+        /** A node of a single tree, as read from the dump. */
+        struct DumpNode {
+            int feature{-1};
+            float threshold{0};
+            int yes{-1};
+            int no{-1};
+            int missing{-1};
+            float value{0};
+            bool defined{false};
+        };
+    }
+
+    BoostedTreeEvaluator::BoostedTreeEvaluator(const std::string& modelFile, float baseScore, bool logistic) :
+        logistic_(logistic) {
+
+        if (logistic_) {
+            if (baseScore <= 0 || baseScore >= 1) {
+                throw std::runtime_error("Base score " + std::to_string(baseScore) + " is not a valid probability.");
+            }
+            baseMargin_ = std::log(baseScore/(1 - baseScore));
+        } else {
+            baseMargin_ = baseScore;
+        }
+
+        std::ifstream model(modelFile);
+        if (!model.good()) {
+            throw std::runtime_error("Unable to open BDT model file '" + modelFile + "'.");
+        }
+
+        std::vector<DumpNode> tree;
+
+        // Append the nodes of the tree read so far to the flat arrays,
+        // translating the local node ids into global indices.
+        auto flushTree = [&]() {
+            if (tree.empty()) return;
+            int offset = feature_.size();
+            for (const auto& node : tree) {
+                if (!node.defined) {
+                    throw std::runtime_error("Tree " + std::to_string(roots_.size()) + " in '" + modelFile + "' has a missing node.");
+                }
+                bool isLeaf = node.feature < 0;
+                if (!isLeaf && (node.yes >= int(tree.size()) || node.no >= int(tree.size()) || node.missing >= int(tree.size()))) {
+                    throw std::runtime_error("Tree " + std::to_string(roots_.size()) + " in '" + modelFile + "' refers to an undefined node.");
+                }
+                feature_.push_back(node.feature);
+                threshold_.push_back(node.threshold);
+                yes_.push_back(isLeaf ? -1 : offset + node.yes);
+                no_.push_back(isLeaf ? -1 : offset + node.no);
+                missing_.push_back(isLeaf ? -1 : offset + node.missing);
+                value_.push_back(node.value);
+                if (!isLeaf && unsigned(node.feature) >= nFeatures_) nFeatures_ = node.feature + 1;
+            }
+            roots_.push_back(offset);
+            tree.clear();
+        };
+
+        std::string line;
+        while (std::getline(model, line)) {
+
+            std::size_t start = line.find_first_not_of(" \t");
+            if (start == std::string::npos) continue;
+            const char* text = line.c_str() + start;
+
+            if (line.compare(start, 8, "booster[") == 0) {
+                flushTree();
+                continue;
+            }
+
+            int id{-1};
+            int consumed{0};
+            if (std::sscanf(text, "%d:%n", &id, &consumed) != 1 || id < 0) {
+                throw std::runtime_error("Unable to parse line '" + line + "' of '" + modelFile + "'.");
+            }
+            if (id >= int(tree.size())) tree.resize(id + 1);
+
+            DumpNode& node = tree[id];
+            const char* body = text + consumed;
+            if (std::sscanf(body, "leaf=%f", &node.value) == 1) {
+                node.feature = -1;
+            } else if (std::sscanf(body, "[f%d<%f] yes=%d,no=%d,missing=%d",
+                        &node.feature, &node.threshold, &node.yes, &node.no, &node.missing) != 5) {
+                throw std::runtime_error("Unable to parse line '" + line + "' of '" + modelFile + "'.");
+            }
+            node.defined = true;
+        }
+        flushTree();
+
+        if (roots_.empty()) {
+            throw std::runtime_error("No trees found in BDT model file '" + modelFile + "'.");
+        }
+    }
+
+    float BoostedTreeEvaluator::predict(const std::vector<float>& features) const {
+
+        if (features.size() < nFeatures_) {
+            throw std::runtime_error("BDT needs " + std::to_string(nFeatures_) + " features but only "
+                    + std::to_string(features.size()) + " were given.");
+        }
+
+        // xgboost accumulates the leaf values in single precision
+        float margin = baseMargin_;
+        for (int node : roots_) {
+            while (feature_[node] >= 0) {
+                float value = features[feature_[node]];
+                if (std::isnan(value)) node = missing_[node];
+                else node = (value < threshold_[node]) ? yes_[node] : no_[node];
+            }
+            margin += value_[node];
+        }
+
+        if (logistic_) return 1.0f/(1.0f + std::exp(-margin));
+        return margin;
+    }
+
+} // ldmx
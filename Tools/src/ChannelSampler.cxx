@@ -0,0 +1,53 @@
+/**
+ * @file ChannelSampler.cxx
+ * @brief Utility used to draw distinct empty channels for noise hits.
+ */
+
+#include "Tools/ChannelSampler.h"
+
+//----------------//
+//   C++ StdLib   //
+//----------------//
+#include <utility>
+
+//----------//
+//   ROOT   //
+//----------//
+#include "TRandom.h"
+
+namespace ldmx {
+
+    ChannelSampler::ChannelSampler(int channelCount) {
+        setChannelCount(channelCount);
+    }
+
+    void ChannelSampler::setChannelCount(int channelCount) {
+        channels_.resize(channelCount);
+        positions_.resize(channelCount);
+        for (int channel = 0; channel < channelCount; ++channel) {
+            channels_[channel] = channel;
+            positions_[channel] = channel;
+        }
+        used_ = 0;
+    }
+
+    void ChannelSampler::markOccupied(int channel) {
+        if (positions_[channel] >= used_) take(positions_[channel]);
+    }
+
+    int ChannelSampler::draw(TRandom& random) {
+        if (getEmptyCount() == 0) return -1;
+        int position = used_ + random.Integer(getEmptyCount());
+        int channel = channels_[position];
+        take(position);
+        return channel;
+    }
+
+    void ChannelSampler::take(int position) {
+        std::swap(channels_[position], channels_[used_]);
+        positions_[channels_[position]] = position;
+        positions_[channels_[used_]] = used_;
+        used_++;
+    }
+
+} // ldmx
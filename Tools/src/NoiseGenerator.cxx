@@ -6,10 +6,16 @@
 
 #include "Tools/NoiseGenerator.h"
 
+//----------------//
+//   C++ StdLib   //
+//----------------//
+#include <algorithm>
+
 namespace ldmx { 
 
     NoiseGenerator::NoiseGenerator(double noiseValue, bool gauss) {
-        random_ = std::make_unique<TRandom3>( time(nullptr) );
+        ownRandom_ = std::make_unique<RandomStream>();
+        random_ = ownRandom_.get();
 
         noise_ = noiseValue;
         useGaussianModel_ = gauss;
@@ -19,50 +25,104 @@ namespace ldmx {
     NoiseGenerator::~NoiseGenerator() { }
     
     std::vector<double> NoiseGenerator::generateNoiseHits(int emptyChannels) { 
-        
-        // std::cout << "[ Noise Generator ]: Empty channels: " 
-        //           << emptyChannels << std::endl;
-        // std::cout << "[ Noise Generator ]: Normalized integration limit: " 
-        //          << noiseThreshold_ << std::endl;
-        
-        double integral;
-        if( useGaussianModel_ ) 
-            integral = ROOT::Math::normal_cdf_c(noiseThreshold_, noise_, pedestal_);
-        else 
-            integral = boost::math::cdf(complement(*poisson_dist_,noiseThreshold_-1));
-        //std::cout << "[ Noise Generator ]: Integral: " 
-        //          << integral << std::endl;
-
-        double noiseHitCount = random_->Binomial(emptyChannels, integral); 
-        //std::cout << "[ Noise Generator ]: # Noise hits: " 
-        //          << noiseHitCount << std::endl;
+
+        if (!tablesValid_) updateTables(); 
+
+        double noiseHitCount = random_->Binomial(emptyChannels, integral_); 
 
         std::vector<double> noiseHits;
+        noiseHits.reserve(noiseHitCount); 
         for (int hitIndex = 0; hitIndex < noiseHitCount; ++hitIndex) { 
-            
-            double rand = random_->Uniform();
-            //std::cout << "[ Noise Generator ]: Rand: " 
-            //          << rand << std::endl;
-            double draw = integral*rand; 
-            //std::cout << "[ Noise Generator ]: Draw: " 
-            //          << draw << std::endl;
-            
-            double cumulativeProb = 1.0 - integral + draw;
-            //std::cout << "[ Noise Generator ]: Cumulative probability: " 
-            //          << cumulativeProb << std::endl;
-            
-            double valueAboveThreshold;
-            if( useGaussianModel_ )
-                valueAboveThreshold = ROOT::Math::gaussian_quantile(cumulativeProb, noise_);
-            else 
-                valueAboveThreshold = boost::math::quantile(*poisson_dist_,cumulativeProb);
-            //std::cout << "[ Noise Generator ]: Noise value: " 
-            //          << gaussAboveThreshold << std::endl;
-            
-            noiseHits.push_back(valueAboveThreshold); 
+            noiseHits.push_back(drawAmplitude()); 
         }
 
        return noiseHits;  
     }
 
+    std::vector<std::pair<int, double> > NoiseGenerator::generateNoiseHits(ChannelSampler& sampler) { 
+
+        if (!tablesValid_) updateTables(); 
+
+        int noiseHitCount = random_->Binomial(sampler.getEmptyCount(), integral_); 
+
+        std::vector<std::pair<int, double> > noiseHits;
+        noiseHits.reserve(noiseHitCount); 
+        for (int hitIndex = 0; hitIndex < noiseHitCount; ++hitIndex) { 
+            int channel = sampler.draw(*random_); 
+            noiseHits.emplace_back(channel, drawAmplitude()); 
+        }
+
+        return noiseHits; 
+    }
+
+    std::vector<std::pair<int, double> > NoiseGenerator::generateNoiseHits(int channelCount, 
+            const std::vector<int>& occupiedChannels) { 
+
+        if (sampler_.getChannelCount() != channelCount) sampler_.setChannelCount(channelCount); 
+        sampler_.reset(); 
+        for (int channel : occupiedChannels) sampler_.markOccupied(channel); 
+
+        return generateNoiseHits(sampler_); 
+    }
+
+    void NoiseGenerator::updateTables() { 
+
+        table_.clear(); 
+        if( useGaussianModel_ ) { 
+            integral_ = ROOT::Math::normal_cdf_c(noiseThreshold_, noise_, pedestal_);
+
+            // amplitudes at equidistant fractions of the probability above 
+            // threshold, the last interval is computed exactly as the 
+            // amplitude diverges at its end 
+            for (int i = 0; i < TABLE_SIZE; ++i) { 
+                table_.push_back(quantile(1.0 - integral_ + integral_*i/TABLE_SIZE)); 
+            } 
+        } else { 
+            poisson_dist_ = std::make_unique< boost::math::poisson_distribution<> >(noise_);
+            integral_ = boost::math::cdf(complement(*poisson_dist_,noiseThreshold_-1));
+
+            // cumulative probabilities of the noise values, up to the point 
+            // where the remaining probability is negligible 
+            double tail = 1.0; 
+            for (int value = 0; tail > 1e-15 && value < 1000 + 10*noise_; ++value) { 
+                table_.push_back(boost::math::cdf(*poisson_dist_, value)); 
+                tail = boost::math::cdf(complement(*poisson_dist_, value)); 
+            } 
+        }
+
+        tablesValid_ = true; 
+    }
+
+    double NoiseGenerator::drawAmplitude() { 
+
+        double rand = random_->Uniform();
+        double cumulativeProb = 1.0 - integral_ + integral_*rand;
+
+        if( useGaussianModel_ ) { 
+            double position = rand*TABLE_SIZE; 
+            int index = position; 
+            if (index >= TABLE_SIZE - 1) return quantile(cumulativeProb); 
+            return table_[index] + (position - index)*(table_[index + 1] - table_[index]); 
+        }
+
+        // beyond the table the remaining probability is negligible, and the 
+        // cumulative probability may have been rounded to one 
+        if (cumulativeProb > table_.back()) return table_.size(); 
+
+        // the quantile of a discrete distribution is rounded outwards: up 
+        // in the upper half and down in the lower half of the distribution
+        auto it = std::lower_bound(table_.begin(), table_.end(), cumulativeProb); 
+        if (cumulativeProb < 0.5 && *it != cumulativeProb) { 
+            if (it == table_.begin()) return 0; 
+            --it; 
+        } 
+        return it - table_.begin(); 
+    }
+
+    double NoiseGenerator::quantile(double cumulativeProb) const { 
+        if( useGaussianModel_ )
+            return ROOT::Math::gaussian_quantile(cumulativeProb, noise_);
+        return boost::math::quantile(*poisson_dist_,cumulativeProb);
+    }
+
 } // ldmx
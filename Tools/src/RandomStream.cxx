@@ -0,0 +1,27 @@
+/**
+ * @file RandomStream.cxx
+ * @brief Counter-based random number generator.
+ */
+
+#include "Tools/RandomStream.h"
+
+namespace ldmx {
+
+    Double_t RandomStream::Rndm() {
+        // the upper 53 bits, shifted to the middle of their interval so that
+        // neither 0 nor 1 is returned
+        return ((next() >> 11) + 0.5)*(1.0/9007199254740992.0);
+    }
+
+    void RandomStream::RndmArray(Int_t n, Float_t* array) {
+        for (Int_t i = 0; i < n; ++i) {
+            // the upper 24 bits, for the same reason
+            array[i] = ((next() >> 40) + 0.5f)*(1.0f/16777216.0f);
+        }
+    }
+
+    void RandomStream::RndmArray(Int_t n, Double_t* array) {
+        for (Int_t i = 0; i < n; ++i) array[i] = Rndm();
+    }
+
+} // ldmx
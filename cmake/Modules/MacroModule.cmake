@@ -23,6 +23,10 @@
 # - Test programs are in the 'test' directory and define an executable 'main' 
 #   function and also have the '.cxx' extension.
 #
+# - Benchmark programs are in the 'bench' directory, also with the '.cxx'
+#   extension.  They are only built by the 'benchmarks' target and are not
+#   installed.
+#
 # The names of the output executables and test programs will be derived from
 # the source file names using the file's base name stripped of its extension,
 # with underscores replaced by dashes.  All test programs and executables will
@@ -133,6 +137,20 @@ macro(MODULE)
     endif()
   endforeach()
   
+  # setup benchmark programs, which are only built by the benchmarks target
+  file(GLOB bench_sources ${CMAKE_CURRENT_SOURCE_DIR}/bench/*.cxx)
+  foreach(bench_source ${bench_sources})
+    get_filename_component(bench_program ${bench_source} NAME)
+    string(REPLACE ".cxx" "" bench_program ${bench_program})
+    string(REPLACE "_" "-" bench_program ${bench_program})
+    add_executable(${bench_program} EXCLUDE_FROM_ALL ${bench_source})
+    target_link_libraries(${bench_program} ${MODULE_BIN_LIBRARIES})
+    add_dependencies(benchmarks ${bench_program})
+    if(MODULE_DEBUG)
+      message("building benchmark program: ${bench_program}")
+    endif()
+  endforeach()
+
   # setup module executables
   foreach(executable_source ${MODULE_EXECUTABLES})
     get_filename_component(executable ${executable_source} NAME)
@@ -0,0 +1,24 @@
+#!/usr/bin/python
+
+# Convert a pickled xgboost model into the text dump read by the native
+# BDT evaluator (ldmx::BoostedTreeEvaluator).
+#
+#   bdt-dump-model.py model.pkl model.txt
+
+import sys
+import pickle as pkl
+
+if len(sys.argv) != 3:
+    print "Usage: %s {model.pkl} {model.txt}" % sys.argv[0]
+    sys.exit(1)
+
+model = pkl.load(open(sys.argv[1], 'r'))
+
+# models trained through the scikit-learn interface wrap the booster
+if hasattr(model, 'get_booster'):
+    model = model.get_booster()
+elif hasattr(model, 'booster') and callable(model.booster):
+    model = model.booster()
+
+model.dump_model(sys.argv[2])
+print "Wrote %s" % sys.argv[2]
@@ -0,0 +1,103 @@
+#!/usr/bin/python
+
+# Convert an ASCII field map into the binary format which is memory mapped
+# by ldmx::MagneticFieldMap3D (see MagneticFieldMap3D.h for the layout).
+#
+#   fieldmap-convert.py map.dat [map.dat.bin]
+#   fieldmap-convert.py --check map.dat.bin
+#
+# The output defaults to the input name with a ".bin" suffix, which is
+# picked up automatically when the detector refers to the ASCII map, as long
+# as the size and modification time of the ASCII map recorded in the header
+# still match it.
+#
+# Jobs do not verify the checksum of the field values, so that they only
+# touch the pages they use; --check verifies it once, e.g. after copying.
+
+import os
+import sys
+import struct
+import zlib
+from array import array
+
+VERSION = 2
+DATA_OFFSET = 4096
+HEADER_FORMAT = '<8sIIiiii3d3dIIQQq'
+
+if len(sys.argv) == 3 and sys.argv[1] == '--check':
+    binary = open(sys.argv[2], 'rb')
+    header = struct.unpack(HEADER_FORMAT, binary.read(struct.calcsize(HEADER_FORMAT)))
+    if header[0] != 'LDMXBMAP':
+        print "%s is not a binary field map" % sys.argv[2]
+        sys.exit(1)
+    nx, ny, nz = header[3:6]
+    checksum, dataOffset = header[13], header[15]
+    binary.seek(dataOffset)
+    data = binary.read(3*nx*ny*nz*header[2])
+    binary.close()
+    if zlib.crc32(data) & 0xffffffff != checksum:
+        print "Checksum mismatch in %s" % sys.argv[2]
+        sys.exit(1)
+    print "%s is okay" % sys.argv[2]
+    sys.exit(0)
+
+if len(sys.argv) not in (2, 3):
+    print "Usage: %s {map.dat} [map.dat.bin] | --check {map.dat.bin}" % sys.argv[0]
+    sys.exit(1)
+
+inputName = sys.argv[1]
+outputName = sys.argv[2] if len(sys.argv) == 3 else inputName + '.bin'
+
+source = os.stat(inputName)
+
+mapFile = open(inputName, 'r')
+
+# blank line, then the number of grid points along x, y and z
+mapFile.readline()
+nx, ny, nz = [int(v) for v in mapFile.readline().split()[:3]]
+
+# the header ends with the first line whose second character is '0'
+while True:
+    line = mapFile.readline()
+    if not line:
+        print "No end of header found in %s" % inputName
+        sys.exit(1)
+    if line[1:2] == '0':
+        break
+
+nPoints = nx*ny*nz
+field = array('d')
+first = None
+last = None
+tokens = []
+for line in mapFile:
+    tokens.extend(line.split())
+    while len(tokens) >= 6:
+        values = [float(v) for v in tokens[:6]]
+        del tokens[:6]
+        if first is None:
+            first = values[:3]
+        last = values[:3]
+        field.extend(values[3:])
+mapFile.close()
+
+if len(field) != 3*nPoints:
+    print "Expected %d grid points in %s but found %d" % (nPoints, inputName, len(field)/3)
+    sys.exit(1)
+
+if sys.byteorder != 'little':
+    field.byteswap()
+data = field.tostring()
+
+header = struct.pack(HEADER_FORMAT, 'LDMXBMAP', VERSION, 8, nx, ny, nz, 0,
+                     first[0], first[1], first[2], last[0], last[1], last[2],
+                     zlib.crc32(data) & 0xffffffff, 0, DATA_OFFSET,
+                     source.st_size, int(source.st_mtime))
+
+output = open(outputName, 'wb')
+output.write(header)
+output.write('\0'*(DATA_OFFSET - len(header)))
+output.write(data)
+output.close()
+
+print "Wrote %d x %d x %d grid points to %s" % (nx, ny, nz, outputName)